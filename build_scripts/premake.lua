@@ -36,13 +36,17 @@ API_INCLUDES = {
         "../third_party/vulkan",
         "../third_party/fidelityfx",
         "../third_party/xess"
+    },
+    null = {
+        "../third_party/spirv_cross"
     }
 }
 
 API_EXCLUDES = {
-    d3d12  = { RUNTIME_DIR .. "/RHI/Vulkan/**" },
-    vulkan_linux = { RUNTIME_DIR .. "/RHI/D3D12/**" },
-    vulkan_windows = { RUNTIME_DIR .. "/RHI/D3D12/**" },
+    d3d12  = { RUNTIME_DIR .. "/RHI/Vulkan/**", RUNTIME_DIR .. "/RHI/Null/**" },
+    vulkan_linux = { RUNTIME_DIR .. "/RHI/D3D12/**", RUNTIME_DIR .. "/RHI/Null/**" },
+    vulkan_windows = { RUNTIME_DIR .. "/RHI/D3D12/**", RUNTIME_DIR .. "/RHI/Null/**" },
+    null = { RUNTIME_DIR .. "/RHI/Vulkan/**", RUNTIME_DIR .. "/RHI/D3D12/**" },
 }
 
 API_LIBRARIES = {
@@ -107,6 +111,23 @@ API_LIBRARIES = {
             "spirv-cross-glsl_debug",
             "spirv-cross-hlsl_debug"
         }
+    },
+    null = {
+        -- spirv-cross is still needed, shaders are compiled and reflected so that pipelines get real descriptors
+        release = {
+            "spirv-cross-c",
+            "spirv-cross-core",
+            "spirv-cross-cpp",
+            "spirv-cross-glsl",
+            "spirv-cross-hlsl"
+        },
+        debug = {
+            "spirv-cross-c_debug",
+            "spirv-cross-core_debug",
+            "spirv-cross-cpp_debug",
+            "spirv-cross-glsl_debug",
+            "spirv-cross-hlsl_debug"
+        }
     }
 }
 
@@ -117,6 +138,9 @@ function configure_graphics_api()
     elseif ARG_API_GRAPHICS == "vulkan_windows" or ARG_API_GRAPHICS == "vulkan_linux" then
         API_CPP_DEFINE  = "API_GRAPHICS_VULKAN"
         EXECUTABLE_NAME = EXECUTABLE_NAME .. "_vulkan"
+    elseif ARG_API_GRAPHICS == "null" then
+        API_CPP_DEFINE  = "API_GRAPHICS_NULL"
+        EXECUTABLE_NAME = EXECUTABLE_NAME .. "_null"
     end
 end
 
@@ -145,7 +169,7 @@ function solution_configuration()
             filter { "platforms:Linux" }
                 system "linux"
                 architecture "x86_64"
-                buildoptions { "-mavx2" }
+                buildoptions { "-mavx2", "-mf16c" } -- every avx2 cpu has f16c, msvc enables it with /arch:AVX2
         end
 
         -- "Debug"
@@ -107,6 +107,14 @@ void Profiler::OnTickVisible()
             ImGui::EndCombo();
         }
 
+        ImGui::SameLine();
+        ImGui::BeginDisabled(spartan::Profiler::IsCapturingTrace());
+        if (ImGui::Button("Capture Trace"))
+        {
+            spartan::Profiler::CaptureTrace(120, "profiler_trace.json");
+        }
+        ImGui::EndDisabled();
+
         float interval = spartan::Profiler::GetUpdateInterval();
         ImGui::SetNextItemWidth(-1); // use all available horizontal space
         ImGui::SliderFloat("##update_interval", &interval, 0.0f, 0.5f, "Update Interval = %.2f");
@@ -603,7 +603,8 @@ void Properties::ShowPhysics(Physics* body) const
                 "Capsule",
                 "Mesh",
                 "Controller",
-                "Water"
+                "Water",
+                "Terrain"
             };
 
             ImGui::Text("Body Type");
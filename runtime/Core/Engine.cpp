@@ -23,16 +23,20 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "pch.h"
 #include "Window.h"
 #include "ThreadPool.h"
+#include "ProgressTracker.h"
+#include "../Game/Game.h"
 #include "../Input/Input.h"
 #include "../World/World.h"
 #include "../Physics/PhysicsWorld.h"
 #include "../Profiling/Profiler.h"
+#include "../Profiling/Benchmark.h"
 #include "../Rendering/Renderer.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/Import/FontImporter.h"
 #include "../Resource/Import/ModelImporter.h"
 #include "../Resource/Import/ImageImporter.h"
 #include "../Display/Display.h"
+#include "../RHI/RHI_Implementation.h"
 //===========================================
 
 //= NAMESPACES ===============
@@ -45,7 +49,8 @@ namespace spartan
     namespace
     {
         vector<string> arguments;
-        uint32_t flags = 0;
+        uint32_t flags          = 0;
+        bool benchmark_cases_ok = true;
 
         void write_ci_test_file(const uint32_t value)
         {
@@ -59,6 +64,152 @@ namespace spartan
                 }
             }
         }
+
+        // -benchmark [world] [frames]: loads a default world, lets it settle, then records the cpu time of each frame
+        namespace benchmark
+        {
+            const uint32_t frame_count_warmup = 120;
+            const array<pair<const char*, DefaultWorld>, 7> worlds =
+            {{
+                { "forest",        DefaultWorld::Forest       },
+                { "liminal_space", DefaultWorld::LiminalSpace },
+                { "gran_turismo",  DefaultWorld::GranTurismo  },
+                { "sponza",        DefaultWorld::Sponza       },
+                { "subway",        DefaultWorld::Subway       },
+                { "minecraft",     DefaultWorld::Minecraft    },
+                { "basic",         DefaultWorld::Basic        }
+            }};
+
+            bool enabled            = false;
+            bool world_requested    = false;
+            bool world_loading_seen = false;
+            DefaultWorld world      = DefaultWorld::Basic;
+            uint32_t frame_count    = 1000;
+            uint32_t frames_settled = 0;
+            uint32_t frames_waited  = 0;
+            vector<float> frame_times_ms;
+
+            void initialize()
+            {
+                auto it = find(arguments.begin(), arguments.end(), "-benchmark");
+                if (it == arguments.end())
+                    return;
+
+                enabled = true;
+
+                // optional world name
+                if (++it != arguments.end())
+                {
+                    for (const auto& [name, default_world] : worlds)
+                    {
+                        if (*it == name)
+                        {
+                            world = default_world;
+                            ++it;
+                            break;
+                        }
+                    }
+                }
+
+                // optional frame count
+                if (it != arguments.end() && !it->empty() && all_of(it->begin(), it->end(), ::isdigit))
+                {
+                    frame_count = max(1u, static_cast<uint32_t>(stoul(*it)));
+                }
+
+                frame_times_ms.reserve(frame_count);
+            }
+
+            void report()
+            {
+                vector<float> sorted = frame_times_ms;
+                sort(sorted.begin(), sorted.end());
+
+                auto percentile = [&sorted](const float p)
+                {
+                    size_t index = static_cast<size_t>(p * static_cast<float>(sorted.size() - 1) + 0.5f);
+                    return sorted[index];
+                };
+
+                float sum = 0.0f;
+                for (float time : sorted)
+                {
+                    sum += time;
+                }
+
+                const char* world_name = worlds[static_cast<uint32_t>(world)].first;
+                const float avg        = sum / static_cast<float>(sorted.size());
+
+                SP_LOG_INFO(
+                    "Benchmark (%s, %s, %u frames): avg %.3f ms, min %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms",
+                    world_name, RHI_Context::api_type_str.c_str(), static_cast<uint32_t>(sorted.size()),
+                    avg, sorted.front(), percentile(0.5f), percentile(0.95f), percentile(0.99f), sorted.back()
+                );
+
+                ofstream file("benchmark.txt");
+                if (file.is_open())
+                {
+                    file << "world: "  << world_name                << "\n";
+                    file << "api: "    << RHI_Context::api_type_str << "\n";
+                    file << "frames: " << sorted.size()             << "\n";
+                    file << "avg_ms: " << avg                       << "\n";
+                    file << "min_ms: " << sorted.front()            << "\n";
+                    file << "p50_ms: " << percentile(0.5f)          << "\n";
+                    file << "p95_ms: " << percentile(0.95f)         << "\n";
+                    file << "p99_ms: " << percentile(0.99f)         << "\n";
+                    file << "max_ms: " << sorted.back()             << "\n";
+                    file.close();
+                }
+            }
+
+            void tick(const float frame_time_ms)
+            {
+                if (!enabled)
+                    return;
+
+                // load the world on the first tick, when every system is up
+                if (!world_requested)
+                {
+                    world_requested = true;
+                    Timer::SetFpsLimit(10000.0f); // effectively unlimited, so the limiter doesn't sleep between frames
+                    Game::Load(world);
+                    return;
+                }
+
+                // loading happens on a worker thread, so wait for it to be seen starting and finishing
+                // (worlds that load faster than a frame can be missed, hence the frame based fallback)
+                if (ProgressTracker::IsLoading())
+                {
+                    world_loading_seen = true;
+                    frames_settled     = 0;
+                    frame_times_ms.clear();
+                    return;
+                }
+
+                if (!world_loading_seen && ++frames_waited < frame_count_warmup)
+                    return;
+
+                // play the world and let streaming, caches and physics settle before recording
+                if (frames_settled == 0)
+                {
+                    Engine::SetFlag(EngineMode::Playing, true);
+                }
+
+                if (frames_settled < frame_count_warmup)
+                {
+                    frames_settled++;
+                    return;
+                }
+
+                frame_times_ms.emplace_back(frame_time_ms);
+                if (frame_times_ms.size() == frame_count)
+                {
+                    report();
+                    enabled = false;
+                    Window::Close();
+                }
+            }
+        }
     }
 
     void Engine::Initialize(const vector<string>& args)
@@ -87,12 +238,24 @@ namespace spartan
             Settings::Initialize();
         }
 
+        benchmark::initialize();
+
         SP_LOG_INFO("Initialization took %.1f sec", timer_initialize.GetElapsedTimeSec());
-        SP_SUBSCRIBE_TO_EVENT(EventType::RendererOnFirstFrameCompleted, SP_EVENT_HANDLER_EXPRESSION_STATIC(write_ci_test_file(0);));
+
+        // micro benchmarks and equivalence checks of individual systems, a failed check fails the ci test
+        if (HasArgument("-benchmark") || HasArgument("-ci_test"))
+        {
+            benchmark_cases_ok = Benchmark::Run();
+        }
+
+        SP_SUBSCRIBE_TO_EVENT(EventType::RendererOnFirstFrameCompleted, SP_EVENT_HANDLER_EXPRESSION_STATIC(write_ci_test_file(benchmark_cases_ok ? 0 : 1);));
     }
 
     void Engine::Shutdown()
     {
+        // a step that's still running needs the workers, the pool drops queued jobs when it shuts down
+        PhysicsWorld::WaitForSimulation();
+
         // the thread pool can hold state from other systems
         // so shut it down first (it waits) to avoid crashes due to race conditions
         ThreadPool::Shutdown();
@@ -106,10 +269,13 @@ namespace spartan
         ImageImporter::Shutdown();
         FontImporter::Shutdown();
         Settings::Shutdown();
+        Log::Shutdown();
     }
 
     void Engine::Tick()
     {
+        Stopwatch timer_frame;
+
         // pre-tick
         Input::PreTick();
 
@@ -118,8 +284,13 @@ namespace spartan
         Input::Tick();
         PhysicsWorld::Tick();
         World::Tick();
+        Event::Tick(); // dispatch deferred events, so the renderer sees this tick's changes
+        PhysicsWorld::Simulate(); // the next step runs on the workers while the renderer records the frame
         Renderer::Tick();
 
+        // measured before the fps limiter, so only the work of the frame is recorded
+        benchmark::tick(timer_frame.GetElapsedTimeMs());
+
         // post-tick
         Timer::PostTick();
         Profiler::PostTick();
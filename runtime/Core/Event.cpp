@@ -32,27 +32,230 @@ namespace spartan
 {
     namespace
     {
-        static array<vector<subscriber>, static_cast<uint32_t>(EventType::Max)> event_subscribers;
+        struct Subscription
+        {
+            uint32_t id = 0;
+            subscriber function;
+        };
+
+        array<vector<Subscription>, static_cast<uint32_t>(EventType::Max)> event_subscribers;
+        uint32_t subscription_id = 0;
+
+        // unsubscribing from within a handler only clears the function, the entry is erased once dispatching is done
+        atomic<uint32_t> dispatch_depth = 0;
+        bool has_cleared_subscriptions  = false;
+
+        void erase_cleared_subscriptions()
+        {
+            for (vector<Subscription>& subscribers : event_subscribers)
+            {
+                erase_if(subscribers, [](const Subscription& subscription) { return !subscription.function; });
+            }
+            has_cleared_subscriptions = false;
+        }
+
+        namespace deferred
+        {
+            // events fired during a tick go into one arena, while the other one is dispatched
+            // the payload is moved in once and handed to the handlers by reference
+            struct Arena
+            {
+                static constexpr uint32_t capacity = 4096;
+
+                array<pair<EventType, sp_variant>, capacity> events;
+                atomic<uint32_t> count   = 0;
+                atomic<uint32_t> writers = 0; // threads which are in the middle of adding an event
+            };
+
+            array<Arena, 2> arenas;
+            atomic<uint32_t> arena_index = 0;
+
+            // only used if an arena runs out of space
+            mutex mutex_overflow;
+            vector<pair<EventType, sp_variant>> overflow;
+
+            // identical events (same type and same int or pointer payload) are dispatched once per tick
+            struct Key
+            {
+                EventType type;
+                uintptr_t value;
+                bool operator==(const Key& other) const { return type == other.type && value == other.value; }
+            };
+
+            struct KeyHash
+            {
+                size_t operator()(const Key& key) const { return hash<uintptr_t>()(key.value) ^ (static_cast<size_t>(key.type) * 0x9E3779B97F4A7C15ull); }
+            };
+
+            unordered_set<Key, KeyHash> dispatched;
+
+            void dispatch(const EventType type, const sp_variant& data)
+            {
+                uintptr_t value = 0;
+                if (const int* data_int = get_if<int>(&data))
+                {
+                    value = static_cast<uintptr_t>(*data_int);
+                }
+                else if (void* const* data_pointer = get_if<void*>(&data))
+                {
+                    value = reinterpret_cast<uintptr_t>(*data_pointer);
+                }
+                else
+                {
+                    Event::Fire(type, data); // entity lists are never coalesced
+                    return;
+                }
+
+                if (dispatched.insert({ type, value }).second)
+                {
+                    Event::Fire(type, data);
+                }
+            }
+        }
+    }
+
+    void Event::Tick()
+    {
+        using namespace deferred;
+
+        // switch arenas and wait for any thread which is still adding to the previous one
+        const uint32_t index = arena_index.load();
+        arena_index.store(index ^ 1);
+        Arena& arena = arenas[index];
+        while (arena.writers.load() != 0)
+        {
+            this_thread::yield();
+        }
+
+        vector<pair<EventType, sp_variant>> events_overflow;
+        {
+            lock_guard<mutex> lock(mutex_overflow);
+            events_overflow.swap(overflow);
+        }
+
+        const uint32_t count = min(arena.count.load(), Arena::capacity);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            dispatch(arena.events[i].first, arena.events[i].second);
+            arena.events[i].second = 0;
+        }
+        arena.count.store(0);
+
+        for (const pair<EventType, sp_variant>& event : events_overflow)
+        {
+            dispatch(event.first, event.second);
+        }
+
+        dispatched.clear();
     }
 
     void Event::Shutdown()
     {
-        for (vector<subscriber>& subscribers : event_subscribers)
+        for (vector<Subscription>& subscribers : event_subscribers)
         {
             subscribers.clear();
         }
+
+        for (deferred::Arena& arena : deferred::arenas)
+        {
+            for (uint32_t i = 0; i < min(arena.count.load(), deferred::Arena::capacity); i++)
+            {
+                arena.events[i].second = 0;
+            }
+            arena.count = 0;
+        }
+
+        lock_guard<mutex> lock(deferred::mutex_overflow);
+        deferred::overflow.clear();
+    }
+
+    EventHandle Event::Subscribe(const EventType event_type, subscriber&& function)
+    {
+        EventHandle handle;
+        handle.type = event_type;
+        handle.id   = ++subscription_id;
+
+        event_subscribers[static_cast<uint32_t>(event_type)].push_back({ handle.id, std::forward<subscriber>(function) });
+
+        return handle;
+    }
+
+    void Event::Unsubscribe(EventHandle& handle)
+    {
+        if (handle.type == EventType::Max)
+            return;
+
+        vector<Subscription>& subscribers = event_subscribers[static_cast<uint32_t>(handle.type)];
+        for (Subscription& subscription : subscribers)
+        {
+            if (subscription.id == handle.id)
+            {
+                subscription.function     = nullptr;
+                has_cleared_subscriptions = true;
+                break;
+            }
+        }
+
+        if (dispatch_depth.load() == 0)
+        {
+            erase_cleared_subscriptions();
+        }
+
+        handle = EventHandle();
     }
 
-    void Event::Subscribe(const EventType event_type, subscriber&& function)
+    void Event::Fire(const EventType event_type, const sp_variant& data /*= 0*/)
     {
-        event_subscribers[static_cast<uint32_t>(event_type)].push_back(std::forward<subscriber>(function));
+        dispatch_depth++;
+
+        // indexed, so that handlers can subscribe without invalidating the loop
+        // and each handler is called through a copy, since subscribing can reallocate the vector and
+        // unsubscribing clears the function, either of which would destroy it while it's running
+        vector<Subscription>& subscribers = event_subscribers[static_cast<uint32_t>(event_type)];
+        for (size_t i = 0; i < subscribers.size(); i++)
+        {
+            if (subscribers[i].function)
+            {
+                const subscriber function = subscribers[i].function;
+                function(data);
+            }
+        }
+
+        if (--dispatch_depth == 0 && has_cleared_subscriptions)
+        {
+            erase_cleared_subscriptions();
+        }
     }
 
-    void Event::Fire(const EventType event_type, sp_variant data /*= 0*/)
+    void Event::FireDeferred(const EventType event_type, sp_variant data /*= 0*/)
     {
-        for (const auto& subscriber : event_subscribers[static_cast<uint32_t>(event_type)])
+        using namespace deferred;
+
+        while (true)
         {
-            subscriber(data);
+            // register as a writer of the current arena, if the arenas were switched meanwhile, try again
+            const uint32_t index = arena_index.load();
+            Arena& arena         = arenas[index];
+            arena.writers++;
+            if (arena_index.load() != index)
+            {
+                arena.writers--;
+                continue;
+            }
+
+            const uint32_t slot = arena.count.fetch_add(1);
+            if (slot < Arena::capacity)
+            {
+                arena.events[slot] = { event_type, move(data) };
+            }
+            else
+            {
+                lock_guard<mutex> lock(mutex_overflow);
+                overflow.emplace_back(event_type, move(data));
+            }
+
+            arena.writers--;
+            return;
         }
     }
 }
@@ -29,15 +29,20 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 /*
 HOW TO USE
 ================================================================================
-To subscribe a function to an event -> SP_SUBSCRIBE_TO_EVENT(EVENT_ID, Handler);
-To fire an event                    -> SP_FIRE_EVENT(EVENT_ID);
-To fire an event with data          -> SP_FIRE_EVENT_DATA(EVENT_ID, Variant);
+To subscribe a function to an event   -> SP_SUBSCRIBE_TO_EVENT(EVENT_ID, Handler);
+To unsubscribe                        -> Event::Unsubscribe(handle returned by Subscribe);
+To fire an event                      -> SP_FIRE_EVENT(EVENT_ID);
+To fire an event with data            -> SP_FIRE_EVENT_DATA(EVENT_ID, Variant);
+To fire an event at the end of a tick -> SP_FIRE_EVENT_DEFERRED(EVENT_ID);
+To do the same with data              -> SP_FIRE_EVENT_DATA_DEFERRED(EVENT_ID, Variant);
 
-Note: This is a blocking event system
+Note: Firing is blocking, handlers run on the firing thread before it returns
+Note: Deferred events can be fired from any thread, they are queued without locks and
+      dispatched on the main thread by Event::Tick(), identical ones are coalesced
 ================================================================================
 */
 
-//= MACROS ===============================================================================================
+//= MACROS ===================================================================================================
 #define SP_EVENT_HANDLER_EXPRESSION(expression)        [this](spartan::sp_variant var)  { expression }
 #define SP_EVENT_HANDLER_EXPRESSION_STATIC(expression) [](spartan::sp_variant var)      { expression }
 
@@ -49,9 +54,11 @@ Note: This is a blocking event system
                                                        
 #define SP_FIRE_EVENT(event_enum)                      spartan::Event::Fire(event_enum)
 #define SP_FIRE_EVENT_DATA(event_enum, data)           spartan::Event::Fire(event_enum, data)
+#define SP_FIRE_EVENT_DEFERRED(event_enum)             spartan::Event::FireDeferred(event_enum)
+#define SP_FIRE_EVENT_DATA_DEFERRED(event_enum, data)  spartan::Event::FireDeferred(event_enum, data)
                                                        
 #define SP_SUBSCRIBE_TO_EVENT(event_enum, function)    spartan::Event::Subscribe(event_enum, function);
-//========================================================================================================
+//============================================================================================================
 
 namespace spartan
 {
@@ -69,7 +76,8 @@ namespace spartan
         WindowResized,                 // The window has been resized
         WindowFullScreenToggled,       // The window has been toggled to full screen
         // Resources
-        MaterialOnChanged,
+        MaterialOnChanged,             // A material has changed, data is the material (void*)
+        MaterialOnDestroyed,           // A material is about to be destroyed, data is the material (void*)
         LightOnChanged,
         // Max
         Max
@@ -84,11 +92,20 @@ namespace spartan
     >;
     using subscriber = std::function<void(const sp_variant&)>;
 
+    struct EventHandle
+    {
+        EventType type = EventType::Max;
+        uint32_t id    = 0;
+    };
+
     class Event
     {
     public:
+        static void Tick();
         static void Shutdown();
-        static void Subscribe(const EventType event_type, subscriber&& function);
-        static void Fire(const EventType event_type, sp_variant data = 0);
+        static EventHandle Subscribe(const EventType event_type, subscriber&& function);
+        static void Unsubscribe(EventHandle& handle);
+        static void Fire(const EventType event_type, const sp_variant& data = 0);
+        static void FireDeferred(const EventType event_type, sp_variant data = 0);
     };
 }
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Rendering/Renderer.h"
 #include "../Resource/ResourceCache.h"
 #include "../Input/Input.h"
+#include "../RHI/RHI_Texture.h"
 SP_WARNINGS_OFF
 #include "../IO/pugixml.hpp"
 SP_WARNINGS_ON
@@ -110,6 +111,8 @@ namespace spartan
                 }
 
                 root.append_child("UseRootShaderDirectory").text().set(ResourceCache::GetUseRootShaderDirectory());
+                root.append_child("TextureCompressionQuality").text().set(static_cast<uint32_t>(RHI_Texture::GetCompressionQuality()));
+                root.append_child("TextureMipsHighQuality").text().set(RHI_Texture::GetMipsHighQuality());
             }
 
             doc.save_file(file_path.c_str());
@@ -150,6 +153,14 @@ namespace spartan
 
                 // this setting can be mapped directly to the resource cache (no need to wait for it to initialize)
                 ResourceCache::SetUseRootShaderDirectory(root.child("UseRootShaderDirectory").text().as_bool());
+
+                // textures compressed from now on, and the keys of cooked textures, use this
+                uint32_t compression_quality = root.child("TextureCompressionQuality").text().as_uint(static_cast<uint32_t>(RHI_Texture_Compression_Quality::Balanced));
+                compression_quality          = min(compression_quality, static_cast<uint32_t>(RHI_Texture_Compression_Quality::Max) - 1);
+                RHI_Texture::SetCompressionQuality(static_cast<RHI_Texture_Compression_Quality>(compression_quality));
+
+                // material textures imported from now on use kaiser filtered mips, this is part of their cooked keys too
+                RHI_Texture::SetMipsHighQuality(root.child("TextureMipsHighQuality").text().as_bool(false));
             }
 
             m_has_loaded_user_settings = true;
@@ -19,10 +19,11 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES =========
+//= INCLUDES ===================
 #include "pch.h"
 #include "ThreadPool.h"
-//====================
+#include "../Profiling/Profiler.h"
+//==============================
 
 //= NAMESPACES =====
 using namespace std;
@@ -30,53 +31,374 @@ using namespace std;
 
 namespace spartan
 {
+    struct Job
+    {
+        Task task;
+        atomic<uint32_t> dependencies_remaining = 1; // starts at 1 so the job can't be scheduled while dependencies are still being added
+        atomic<bool> complete                   = false;
+        atomic_flag continuations_lock          = ATOMIC_FLAG_INIT;
+        vector<Job*> continuations;                  // jobs which depend on this one
+        JobHandle self;                              // keeps the job alive while it's pending
+    };
+
     namespace
     {
-        // Stats
+        // a chase-lev work stealing deque, the owning worker pushes and pops at the bottom, other threads steal from the top
+        class WorkStealingDeque
+        {
+        public:
+            bool Push(Job* job)
+            {
+                int64_t bottom = m_bottom.load(memory_order_relaxed);
+                int64_t top    = m_top.load(memory_order_acquire);
+                if (bottom - top >= static_cast<int64_t>(capacity))
+                    return false;
+
+                m_jobs[bottom & mask].store(job, memory_order_relaxed);
+                atomic_thread_fence(memory_order_release);
+                m_bottom.store(bottom + 1, memory_order_relaxed);
+
+                return true;
+            }
+
+            Job* Pop()
+            {
+                int64_t bottom = m_bottom.load(memory_order_relaxed) - 1;
+                m_bottom.store(bottom, memory_order_relaxed);
+                atomic_thread_fence(memory_order_seq_cst);
+                int64_t top = m_top.load(memory_order_relaxed);
+
+                if (top > bottom)
+                {
+                    m_bottom.store(bottom + 1, memory_order_relaxed);
+                    return nullptr;
+                }
+
+                Job* job = m_jobs[bottom & mask].load(memory_order_relaxed);
+                if (top == bottom) // last job, race against thieves
+                {
+                    if (!m_top.compare_exchange_strong(top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+                    {
+                        job = nullptr;
+                    }
+                    m_bottom.store(bottom + 1, memory_order_relaxed);
+                }
+
+                return job;
+            }
+
+            Job* Steal()
+            {
+                int64_t top = m_top.load(memory_order_acquire);
+                atomic_thread_fence(memory_order_seq_cst);
+                int64_t bottom = m_bottom.load(memory_order_acquire);
+                if (top >= bottom)
+                    return nullptr;
+
+                Job* job = m_jobs[top & mask].load(memory_order_relaxed);
+                if (!m_top.compare_exchange_strong(top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+                    return nullptr;
+
+                return job;
+            }
+
+        private:
+            static constexpr uint32_t capacity = 1024;
+            static constexpr uint32_t mask     = capacity - 1;
+
+            alignas(64) atomic<int64_t> m_top    = 0;
+            alignas(64) atomic<int64_t> m_bottom = 0;
+            array<atomic<Job*>, capacity> m_jobs = {};
+        };
+
+        // a bounded multi-producer multi-consumer queue (vyukov), used by threads which are not workers
+        class InjectionQueue
+        {
+        public:
+            InjectionQueue()
+            {
+                for (uint32_t i = 0; i < capacity; i++)
+                {
+                    m_cells[i].sequence.store(i, memory_order_relaxed);
+                }
+            }
+
+            bool Push(Job* job)
+            {
+                uint64_t position = m_enqueue_position.load(memory_order_relaxed);
+                while (true)
+                {
+                    Cell& cell        = m_cells[position & mask];
+                    uint64_t sequence = cell.sequence.load(memory_order_acquire);
+                    int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+
+                    if (difference == 0)
+                    {
+                        if (m_enqueue_position.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+                        {
+                            cell.job = job;
+                            cell.sequence.store(position + 1, memory_order_release);
+                            return true;
+                        }
+                    }
+                    else if (difference < 0) // full
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        position = m_enqueue_position.load(memory_order_relaxed);
+                    }
+                }
+            }
+
+            Job* Pop()
+            {
+                uint64_t position = m_dequeue_position.load(memory_order_relaxed);
+                while (true)
+                {
+                    Cell& cell         = m_cells[position & mask];
+                    uint64_t sequence  = cell.sequence.load(memory_order_acquire);
+                    int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position + 1);
+
+                    if (difference == 0)
+                    {
+                        if (m_dequeue_position.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+                        {
+                            Job* job = cell.job;
+                            cell.sequence.store(position + capacity, memory_order_release);
+                            return job;
+                        }
+                    }
+                    else if (difference < 0) // empty
+                    {
+                        return nullptr;
+                    }
+                    else
+                    {
+                        position = m_dequeue_position.load(memory_order_relaxed);
+                    }
+                }
+            }
+
+        private:
+            struct Cell
+            {
+                atomic<uint64_t> sequence = 0;
+                Job* job                  = nullptr;
+            };
+
+            static constexpr uint32_t capacity = 4096;
+            static constexpr uint32_t mask     = capacity - 1;
+
+            alignas(64) atomic<uint64_t> m_enqueue_position = 0;
+            alignas(64) atomic<uint64_t> m_dequeue_position = 0;
+            array<Cell, capacity> m_cells;
+        };
+
+        // stats
         static uint32_t thread_count                 = 0;
         static atomic<uint32_t> working_thread_count = 0;
 
-        // Sync objects
-        static mutex mutex_tasks;
+        // threads
+        static vector<thread> threads;
+        static vector<unique_ptr<WorkStealingDeque>> deques;
+        static thread_local uint32_t worker_index = numeric_limits<uint32_t>::max();
+
+        // jobs
+        static InjectionQueue injection_queue;
+        static atomic<uint32_t> jobs_queued    = 0; // jobs which are ready and sitting in a queue
+        static atomic<uint32_t> jobs_in_flight = 0; // jobs which have been added but haven't completed yet
+
+        // sleeping
+        static mutex mutex_sleep;
         static condition_variable condition_var;
+        static atomic<uint32_t> sleeping_thread_count = 0;
 
-        // Threads
-        static vector<thread> threads;
+        // misc
+        static atomic<bool> is_stopping = false;
+        static atomic<bool> is_flushing = false;
 
-        // Tasks
-        static deque<Task> tasks;
+        bool is_worker_thread()
+        {
+            return worker_index < thread_count;
+        }
 
-        // Misc
-        static bool is_stopping;
-    }
+        void wake_up_threads(const uint32_t count)
+        {
+            if (sleeping_thread_count.load() == 0)
+                return;
 
-    static void thread_loop()
-    {
-        while (true)
+            lock_guard<mutex> lock(mutex_sleep);
+            if (count == 1)
+            {
+                condition_var.notify_one();
+            }
+            else
+            {
+                condition_var.notify_all();
+            }
+        }
+
+        void execute(Job* job);
+
+        void enqueue(Job* job)
         {
-            // Lock tasks mutex
-            unique_lock<mutex> lock(mutex_tasks);
+            jobs_queued++;
+
+            if (is_worker_thread())
+            {
+                // workers keep their jobs local (good for cache), idle workers will steal them
+                // when the deque is full the job goes to the shared queue, and when that is full too it runs right here,
+                // waiting for space could wait forever since this worker (or every worker) might be the one that has to make it
+                if (!deques[worker_index]->Push(job) && !injection_queue.Push(job))
+                {
+                    jobs_queued--;
+                    execute(job);
+                    return;
+                }
+            }
+            else
+            {
+                while (!injection_queue.Push(job))
+                {
+                    this_thread::yield();
+                }
+            }
 
-            // Check condition on notification
-            condition_var.wait(lock, [] { return !tasks.empty() || is_stopping; });
+            wake_up_threads(1);
+        }
 
-            // If m_stopping is true, it's time to shut everything down
-            if (is_stopping && tasks.empty())
-                return;
+        Job* dequeue()
+        {
+            Job* job = nullptr;
 
-            // Get next task in the queue.
-            Task task = tasks.front();
+            // own deque first
+            if (is_worker_thread())
+            {
+                job = deques[worker_index]->Pop();
+            }
 
-            // Remove it from the queue.
-            tasks.pop_front();
+            // then the shared queue
+            if (!job)
+            {
+                job = injection_queue.Pop();
+            }
 
-            // Unlock the mutex
-            lock.unlock();
+            // then steal from other workers, starting from a neighbour so thieves don't all hit the same deque
+            if (!job && thread_count > 0)
+            {
+                uint32_t start = is_worker_thread() ? worker_index + 1 : 0;
+                for (uint32_t i = 0; i < thread_count && !job; i++)
+                {
+                    uint32_t victim = (start + i) % thread_count;
+                    if (victim != worker_index)
+                    {
+                        job = deques[victim]->Steal();
+                    }
+                }
+            }
+
+            if (job)
+            {
+                jobs_queued--;
+            }
 
-            // Execute the task.
-            working_thread_count++;
-            task();
-            working_thread_count--;
+            return job;
+        }
+
+        void execute(Job* job)
+        {
+            // keep the job alive until we are done with it
+            JobHandle handle = move(job->self);
+
+            if (!is_flushing)
+            {
+                working_thread_count++;
+                {
+                    ScopedTimeBlock time_block("job");
+                    job->task();
+                }
+                working_thread_count--;
+            }
+            job->task = nullptr;
+
+            // mark complete and collect any jobs which were waiting on this one
+            vector<Job*> continuations;
+            while (job->continuations_lock.test_and_set(memory_order_acquire)) {}
+            job->complete.store(true, memory_order_release);
+            continuations.swap(job->continuations);
+            job->continuations_lock.clear(memory_order_release);
+            job->complete.notify_all();
+
+            for (Job* continuation : continuations)
+            {
+                if (continuation->dependencies_remaining.fetch_sub(1) == 1)
+                {
+                    enqueue(continuation);
+                }
+            }
+
+            jobs_in_flight--;
+        }
+
+        void thread_loop(const uint32_t index)
+        {
+            worker_index = index;
+            Profiler::SetThreadName(("worker_" + to_string(index)).c_str());
+
+            while (!is_stopping)
+            {
+                if (Job* job = dequeue())
+                {
+                    execute(job);
+                    continue;
+                }
+
+                // nothing to do, spin for a bit since work tends to come in bursts
+                bool found_work = false;
+                for (uint32_t i = 0; i < 64 && !found_work; i++)
+                {
+                    this_thread::yield();
+                    found_work = jobs_queued.load() > 0;
+                }
+
+                if (!found_work)
+                {
+                    unique_lock<mutex> lock(mutex_sleep);
+                    sleeping_thread_count++;
+                    condition_var.wait(lock, [] { return jobs_queued.load() > 0 || is_stopping; });
+                    sleeping_thread_count--;
+                }
+            }
+        }
+
+        struct ParallelLoopState
+        {
+            std::function<void(uint32_t work_index_start, uint32_t work_index_end)> loop_function;
+            uint32_t work_total         = 0;
+            uint32_t work_per_chunk     = 0;
+            atomic<uint64_t> work_index = 0; // next unclaimed index
+            atomic<uint32_t> work_done  = 0;
+        };
+
+        void parallel_loop_execute(ParallelLoopState& state)
+        {
+            while (true)
+            {
+                uint64_t start = state.work_index.fetch_add(state.work_per_chunk);
+                if (start >= state.work_total)
+                    break;
+
+                uint32_t end = static_cast<uint32_t>(min<uint64_t>(start + state.work_per_chunk, state.work_total));
+                state.loop_function(static_cast<uint32_t>(start), end);
+
+                uint32_t work_count = end - static_cast<uint32_t>(start);
+                if (state.work_done.fetch_add(work_count) + work_count == state.work_total)
+                {
+                    state.work_done.notify_all();
+                }
+            }
         }
     }
 
@@ -84,12 +406,18 @@ namespace spartan
     {
         is_stopping = false;
 
-        uint32_t core_count = thread::hardware_concurrency() / 2;  // assume physical cores
-        thread_count        = min(core_count * 2, core_count + 4); // 2x for I/O-bound, cap at core_count + 4
+        uint32_t core_count = thread::hardware_concurrency() / 2;               // assume physical cores
+        thread_count        = max(min(core_count * 2, core_count + 4), 1u);     // 2x for I/O-bound, cap at core_count + 4
 
+        // the deques have to exist before any of the workers start stealing
         for (uint32_t i = 0; i < thread_count; i++)
         {
-            threads.emplace_back(thread(&thread_loop));
+            deques.emplace_back(make_unique<WorkStealingDeque>());
+        }
+
+        for (uint32_t i = 0; i < thread_count; i++)
+        {
+            threads.emplace_back(thread(&thread_loop, i));
         }
 
         SP_LOG_INFO("%d threads have been created", thread_count);
@@ -99,112 +427,160 @@ namespace spartan
     {
         Flush(true);
 
-        // Put unique lock on task mutex.
-        unique_lock<mutex> lock(mutex_tasks);
-
-        // Set termination flag to true.
-        is_stopping = true;
-
-        // Unlock the mutex
-        lock.unlock();
+        // set termination flag to true
+        {
+            lock_guard<mutex> lock(mutex_sleep);
+            is_stopping = true;
+        }
 
-        // Wake up all threads.
+        // wake up all threads
         condition_var.notify_all();
 
-        // Join all threads.
+        // join all threads
         for (auto& thread : threads)
         {
             thread.join();
         }
 
-        // Empty worker threads.
         threads.clear();
+        deques.clear();
     }
 
     future<void> ThreadPool::AddTask(Task&& task)
     {
         // create a packaged task that will give us a future
         auto packaged_task = make_shared<std::packaged_task<void()>>(std::forward<Task>(task));
-        
+
         // get the future before we move the packaged_task into the lambda
         future<void> future = packaged_task->get_future();
-        
-        // lock tasks mutex
-        unique_lock<mutex> lock(mutex_tasks);
-        
-        // save the task - wrap the packaged_task in a lambda that will execute it
-        tasks.emplace_back([packaged_task]()
+
+        // schedule the task - wrap the packaged_task in a lambda that will execute it
+        AddJob([packaged_task]()
         {
             (*packaged_task)();
         });
-        
-        // unlock the mutex
-        lock.unlock();
-        
-        // wake up a thread
-        condition_var.notify_one();
-        
+
         // return the future that can be used to wait for task completion
         return future;
     }
 
-    void ThreadPool::ParallelLoop(function<void(uint32_t work_index_start, uint32_t work_index_end)>&& function, const uint32_t work_total)
+    JobHandle ThreadPool::AddJob(Task&& task, const vector<JobHandle>& dependencies)
     {
-        SP_ASSERT_MSG(work_total > 1, "A parallel loop can't have a range of 1 or smaller");
-
-        uint32_t available_threads = GetIdleThreadCount();
-        uint32_t work_per_thread   = work_total / available_threads;
-        uint32_t work_remainder    = work_total % available_threads;
-        uint32_t work_index        = 0;
-        atomic<uint32_t> work_done = 0;
-        condition_variable cv;
-        mutex cv_m;
+        JobHandle job = make_shared<Job>();
+        job->task     = std::forward<Task>(task);
+        job->self     = job;
+        jobs_in_flight++;
 
-        // split work into multiple tasks
-        while (work_index < work_total)
+        // register with any dependencies that haven't completed yet
+        for (const JobHandle& dependency : dependencies)
         {
-            uint32_t work_to_do = work_per_thread;
+            if (!dependency)
+                continue;
 
-            // if the work doesn't divide evenly across threads, add the remainder work to the first thread.
-            if (work_remainder != 0)
+            while (dependency->continuations_lock.test_and_set(memory_order_acquire)) {}
+            if (!dependency->complete.load(memory_order_acquire))
             {
-                work_to_do     += work_remainder;
-                work_remainder = 0;
+                job->dependencies_remaining++;
+                dependency->continuations.push_back(job.get());
             }
+            dependency->continuations_lock.clear(memory_order_release);
+        }
 
-            AddTask([&function, &work_done, &cv, work_index, work_to_do]()
-            {
-                function(work_index, work_index + work_to_do);
-                work_done += work_to_do;
+        // release the initial dependency, if nothing else is pending the job is ready to run
+        if (job->dependencies_remaining.fetch_sub(1) == 1)
+        {
+            enqueue(job.get());
+        }
 
-                cv.notify_one(); // notify that a thread has finished its work
-            });
+        return job;
+    }
 
-            work_index += work_to_do;
+    void ThreadPool::Wait(const JobHandle& job)
+    {
+        if (!job)
+            return;
+
+        if (is_worker_thread())
+        {
+            // a worker can't block, the job it waits on might be sitting in its own deque
+            while (!job->complete.load(memory_order_acquire))
+            {
+                if (Job* other = dequeue())
+                {
+                    execute(other);
+                }
+                else
+                {
+                    this_thread::yield();
+                }
+            }
+        }
+        else
+        {
+            job->complete.wait(false, memory_order_acquire);
         }
+    }
 
-        // wait for threads to finish work
-        unique_lock<mutex> lk(cv_m);
-        cv.wait(lk, [&]() { return work_done == work_total; });
+    void ThreadPool::Wait(const vector<JobHandle>& jobs)
+    {
+        for (const JobHandle& job : jobs)
+        {
+            Wait(job);
+        }
     }
 
-    void ThreadPool::Flush(bool remove_queued /*= false*/)
+    bool ThreadPool::IsComplete(const JobHandle& job)
     {
-        // clear any queued tasks
-        if (remove_queued)
+        return !job || job->complete.load(memory_order_acquire);
+    }
+
+    void ThreadPool::ParallelLoop(function<void(uint32_t work_index_start, uint32_t work_index_end)>&& function, const uint32_t work_total)
+    {
+        SP_ASSERT_MSG(work_total > 1, "A parallel loop can't have a range of 1 or smaller");
+
+        // split the work into more chunks than threads so that threads which finish early can pick up the slack
+        uint32_t chunk_count = min(work_total, (thread_count + 1) * 4);
+
+        shared_ptr<ParallelLoopState> state = make_shared<ParallelLoopState>();
+        state->loop_function  = std::forward<std::function<void(uint32_t, uint32_t)>>(function);
+        state->work_total     = work_total;
+        state->work_per_chunk = (work_total + chunk_count - 1) / chunk_count;
+
+        // helpers only claim chunks, so the state is shared with them in case they start after the loop has finished
+        uint32_t helper_count = min(thread_count, chunk_count - 1);
+        for (uint32_t i = 0; i < helper_count; i++)
         {
-            tasks.clear();
+            AddJob([state]() { parallel_loop_execute(*state); });
         }
 
-        // wait for any tasks to complete
-        while (AreTasksRunning())
+        // the calling thread works too
+        parallel_loop_execute(*state);
+
+        // wait for chunks that other threads are still working on
+        uint32_t work_done = state->work_done.load();
+        while (work_done != work_total)
         {
-            this_thread::sleep_for(chrono::milliseconds(16));
+            state->work_done.wait(work_done);
+            work_done = state->work_done.load();
         }
     }
 
+    void ThreadPool::Flush(bool remove_queued /*= false*/)
+    {
+        // queued jobs still get dequeued, but their tasks are skipped
+        is_flushing = remove_queued;
+
+        // wait for any jobs to complete
+        while (jobs_in_flight.load() != 0)
+        {
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+
+        is_flushing = false;
+    }
+
     uint32_t ThreadPool::GetThreadCount()        { return thread_count; }
     uint32_t ThreadPool::GetWorkingThreadCount() { return working_thread_count; }
-    uint32_t ThreadPool::GetIdleThreadCount()    { return thread_count - working_thread_count; }
-    bool ThreadPool::AreTasksRunning()           { return GetIdleThreadCount() != GetThreadCount(); }
+    uint32_t ThreadPool::GetIdleThreadCount()    { return thread_count - min(working_thread_count.load(), thread_count); }
+    bool ThreadPool::AreTasksRunning()           { return jobs_in_flight.load() != 0; }
 }
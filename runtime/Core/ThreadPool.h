@@ -24,12 +24,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ========
 #include <future>
 #include <functional>
+#include <vector>
+#include <memory>
 //===================
 
 namespace spartan
 {
     using Task = std::function<void()>;
 
+    // a job that can be waited on or used as a dependency of other jobs
+    struct Job;
+    using JobHandle = std::shared_ptr<Job>;
+
     class ThreadPool
     {
     public:
@@ -39,7 +45,16 @@ namespace spartan
         // add a task
         static std::future<void> AddTask(Task&& task);
 
-        // spread execution of a given function across all available threads
+        // add a job which only starts once all of its dependencies have completed
+        static JobHandle AddJob(Task&& task, const std::vector<JobHandle>& dependencies = {});
+
+        // wait for a job (and therefore all of its dependencies) to complete
+        // workers keep executing other jobs while waiting, so jobs can wait on jobs
+        static void Wait(const JobHandle& job);
+        static void Wait(const std::vector<JobHandle>& jobs);
+        static bool IsComplete(const JobHandle& job);
+
+        // spread execution of a given function across all available threads, the calling thread takes part in the work
         static void ParallelLoop(std::function<void(uint32_t work_index_start, uint32_t work_index_end)>&& function, const uint32_t work_total);
 
         // wait for all threads to finish work
@@ -101,6 +101,14 @@ namespace spartan
         }
         #endif
 
+        // without a gpu there is nothing to present to, so sdl runs on its offscreen video and dummy audio drivers
+        if (RHI_Context::api_type == RHI_Api_Type::Null)
+        {
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+            SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+            m_show_splash_screen = false;
+        }
+
         sdl_initialize_subystems();
 
         // show a splash screen
@@ -115,6 +123,10 @@ namespace spartan
         {
             flags |= SDL_WINDOW_VULKAN;
         }
+        else if (RHI_Context::api_type == RHI_Api_Type::Null)
+        {
+            flags = 0; // fixed size, so that runs are comparable
+        }
 
         // create window
         m_title = string(sp_info::name) + " " + to_string(sp_info::version_major) + "." + to_string(sp_info::version_minor) + "." + to_string(sp_info::version_revision);
@@ -864,6 +864,65 @@ namespace spartan
         }
     }
 
+    bool FileSystem::Rename(const string& source, const string& destination)
+    {
+        try
+        {
+            filesystem::rename(source, destination);
+            return true;
+        }
+        catch (filesystem::filesystem_error& e)
+        {
+            SP_LOG_ERROR("%s", e.what());
+        }
+
+        return false;
+    }
+
+    uint64_t FileSystem::HashBytes(const void* data, const uint64_t size, const uint64_t seed /*= 0*/)
+    {
+        // fnv-1a style, but consuming 8 bytes at a time so that multi-megabyte buffers hash quickly
+        const uint64_t prime = 0x100000001b3ull;
+        uint64_t hash        = 0xcbf29ce484222325ull ^ seed;
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+        uint64_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64_t word;
+            memcpy(&word, bytes + i, sizeof(word));
+            hash = (hash ^ word) * prime;
+            hash ^= hash >> 29;
+        }
+
+        for (; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * prime;
+        }
+
+        return hash ^ (hash >> 32);
+    }
+
+    uint64_t FileSystem::GetFileStamp(const string& path)
+    {
+        try
+        {
+            if (!filesystem::is_regular_file(path))
+                return 0;
+
+            uint64_t size       = static_cast<uint64_t>(filesystem::file_size(path));
+            int64_t  write_time = static_cast<int64_t>(filesystem::last_write_time(path).time_since_epoch().count());
+
+            return HashBytes(&write_time, sizeof(write_time), size);
+        }
+        catch (filesystem::filesystem_error& e)
+        {
+            SP_LOG_WARNING("%s, %s", e.what(), path.c_str());
+        }
+
+        return 0;
+    }
+
     bool FileSystem::DownloadFile(const string& url, const string& destination, function<void(float)> progress_callback)
     {
         namespace fs = filesystem;
@@ -89,6 +89,11 @@ namespace spartan
         static bool Delete(const std::string& path);
         static bool CreateDirectory_(const std::string& path);
         static bool CopyFileFromTo(const std::string& source, const std::string& destination);
+        static bool Rename(const std::string& source, const std::string& destination); // replaces the destination, use it to publish a fully written file
+
+        // hashing, used to key and validate cached/cooked data
+        static uint64_t HashBytes(const void* data, const uint64_t size, const uint64_t seed = 0);
+        static uint64_t GetFileStamp(const std::string& path); // hash of size and last write time, 0 if the file doesn't exist
 
         // internet & path
         static bool DownloadFile(const std::string& url, const std::string& destination, std::function<void(float)> progress_callback);
@@ -922,13 +922,13 @@ namespace spartan
                     terrain->SetHeightMap(height_map.get());
                     terrain->Generate();
 
-                    // add physics so we can walk on it
+                    // add physics so we can walk on it, a height field per tile so that distant tiles can be deactivated
                     for(Entity* entity : terrain->GetEntity()->GetChildren())
                     {
                         if (entity->GetActive() && entity->GetComponent<Renderable>() != nullptr)
                         {
                             Physics* physics_body = entity->AddComponent<Physics>();
-                            physics_body->SetBodyType(BodyType::Mesh);
+                            physics_body->SetBodyType(BodyType::Terrain);
                         }
                     }
                 }
@@ -0,0 +1,349 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========
+#include "pch.h"
+#include "Bvh.h"
+//====================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+namespace spartan
+{
+    namespace
+    {
+        const uint32_t bin_count      = 16;
+        const uint32_t leaf_size_max  = 4;  // larger leaves are always split, smaller ones only when the heuristic says so
+        const uint32_t stack_size     = 64; // also bounds the depth of the tree
+        const float cost_traversal    = 1.0f;
+        const float cost_intersection = 1.0f;
+
+        float component(const Vector3& v, const uint32_t axis)
+        {
+            return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+        }
+
+        struct Bounds
+        {
+            Vector3 min = Vector3::Infinity;
+            Vector3 max = Vector3::InfinityNeg;
+
+            void Merge(const Vector3& point)
+            {
+                min = Vector3::Min(min, point);
+                max = Vector3::Max(max, point);
+            }
+
+            void Merge(const Bounds& bounds)
+            {
+                min = Vector3::Min(min, bounds.min);
+                max = Vector3::Max(max, bounds.max);
+            }
+
+            float GetArea() const
+            {
+                if (min.x > max.x)
+                    return 0.0f;
+
+                const Vector3 extent = max - min;
+                return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+            }
+        };
+
+        // slab test, returns the entry distance or infinity
+        float intersect_box(const Vector3& min, const Vector3& max, const Vector3& origin, const Vector3& direction_inverse, const float distance_max)
+        {
+            const float tx1 = (min.x - origin.x) * direction_inverse.x, tx2 = (max.x - origin.x) * direction_inverse.x;
+            const float ty1 = (min.y - origin.y) * direction_inverse.y, ty2 = (max.y - origin.y) * direction_inverse.y;
+            const float tz1 = (min.z - origin.z) * direction_inverse.z, tz2 = (max.z - origin.z) * direction_inverse.z;
+
+            const float t_near = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+            const float t_far  = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), distance_max));
+
+            return t_near <= t_far ? t_near : numeric_limits<float>::infinity();
+        }
+
+        // moller-trumbore, same conventions as Ray::HitDistance()
+        float intersect_triangle(const Vector3& origin, const Vector3& direction, const Vector3& v0, const Vector3& v1, const Vector3& v2)
+        {
+            const Vector3 edge1 = v1 - v0;
+            const Vector3 edge2 = v2 - v0;
+            const Vector3 p     = direction.Cross(edge2);
+            const float det     = edge1.Dot(p);
+            if (det < numeric_limits<float>::min())
+                return numeric_limits<float>::infinity();
+
+            const Vector3 t = origin - v0;
+            const float u   = t.Dot(p);
+            if (u < 0.0f || u > det)
+                return numeric_limits<float>::infinity();
+
+            const Vector3 q = t.Cross(edge1);
+            const float v   = direction.Dot(q);
+            if (v < 0.0f || u + v > det)
+                return numeric_limits<float>::infinity();
+
+            const float distance = edge2.Dot(q) / det;
+            return distance >= 0.0f ? distance : numeric_limits<float>::infinity();
+        }
+    }
+
+    void Bvh::Build(const RHI_Vertex_PosTexNorTan* vertices, const uint32_t* indices, const uint32_t index_count)
+    {
+        Clear();
+
+        const uint32_t triangle_count = index_count / 3;
+        if (triangle_count == 0)
+            return;
+
+        // per triangle bounds and centroids
+        vector<Bounds> triangle_bounds(triangle_count);
+        vector<Vector3> centroids(triangle_count);
+        m_triangle_indices.resize(triangle_count);
+        for (uint32_t i = 0; i < triangle_count; i++)
+        {
+            for (uint32_t corner = 0; corner < 3; corner++)
+            {
+                const float* position = vertices[indices[i * 3 + corner]].pos;
+                triangle_bounds[i].Merge(Vector3(position[0], position[1], position[2]));
+            }
+            centroids[i]          = (triangle_bounds[i].min + triangle_bounds[i].max) * 0.5f;
+            m_triangle_indices[i] = i;
+        }
+
+        m_nodes.reserve(triangle_count * 2);
+        m_nodes.emplace_back();
+        m_nodes[0].first = 0;
+        m_nodes[0].count = triangle_count;
+
+        // nodes are split top-down, each split appends both children
+        vector<pair<uint32_t, uint32_t>> pending = { { 0, 0 } }; // node and depth
+        while (!pending.empty())
+        {
+            const auto [node_index, depth] = pending.back();
+            pending.pop_back();
+
+            const uint32_t first = m_nodes[node_index].first;
+            const uint32_t count = m_nodes[node_index].count;
+
+            Bounds bounds;
+            Bounds centroid_bounds;
+            for (uint32_t i = first; i < first + count; i++)
+            {
+                bounds.Merge(triangle_bounds[m_triangle_indices[i]]);
+                centroid_bounds.Merge(centroids[m_triangle_indices[i]]);
+            }
+            m_nodes[node_index].min = bounds.min;
+            m_nodes[node_index].max = bounds.max;
+
+            if (count <= 1 || depth + 2 >= stack_size)
+                continue;
+
+            // find the cheapest split plane with binned sah
+            float cost_best = numeric_limits<float>::max();
+            uint32_t axis   = 0;
+            uint32_t split  = 0; // bins below this go left
+            for (uint32_t a = 0; a < 3; a++)
+            {
+                const float extent = component(centroid_bounds.max, a) - component(centroid_bounds.min, a);
+                if (extent <= 0.0f)
+                    continue;
+
+                Bounds bins[bin_count];
+                uint32_t bin_triangles[bin_count] = {};
+                const float scale = bin_count / extent;
+                for (uint32_t i = first; i < first + count; i++)
+                {
+                    const uint32_t triangle = m_triangle_indices[i];
+                    const uint32_t bin      = std::min(bin_count - 1, static_cast<uint32_t>((component(centroids[triangle], a) - component(centroid_bounds.min, a)) * scale));
+                    bins[bin].Merge(triangle_bounds[triangle]);
+                    bin_triangles[bin]++;
+                }
+
+                // sweep from the right to get the cost of every right side, then from the left to evaluate each plane
+                float area_right[bin_count];
+                uint32_t count_right[bin_count];
+                Bounds sweep;
+                uint32_t sweep_count = 0;
+                for (uint32_t bin = bin_count - 1; bin > 0; bin--)
+                {
+                    sweep.Merge(bins[bin]);
+                    sweep_count      += bin_triangles[bin];
+                    area_right[bin]  = sweep.GetArea();
+                    count_right[bin] = sweep_count;
+                }
+
+                sweep       = Bounds();
+                sweep_count = 0;
+                for (uint32_t bin = 1; bin < bin_count; bin++)
+                {
+                    sweep.Merge(bins[bin - 1]);
+                    sweep_count += bin_triangles[bin - 1];
+                    if (sweep_count == 0 || count_right[bin] == 0)
+                        continue;
+
+                    const float cost = sweep.GetArea() * sweep_count + area_right[bin] * count_right[bin];
+                    if (cost < cost_best)
+                    {
+                        cost_best = cost;
+                        axis      = a;
+                        split     = bin;
+                    }
+                }
+            }
+
+            // keep the leaf if splitting doesn't pay off
+            const float cost_leaf = bounds.GetArea() * count * cost_intersection;
+            cost_best             = cost_traversal * bounds.GetArea() + cost_best * cost_intersection;
+            if (count <= leaf_size_max && (split == 0 || cost_best >= cost_leaf))
+                continue;
+
+            // partition, when all centroids coincide there is no plane so split in the middle
+            uint32_t middle = first + count / 2;
+            if (split != 0)
+            {
+                const float extent = component(centroid_bounds.max, axis) - component(centroid_bounds.min, axis);
+                const float scale  = bin_count / extent;
+                auto begin         = m_triangle_indices.begin() + first;
+                auto end           = begin + count;
+                middle             = static_cast<uint32_t>(std::partition(begin, end, [&](uint32_t triangle)
+                {
+                    return std::min(bin_count - 1, static_cast<uint32_t>((component(centroids[triangle], axis) - component(centroid_bounds.min, axis)) * scale)) < split;
+                }) - m_triangle_indices.begin());
+            }
+
+            const uint32_t child_left = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+            m_nodes.emplace_back();
+            m_nodes[child_left].first     = first;
+            m_nodes[child_left].count     = middle - first;
+            m_nodes[child_left + 1].first = middle;
+            m_nodes[child_left + 1].count = first + count - middle;
+            m_nodes[node_index].first     = child_left;
+            m_nodes[node_index].count     = 0;
+
+            pending.push_back({ child_left, depth + 1 });
+            pending.push_back({ child_left + 1, depth + 1 });
+        }
+
+        // store the positions in leaf order so that a leaf reads contiguous memory
+        m_positions.resize(static_cast<size_t>(triangle_count) * 3);
+        for (uint32_t i = 0; i < triangle_count; i++)
+        {
+            const uint32_t triangle = m_triangle_indices[i];
+            for (uint32_t corner = 0; corner < 3; corner++)
+            {
+                const float* position       = vertices[indices[triangle * 3 + corner]].pos;
+                m_positions[i * 3 + corner] = Vector3(position[0], position[1], position[2]);
+            }
+        }
+        m_nodes.shrink_to_fit();
+    }
+
+    void Bvh::Clear()
+    {
+        m_nodes.clear();
+        m_positions.clear();
+        m_triangle_indices.clear();
+    }
+
+    float Bvh::Intersect(const Vector3& origin, const Vector3& direction, const float distance_max, uint32_t* triangle_index, Vector3* normal) const
+    {
+        float distance_closest = numeric_limits<float>::infinity();
+        if (m_nodes.empty())
+            return distance_closest;
+
+        const Vector3 direction_inverse = Vector3(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+        float distance_limit            = distance_max;
+        uint32_t hit_index              = numeric_limits<uint32_t>::max();
+
+        uint32_t stack[stack_size];
+        uint32_t stack_count = 0;
+        if (intersect_box(m_nodes[0].min, m_nodes[0].max, origin, direction_inverse, distance_limit) != numeric_limits<float>::infinity())
+        {
+            stack[stack_count++] = 0;
+        }
+
+        while (stack_count > 0)
+        {
+            const Node& node = m_nodes[stack[--stack_count]];
+
+            if (node.count > 0)
+            {
+                for (uint32_t i = node.first; i < node.first + node.count; i++)
+                {
+                    const float distance = intersect_triangle(origin, direction, m_positions[i * 3], m_positions[i * 3 + 1], m_positions[i * 3 + 2]);
+                    if (distance < distance_limit)
+                    {
+                        distance_limit   = distance;
+                        distance_closest = distance;
+                        hit_index        = i;
+                    }
+                }
+                continue;
+            }
+
+            // visit the nearer child first, it's pushed last
+            float distance_left  = intersect_box(m_nodes[node.first].min, m_nodes[node.first].max, origin, direction_inverse, distance_limit);
+            float distance_right = intersect_box(m_nodes[node.first + 1].min, m_nodes[node.first + 1].max, origin, direction_inverse, distance_limit);
+            uint32_t child_near  = node.first;
+            uint32_t child_far   = node.first + 1;
+            if (distance_right < distance_left)
+            {
+                swap(distance_left, distance_right);
+                swap(child_near, child_far);
+            }
+
+            if (distance_right != numeric_limits<float>::infinity())
+            {
+                stack[stack_count++] = child_far;
+            }
+            if (distance_left != numeric_limits<float>::infinity())
+            {
+                stack[stack_count++] = child_near;
+            }
+        }
+
+        if (hit_index != numeric_limits<uint32_t>::max())
+        {
+            if (triangle_index)
+            {
+                *triangle_index = m_triangle_indices[hit_index];
+            }
+
+            if (normal)
+            {
+                const Vector3& v0 = m_positions[hit_index * 3];
+                *normal           = (m_positions[hit_index * 3 + 1] - v0).Cross(m_positions[hit_index * 3 + 2] - v0).Normalized();
+            }
+        }
+
+        return distance_closest;
+    }
+
+    uint64_t Bvh::GetMemoryUsage() const
+    {
+        return m_nodes.capacity() * sizeof(Node) + m_positions.capacity() * sizeof(Vector3) + m_triangle_indices.capacity() * sizeof(uint32_t);
+    }
+}
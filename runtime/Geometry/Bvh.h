@@ -0,0 +1,66 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =================
+#include <vector>
+#include "../RHI/RHI_Vertex.h"
+#include "../Math/Vector3.h"
+//============================
+
+namespace spartan
+{
+    // bounding volume hierarchy over the triangles of a mesh, built with the surface area heuristic
+    // queries happen in the space of the geometry, callers transform the ray instead of the vertices
+    class Bvh
+    {
+    public:
+        void Build(const RHI_Vertex_PosTexNorTan* vertices, const uint32_t* indices, const uint32_t index_count);
+        void Clear();
+
+        // returns the distance along the direction (in units of its length) or infinity if there is no hit, back faces are ignored
+        float Intersect(
+            const math::Vector3& origin,
+            const math::Vector3& direction,
+            const float distance_max,
+            uint32_t* triangle_index = nullptr,
+            math::Vector3* normal    = nullptr
+        ) const;
+
+        bool IsBuilt() const              { return !m_nodes.empty(); }
+        uint32_t GetTriangleCount() const { return static_cast<uint32_t>(m_triangle_indices.size()); }
+        uint64_t GetMemoryUsage() const;
+
+    private:
+        struct Node
+        {
+            math::Vector3 min;
+            uint32_t first = 0; // first triangle for leaves, left child for interior nodes (the right one follows it)
+            math::Vector3 max;
+            uint32_t count = 0; // triangle count, 0 for interior nodes
+        };
+
+        std::vector<Node> m_nodes;
+        std::vector<math::Vector3> m_positions;    // three per triangle, in leaf order
+        std::vector<uint32_t> m_triangle_indices; // leaf order to the triangle's index in the source geometry
+    };
+}
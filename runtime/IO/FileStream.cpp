@@ -23,6 +23,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "pch.h"
 #include "FileStream.h"
 #include "../RHI/RHI_Vertex.h"
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 //============================
 
 //= NAMESPACES =====
@@ -31,32 +39,47 @@ using namespace std;
 
 namespace spartan
 {
-    FileStream::FileStream(const string& path, uint32_t flags)
+    namespace
     {
-        m_is_open = false;
-        m_flags   = flags;
+        // large enough that serializing a world or a mesh results in a handful of writes
+        const uint64_t write_buffer_size = 1024 * 1024;
+    }
 
-        ios_base::openmode ios_flags = ios::binary;
-        if(flags & FileStream_Read)   ios_flags |= ios::in;
-        if(flags & FileStream_Write)  ios_flags |= ios::out;
-        if(flags & FileStream_Append) ios_flags |= ios::app;
+    FileStream::FileStream(const string& path, uint32_t flags)
+    {
+        m_flags = flags;
 
         if (m_flags & FileStream_Write)
         {
-            out.open(path, ios_flags);
-            if (out.fail())
+            ios_base::openmode ios_flags = ios::binary | ios::out;
+            if (flags & FileStream_Append) ios_flags |= ios::app;
+
+            m_out.open(path, ios_flags);
+            if (m_out.fail())
             {
                 SP_LOG_ERROR("Failed to open \"%s\" for writing", path.c_str());
                 return;
             }
+
+            m_write_buffer.resize(write_buffer_size);
         }
         else if (m_flags & FileStream_Read)
         {
-            in.open(path, ios_flags);
-            if(in.fail())
+            if (!Map(path))
             {
-                SP_LOG_ERROR("Failed to open \"%s\" for reading", path.c_str());
-                return;
+                // empty files can't be mapped, and some file systems don't support mapping, so read everything instead
+                ifstream in(path, ios::binary | ios::ate);
+                if (in.fail())
+                {
+                    SP_LOG_ERROR("Failed to open \"%s\" for reading", path.c_str());
+                    return;
+                }
+
+                m_read_fallback.resize(static_cast<size_t>(in.tellg()));
+                in.seekg(0);
+                in.read(reinterpret_cast<char*>(m_read_fallback.data()), static_cast<streamsize>(m_read_fallback.size()));
+                m_read_data = m_read_fallback.data();
+                m_read_size = m_read_fallback.size();
             }
         }
 
@@ -70,24 +93,176 @@ namespace spartan
 
     void FileStream::Close()
     {
+        if (!m_is_open)
+            return;
+
         if (m_flags & FileStream_Write)
         {
-            out.flush();
-            out.close();
+            FlushWriteBuffer();
+            m_out.close();
         }
         else if (m_flags & FileStream_Read)
         {
-            in.clear();
-            in.close();
+            Unmap();
+            m_read_fallback.clear();
+            m_read_fallback.shrink_to_fit();
+            m_read_data     = nullptr;
+            m_read_size     = 0;
+            m_read_position = 0;
+        }
+
+        m_is_open = false;
+    }
+
+    bool FileStream::Map(const string& path)
+    {
+    #ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size = {};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_map_file   = file;
+        m_map_handle = mapping;
+        m_read_data  = static_cast<const std::byte*>(view);
+        m_read_size  = static_cast<uint64_t>(size.QuadPart);
+    #else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file == -1)
+            return false;
+
+        struct stat info = {};
+        if (fstat(file, &info) != 0 || info.st_size <= 0)
+        {
+            close(file);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file); // the mapping keeps its own reference to the file
+        if (view == MAP_FAILED)
+            return false;
+
+        madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+        m_map_handle = view;
+        m_read_data  = static_cast<const std::byte*>(view);
+        m_read_size  = static_cast<uint64_t>(info.st_size);
+    #endif
+
+        return true;
+    }
+
+    void FileStream::Unmap()
+    {
+        if (!m_map_handle)
+            return;
+
+    #ifdef _WIN32
+        UnmapViewOfFile(m_read_data);
+        CloseHandle(m_map_handle);
+        CloseHandle(m_map_file);
+    #else
+        munmap(m_map_handle, static_cast<size_t>(m_read_size));
+    #endif
+
+        m_map_file   = nullptr;
+        m_map_handle = nullptr;
+    }
+
+    void FileStream::FlushWriteBuffer()
+    {
+        if (m_write_buffer_used == 0)
+            return;
+
+        m_out.write(reinterpret_cast<const char*>(m_write_buffer.data()), static_cast<streamsize>(m_write_buffer_used));
+        m_write_buffer_used = 0;
+    }
+
+    void FileStream::WriteBytes(const void* data, uint64_t size)
+    {
+        if (size == 0)
+            return;
+
+        m_write_position += size;
+
+        // large writes bypass the buffer
+        if (size >= m_write_buffer.size())
+        {
+            FlushWriteBuffer();
+            m_out.write(static_cast<const char*>(data), static_cast<streamsize>(size));
+            return;
+        }
+
+        if (m_write_buffer_used + size > m_write_buffer.size())
+        {
+            FlushWriteBuffer();
+        }
+
+        memcpy(m_write_buffer.data() + m_write_buffer_used, data, size);
+        m_write_buffer_used += size;
+    }
+
+    void FileStream::ReadBytes(void* data, uint64_t size)
+    {
+        const uint64_t available = m_read_size - m_read_position;
+        const uint64_t count     = size <= available ? size : available;
+
+        if (count != 0)
+        {
+            memcpy(data, m_read_data + m_read_position, count);
+            m_read_position += count;
+        }
+
+        // reading past the end yields zeros, so callers don't consume uninitialized memory
+        if (count < size)
+        {
+            memset(static_cast<std::byte*>(data) + count, 0, size - count);
+            SP_LOG_ERROR("Attempted to read %llu bytes past the end of the file", static_cast<unsigned long long>(size - count));
+        }
+    }
+
+    span<const std::byte> FileStream::ViewBytes(uint64_t size)
+    {
+        const uint64_t available = m_read_size - m_read_position;
+        if (size > available)
+        {
+            SP_LOG_ERROR("Attempted to view %llu bytes past the end of the file", static_cast<unsigned long long>(size - available));
+            size = available;
         }
+
+        span<const std::byte> view(m_read_data + m_read_position, static_cast<size_t>(size));
+        m_read_position += size;
+
+        return view;
     }
 
     void FileStream::Write(const string& value)
     {
         const auto length = static_cast<uint32_t>(value.length());
         Write(length);
-
-        out.write(const_cast<char*>(value.c_str()), length);
+        WriteBytes(value.data(), length);
     }
 
     void FileStream::Write(const vector<string>& value)
@@ -105,45 +280,47 @@ namespace spartan
     {
         const auto length = static_cast<uint32_t>(value.size());
         Write(length);
-        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(RHI_Vertex_PosTexNorTan) * length);
+        WriteBytes(value.data(), sizeof(RHI_Vertex_PosTexNorTan) * length);
     }
 
     void FileStream::Write(const vector<uint32_t>& value)
     {
         const auto length = static_cast<uint32_t>(value.size());
         Write(length);
-        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(uint32_t) * length);
+        WriteBytes(value.data(), sizeof(uint32_t) * length);
     }
 
     void FileStream::Write(const vector<unsigned char>& value)
     {
         const auto size = static_cast<uint32_t>(value.size());
         Write(size);
-        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(unsigned char) * size);
+        WriteBytes(value.data(), sizeof(unsigned char) * size);
     }
 
-    void FileStream::Write(const vector<byte>& value)
+    void FileStream::Write(const vector<std::byte>& value)
     {
         const auto size = static_cast<uint32_t>(value.size());
         Write(size);
-        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(std::byte) * size);
+        WriteBytes(value.data(), sizeof(std::byte) * size);
     }
 
     void FileStream::Write(const atomic<bool>& value)
     {
-        out.write(reinterpret_cast<const char*>(&value), sizeof(bool));
+        Write(value.load());
     }
 
     void FileStream::Skip(uint64_t n)
     {
-        // Set the seek cursor to offset n from the current position
+        // set the cursor to offset n from the current position
         if (m_flags & FileStream_Write)
         {
-            out.seekp(n, ios::cur);
+            FlushWriteBuffer();
+            m_out.seekp(n, ios::cur);
+            m_write_position += n;
         }
         else if (m_flags & FileStream_Read)
         {
-            in.ignore(n, ios::cur);
+            m_read_position += n <= m_read_size - m_read_position ? n : m_read_size - m_read_position;
         }
     }
 
@@ -153,7 +330,7 @@ namespace spartan
         Read(&length);
 
         value->resize(length);
-        in.read(const_cast<char*>(value->c_str()), length);
+        ReadBytes(value->data(), length);
     }
 
     void FileStream::Read(vector<string>* vec)
@@ -166,11 +343,10 @@ namespace spartan
         uint32_t size = 0;
         Read(&size);
 
-        string str;
+        vec->resize(size);
         for (uint32_t i = 0; i < size; i++)
         {
-            Read(&str);
-            vec->emplace_back(str);
+            Read(&(*vec)[i]);
         }
     }
 
@@ -179,14 +355,8 @@ namespace spartan
         if (!vec)
             return;
 
-        vec->clear();
-
-        const auto length = ReadAs<uint32_t>();
-
-        vec->reserve(length);
-        vec->resize(length);
-
-        in.read(reinterpret_cast<char*>(vec->data()), sizeof(RHI_Vertex_PosTexNorTan) * length);
+        vec->resize(ReadAs<uint32_t>());
+        ReadBytes(vec->data(), sizeof(RHI_Vertex_PosTexNorTan) * vec->size());
     }
 
     void FileStream::Read(vector<uint32_t>* vec)
@@ -194,14 +364,8 @@ namespace spartan
         if (!vec)
             return;
 
-        vec->clear();
-
-        const auto length = ReadAs<uint32_t>();
-
-        vec->reserve(length);
-        vec->resize(length);
-
-        in.read(reinterpret_cast<char*>(vec->data()), sizeof(uint32_t) * length);
+        vec->resize(ReadAs<uint32_t>());
+        ReadBytes(vec->data(), sizeof(uint32_t) * vec->size());
     }
 
     void FileStream::Read(vector<unsigned char>* vec)
@@ -209,14 +373,8 @@ namespace spartan
         if (!vec)
             return;
 
-        vec->clear();
-
-        const auto length = ReadAs<uint32_t>();
-
-        vec->reserve(length);
-        vec->resize(length);
-
-        in.read(reinterpret_cast<char*>(vec->data()), sizeof(unsigned char) * length);
+        vec->resize(ReadAs<uint32_t>());
+        ReadBytes(vec->data(), sizeof(unsigned char) * vec->size());
     }
 
     void FileStream::Read(vector<std::byte>* vec)
@@ -224,18 +382,12 @@ namespace spartan
         if (!vec)
             return;
 
-        vec->clear();
-
-        const auto length = ReadAs<uint32_t>();
-
-        vec->reserve(length);
-        vec->resize(length);
-
-        in.read(reinterpret_cast<char*>(vec->data()), sizeof(std::byte) * length);
+        vec->resize(ReadAs<uint32_t>());
+        ReadBytes(vec->data(), sizeof(std::byte) * vec->size());
     }
 
     void FileStream::Read(std::atomic<bool>* value)
     {
-        in.read(reinterpret_cast<char*>(value), sizeof(bool));
+        value->store(ReadAs<bool>());
     }
 }
@@ -24,6 +24,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===================
 #include <vector>
 #include <fstream>
+#include <span>
+#include <cstring>
 #include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
 #include "../Math/Vector4.h"
@@ -41,6 +43,8 @@ namespace spartan
         FileStream_Append = 1 << 2,
     };
 
+    // reading maps the whole file into memory, so reads are bounds checked memcpys and views are zero-copy
+    // writing goes through a large user-space buffer which is flushed to disk when full and on close
     class FileStream
     {
     public:
@@ -50,6 +54,10 @@ namespace spartan
         auto IsOpen() const { return m_is_open; }
         void Close();
 
+        // position and size, in bytes
+        uint64_t GetPosition() const { return (m_flags & FileStream_Write) ? m_write_position : m_read_position; }
+        uint64_t GetSize() const     { return (m_flags & FileStream_Write) ? m_write_position : m_read_size; }
+
         //= WRITING ==================================================
         template <class T, class = typename std::enable_if<
             std::is_same<T, bool>::value                ||
@@ -76,9 +84,28 @@ namespace spartan
         >::type>
         void Write(T value)
         {
-            out.write(reinterpret_cast<char*>(&value), sizeof(value));
+            // fast path, the value fits in the buffer
+            if (m_write_buffer_used + sizeof(T) <= m_write_buffer.size())
+            {
+                std::memcpy(m_write_buffer.data() + m_write_buffer_used, &value, sizeof(T));
+                m_write_buffer_used += sizeof(T);
+                m_write_position    += sizeof(T);
+                return;
+            }
+
+            WriteBytes(&value, sizeof(value));
+        }
+
+        // bulk write of a contiguous range, without a length prefix
+        template <class T>
+        void Write(std::span<const T> values)
+        {
+            SP_ASSERT_STATIC_IS_TRIVIALLY_COPYABLE(T);
+            WriteBytes(values.data(), values.size_bytes());
         }
 
+        void WriteBytes(const void* data, uint64_t size);
+
         void Write(const std::string& value);
         void Write(const std::vector<std::string>& value);
         void Write(const std::vector<RHI_Vertex_PosTexNorTan>& value);
@@ -116,7 +143,38 @@ namespace spartan
         >::type>
         void Read(T* value)
         {
-            in.read(reinterpret_cast<char*>(value), sizeof(T));
+            // fast path, the value is within the file
+            if (m_read_position + sizeof(T) <= m_read_size)
+            {
+                std::memcpy(value, m_read_data + m_read_position, sizeof(T));
+                m_read_position += sizeof(T);
+                return;
+            }
+
+            ReadBytes(value, sizeof(T));
+        }
+
+        // bulk read of a contiguous range, without a length prefix
+        template <class T>
+        void Read(std::span<T> values)
+        {
+            SP_ASSERT_STATIC_IS_TRIVIALLY_COPYABLE(T);
+            ReadBytes(values.data(), values.size_bytes());
+        }
+
+        void ReadBytes(void* data, uint64_t size);
+
+        // zero-copy view of the next size bytes, valid until the stream is closed
+        std::span<const std::byte> ViewBytes(uint64_t size);
+
+        // zero-copy view of the next count elements, the data has to be suitably aligned within the file
+        template <class T>
+        std::span<const T> View(uint64_t count)
+        {
+            SP_ASSERT_STATIC_IS_TRIVIALLY_COPYABLE(T);
+            std::span<const std::byte> bytes = ViewBytes(count * sizeof(T));
+            SP_ASSERT(reinterpret_cast<uintptr_t>(bytes.data()) % alignof(T) == 0);
+            return std::span<const T>(reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T));
         }
         void Read(std::string* value);
         void Read(std::vector<std::string>* vec);
@@ -155,9 +213,25 @@ namespace spartan
         //=====================================================
 
     private:
-        std::ofstream out;
-        std::ifstream in;
-        uint32_t m_flags;
-        bool m_is_open;
+        bool Map(const std::string& path);
+        void Unmap();
+        void FlushWriteBuffer();
+
+        // writing
+        std::ofstream m_out;
+        std::vector<std::byte> m_write_buffer;
+        uint64_t m_write_buffer_used = 0;
+        uint64_t m_write_position    = 0;
+
+        // reading
+        const std::byte* m_read_data = nullptr;
+        uint64_t m_read_size         = 0;
+        uint64_t m_read_position     = 0;
+        std::vector<std::byte> m_read_fallback; // used when the file can't be mapped (e.g. it's empty)
+        void* m_map_file             = nullptr;
+        void* m_map_handle           = nullptr;
+
+        uint32_t m_flags = 0;
+        bool m_is_open   = false;
     };
 }
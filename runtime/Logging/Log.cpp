@@ -32,62 +32,284 @@ using namespace spartan::math;
 
 namespace spartan
 {
+    LogType Log::m_level = LogType::Info;
+
     namespace
     {
-        vector<LogCmd> logs;
+        struct Message
+        {
+            string text;
+            LogType type          = LogType::Info;
+            bool to_file          = false;
+            bool to_benchmark     = false; // logged by the benchmark, goes to its own file and not to the logger
+            atomic<Message*> next = nullptr;
+        };
+
+        // intrusive multi-producer single-consumer queue, producers never block each other
+        // the only consumer is the writer thread
+        namespace queue
+        {
+            Message stub;
+            atomic<Message*> head = &stub;
+            Message* tail         = &stub;
+
+            void push(Message* message)
+            {
+                message->next.store(nullptr, memory_order_relaxed);
+                Message* previous = head.exchange(message, memory_order_acq_rel);
+                previous->next.store(message, memory_order_release);
+            }
+
+            // returns null when empty, or when a producer is half way through a push
+            Message* pop()
+            {
+                Message* first = tail;
+                Message* next  = first->next.load(memory_order_acquire);
+
+                if (first == &stub)
+                {
+                    if (!next)
+                        return nullptr;
+
+                    tail  = next;
+                    first = next;
+                    next  = next->next.load(memory_order_acquire);
+                }
+
+                if (next)
+                {
+                    tail = next;
+                    return first;
+                }
+
+                if (first != head.load(memory_order_acquire))
+                    return nullptr;
+
+                push(&stub);
+
+                next = first->next.load(memory_order_acquire);
+                if (next)
+                {
+                    tail = next;
+                    return first;
+                }
+
+                return nullptr;
+            }
+        }
+
+        // writer thread
+        thread writer;
+        thread_local bool is_writer_thread = false;
+        atomic<bool> writer_is_running     = false;
+        atomic<bool> writer_is_stopping    = false;
+        atomic<uint32_t> writer_wake       = 0;
+        atomic<uint64_t> sequence_enqueued = 0;
+        atomic<uint64_t> sequence_written  = 0;
+
+        // file, opened once and kept open
         string log_file_name = "log.txt";
-        ILogger* logger      = nullptr;
         bool log_to_file     = true;
+        ofstream file;
+        mutex mutex_file;
+
+        // benchmark, see Log::SetBenchmarkFile()
+        thread_local bool is_benchmark_thread = false;
+        ofstream file_benchmark;
+
+        // logger, and a bounded history of what was logged before a logger was set
+        const uint32_t history_max = 1024;
+        deque<LogCmd> history;
+        ILogger* logger = nullptr;
+        mutex mutex_logger;
+
+        const char* get_prefix(const LogType type)
+        {
+            return (type == LogType::Info) ? "Info: " : (type == LogType::Warning) ? "Warning: " : "Error: ";
+        }
+
+        void write_to_file(const string& buffer)
+        {
+            lock_guard<mutex> lock(mutex_file);
+
+            // the previous log file is replaced the first time something is written
+            if (!file.is_open())
+            {
+                static bool is_first_write = true;
+                file.open(log_file_name, ofstream::out | (is_first_write ? ofstream::trunc : ofstream::app));
+                is_first_write = false;
+            }
 
-        void write_to_file(string text, const LogType type)
+            if (file.is_open())
+            {
+                file.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+                file.flush();
+            }
+        }
+
+        void write_to_logger(Message& message)
         {
-            const string prefix = (type == LogType::Info) ? "Info:" : (type == LogType::Warning) ? "Warning:" : "Error:";
-            text = prefix + " " + text;
+            if (logger)
+            {
+                logger->Log(message.text, static_cast<uint32_t>(message.type));
+            }
+            else
+            {
+                history.emplace_back(message.text, message.type);
+                if (history.size() > history_max)
+                {
+                    history.pop_front();
+                }
+            }
+        }
 
-            // delete the previous log file (if it exists)
-            static bool is_first_log = true;
-            if (is_first_log)
+        // writes a batch of messages with a single file write
+        void write(vector<unique_ptr<Message>>& messages)
+        {
+            string buffer;
+            string buffer_benchmark;
+            for (const unique_ptr<Message>& message : messages)
             {
-                FileSystem::Delete(log_file_name);
-                is_first_log = false;
+                if (message->to_file || message->to_benchmark)
+                {
+                    string& destination  = message->to_benchmark ? buffer_benchmark : buffer;
+                    destination         += get_prefix(message->type);
+                    destination         += message->text;
+                    destination         += '\n';
+                }
             }
 
-            // open/create a log file to write the log into
-            static ofstream fout;
-            fout.open(log_file_name, ofstream::out | ofstream::app);
+            if (!buffer.empty())
+            {
+                write_to_file(buffer);
+            }
 
-            if (fout.is_open())
+            if (!buffer_benchmark.empty())
             {
-                // write out the error message
-                fout << text << endl;
+                lock_guard<mutex> lock(mutex_file);
+                if (file_benchmark.is_open())
+                {
+                    file_benchmark.write(buffer_benchmark.data(), static_cast<streamsize>(buffer_benchmark.size()));
+                    file_benchmark.flush();
+                }
+            }
 
-                // close the file
-                fout.close();
+            lock_guard<mutex> lock(mutex_logger);
+            for (unique_ptr<Message>& message : messages)
+            {
+                if (!message->to_benchmark)
+                {
+                    write_to_logger(*message);
+                }
+            }
+        }
+
+        void writer_loop()
+        {
+            is_writer_thread = true;
+
+            vector<unique_ptr<Message>> batch;
+            while (true)
+            {
+                const uint32_t wake = writer_wake.load(memory_order_acquire);
+
+                while (Message* message = queue::pop())
+                {
+                    batch.emplace_back(message);
+                }
+
+                if (!batch.empty())
+                {
+                    write(batch);
+                    sequence_written.fetch_add(batch.size(), memory_order_release);
+                    sequence_written.notify_all();
+                    batch.clear();
+                    continue;
+                }
+
+                // a message is still being pushed
+                if (sequence_written.load() != sequence_enqueued.load())
+                {
+                    this_thread::yield();
+                    continue;
+                }
+
+                if (writer_is_stopping)
+                    break;
+
+                writer_wake.wait(wake, memory_order_acquire);
+            }
+        }
+
+        void writer_start()
+        {
+            if (writer_is_running)
+                return;
+
+            writer_is_stopping = false;
+            writer             = thread(&writer_loop);
+            writer_is_running  = true;
+        }
+
+        void writer_stop()
+        {
+            if (!writer_is_running)
+                return;
+
+            writer_is_running  = false;
+            writer_is_stopping = true;
+            writer_wake.fetch_add(1, memory_order_release);
+            writer_wake.notify_one();
+            writer.join();
+        }
+
+        // stops the writer (which drains the queue) if the engine didn't
+        struct WriterGuard
+        {
+            ~WriterGuard() { writer_stop(); }
+        } writer_guard;
+
+        void wait_until_written(const uint64_t sequence)
+        {
+            uint64_t written = sequence_written.load(memory_order_acquire);
+            while (written < sequence)
+            {
+                sequence_written.wait(written, memory_order_acquire);
+                written = sequence_written.load(memory_order_acquire);
             }
         }
     }
 
     void Log::Initialize()
     {
+        writer_start();
+
         SP_SUBSCRIBE_TO_EVENT(EventType::RendererOnFirstFrameCompleted, SP_EVENT_HANDLER_EXPRESSION_STATIC( SetLogToFile(false); ));
         SP_SUBSCRIBE_TO_EVENT(EventType::RendererOnShutdown,            SP_EVENT_HANDLER_EXPRESSION_STATIC( SetLogToFile(true);  ));
     }
 
+    void Log::Shutdown()
+    {
+        writer_stop();
+
+        lock_guard<mutex> lock(mutex_file);
+        file.close();
+    }
+
     void Log::SetLogger(ILogger* logger_in)
     {
+        lock_guard<mutex> lock(mutex_logger);
+
         logger = logger_in;
 
-        // flush the log buffer, if needed
-        if (logger && !logs.empty())
+        // replay what was logged so far
+        if (logger)
         {
-            if (!logs.empty())
+            for (const LogCmd& log : history)
             {
-                for (const LogCmd& log : logs)
-                {
-                    logger->Log(log.text, static_cast<uint32_t>(log.type));
-                }
-                logs.clear();
+                logger->Log(log.text, static_cast<uint32_t>(log.type));
             }
+            history.clear();
         }
     }
 
@@ -96,24 +318,47 @@ namespace spartan
         log_to_file = log;
     }
 
+    void Log::SetBenchmarkFile(const string& path)
+    {
+        lock_guard<mutex> lock(mutex_file);
+
+        file_benchmark.close();
+
+        if (!path.empty())
+        {
+            file_benchmark.open(path, ofstream::out | ofstream::trunc);
+        }
+    }
+
+    void Log::SetBenchmarkThread(const bool is_benchmark)
+    {
+        is_benchmark_thread = is_benchmark;
+    }
+
     void Log::Clear()
     {
-        // lock mutex to ensure thread safety
-        static std::mutex log_mutex;
-        std::lock_guard<std::mutex> guard(log_mutex);
+        Flush();
 
         // clear the in-memory logs
-        logs.clear();
+        {
+            lock_guard<mutex> lock(mutex_logger);
+            history.clear();
+        }
 
         // clear the file if logging to file is enabled
         if (log_to_file || Debugging::IsLoggingToFileEnabled())
         {
-            // open the file in truncate mode to clear its contents
-            std::ofstream file("log.txt", std::ios::out | std::ios::trunc);
-            if (file.is_open())
-            {
-                file.close();
-            }
+            lock_guard<mutex> lock(mutex_file);
+            file.close();
+            file.open(log_file_name, ofstream::out | ofstream::trunc);
+        }
+    }
+
+    void Log::Flush()
+    {
+        if (writer_is_running)
+        {
+            wait_until_written(sequence_enqueued.load(memory_order_acquire));
         }
     }
 
@@ -121,35 +366,62 @@ namespace spartan
     void Log::Write(const char* text, const LogType type)
     {
         SP_ASSERT_MSG(text != nullptr, "Text is null");
-    
-        // lock mutex
-        static mutex log_mutex;
-        lock_guard<mutex> guard(log_mutex);
-    
-        // add time to the text
-        auto t = time(nullptr);
-        tm tm_struct{};
-        localtime_s(&tm_struct, &t);
-    
-        ostringstream oss;
-        oss << put_time(&tm_struct, "[%H:%M:%S]");
-        const string final_text = oss.str() + ": " + string(text);
-    
-        // log to file if requested or if an in-engine logger is not available
-        if (log_to_file || !logger || Debugging::IsLoggingToFileEnabled())
+
+        if (!IsEnabled(type))
+            return;
+
+        // add time to the text, the formatted time is cached per thread since it only changes once a second
+        thread_local time_t time_last   = 0;
+        thread_local char time_text[16] = {};
+        const time_t time_now           = time(nullptr);
+        if (time_now != time_last)
         {
-            logs.emplace_back(final_text, type);
-            write_to_file(final_text, type);
+            tm tm_struct{};
+            localtime_s(&tm_struct, &time_now);
+            strftime(time_text, sizeof(time_text), "[%H:%M:%S]", &tm_struct);
+            time_last = time_now;
         }
-    
-        if (logger)
+
+        unique_ptr<Message> message = make_unique<Message>();
+        message->text.reserve(strlen(time_text) + 2 + strlen(text));
+        message->text += time_text;
+        message->text += ": ";
+        message->text += text;
+        message->type    = type;
+        message->to_file      = log_to_file || !logger || Debugging::IsLoggingToFileEnabled();
+        message->to_benchmark = is_benchmark_thread;
+
+        // without the writer thread (before initialization or after shutdown), write directly
+        if (!writer_is_running)
+        {
+            if (message->to_file)
+            {
+                write_to_file(get_prefix(type) + message->text + '\n');
+            }
+
+            lock_guard<mutex> lock(mutex_logger);
+            write_to_logger(*message);
+            return;
+        }
+
+        queue::push(message.release());
+        const uint64_t sequence = sequence_enqueued.fetch_add(1, memory_order_acq_rel) + 1;
+        writer_wake.fetch_add(1, memory_order_release);
+        writer_wake.notify_one();
+
+        // errors often precede a crash or an assert, so make sure they reach the file
+        // the writer thread itself can log through the logger, it can't wait on itself
+        if (type == LogType::Error && !is_writer_thread)
         {
-            logger->Log(final_text, static_cast<uint32_t>(type));
+            wait_until_written(sequence);
         }
     }
 
     void Log::WriteFInfo(const char* text, ...)
     {
+        if (!IsEnabled(LogType::Info))
+            return;
+
         char buffer[1024];
         va_list args;
         va_start(args, text);
@@ -161,6 +433,9 @@ namespace spartan
 
     void Log::WriteFWarning(const char* text, ...)
     {
+        if (!IsEnabled(LogType::Warning))
+            return;
+
         char buffer[1024];
         va_list args;
         va_start(args, text);
@@ -172,6 +447,9 @@ namespace spartan
 
     void Log::WriteFError(const char* text, ...)
     {
+        if (!IsEnabled(LogType::Error))
+            return;
+
         char buffer[1024];
         va_list args;
         va_start(args, text);
@@ -188,6 +466,9 @@ namespace spartan
 
     void Log::WriteFInfo(const string text, ...)
     {
+        if (!IsEnabled(LogType::Info))
+            return;
+
         char buffer[2048];
         va_list args;
         va_start(args, text);
@@ -199,6 +480,9 @@ namespace spartan
 
     void Log::WriteFWarning(const string text, ...)
     {
+        if (!IsEnabled(LogType::Warning))
+            return;
+
         char buffer[2048];
         va_list args;
         va_start(args, text);
@@ -210,6 +494,9 @@ namespace spartan
 
     void Log::WriteFError(const string text, ...)
     {
+        if (!IsEnabled(LogType::Error))
+            return;
+
         char buffer[2048];
         va_list args;
         va_start(args, text);
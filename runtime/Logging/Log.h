@@ -29,9 +29,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace spartan
 {
-    #define SP_LOG_INFO(text, ...)    { spartan::Log::WriteFInfo(std::string(__FUNCTION__)    + ": " + std::string(text), ## __VA_ARGS__); }
-    #define SP_LOG_WARNING(text, ...) { spartan::Log::WriteFWarning(std::string(__FUNCTION__) + ": " + std::string(text), ## __VA_ARGS__); }
-    #define SP_LOG_ERROR(text, ...)   { spartan::Log::WriteFError(std::string(__FUNCTION__)   + ": " + std::string(text), ## __VA_ARGS__); }
+    // the level is checked first, so filtered out messages cost no formatting
+    #define SP_LOG_INFO(text, ...)    { if (spartan::Log::IsEnabled(spartan::LogType::Info))    spartan::Log::WriteFInfo(std::string(__FUNCTION__)    + ": " + std::string(text), ## __VA_ARGS__); }
+    #define SP_LOG_WARNING(text, ...) { if (spartan::Log::IsEnabled(spartan::LogType::Warning)) spartan::Log::WriteFWarning(std::string(__FUNCTION__) + ": " + std::string(text), ## __VA_ARGS__); }
+    #define SP_LOG_ERROR(text, ...)   { if (spartan::Log::IsEnabled(spartan::LogType::Error))   spartan::Log::WriteFError(std::string(__FUNCTION__)   + ": " + std::string(text), ## __VA_ARGS__); }
 
     // Forward declarations
     class Entity;
@@ -71,10 +72,23 @@ namespace spartan
 
         // misc
         static void Initialize();
+        static void Shutdown();
         static void SetLogger(ILogger* logger);
         static void SetLogToFile(const bool log_to_file);
         static void Clear();
 
+        // messages from benchmark threads go to their own file, not to the log file or the logger, an empty path closes it
+        static void SetBenchmarkFile(const std::string& path);
+        static void SetBenchmarkThread(const bool is_benchmark);
+
+        // messages are written to the file and the logger by a background thread, this blocks until all queued ones are
+        static void Flush();
+
+        // level, messages below it are discarded before any formatting
+        static void SetLevel(const LogType level) { m_level = level; }
+        static LogType GetLevel()                 { return m_level; }
+        static bool IsEnabled(const LogType type) { return static_cast<uint32_t>(type) >= static_cast<uint32_t>(m_level); }
+
         // alpha
         static void Write(const char* text, const LogType type);
         static void WriteFInfo(const char* text, ...);
@@ -115,5 +129,8 @@ namespace spartan
         template<typename T> static void Write(std::shared_ptr<T> ptr, const LogType type) { Write(ptr ? typeid(ptr).name() : "Null", type); }
         static void Write(const std::weak_ptr<Entity>& entity, LogType type);
         static void Write(const std::shared_ptr<Entity>& entity, LogType type);
+
+    private:
+        static LogType m_level;
     };
 }
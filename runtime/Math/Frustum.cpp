@@ -89,6 +89,62 @@ namespace spartan::math
         return CheckCube(center, extent, ignore_depth) != Intersection::Outside;
     }
 
+    void Frustum::IsVisible(
+        const float* center_x, const float* center_y, const float* center_z,
+        const float* extent_x, const float* extent_y, const float* extent_z,
+        const uint32_t count, uint8_t* visible, bool ignore_depth /*= false*/
+    ) const
+    {
+        uint32_t i = 0;
+
+        #if defined(__AVX2__)
+        // the arithmetic mirrors CheckCube() operation for operation (no fma), so both paths agree bit for bit
+        const uint32_t plane_first = ignore_depth ? 2 : 0; // near and far are the first two planes
+        const __m256 sign_mask     = _mm256_set1_ps(-0.0f);
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 cx = _mm256_loadu_ps(center_x + i);
+            const __m256 cy = _mm256_loadu_ps(center_y + i);
+            const __m256 cz = _mm256_loadu_ps(center_z + i);
+            const __m256 ex = _mm256_loadu_ps(extent_x + i);
+            const __m256 ey = _mm256_loadu_ps(extent_y + i);
+            const __m256 ez = _mm256_loadu_ps(extent_z + i);
+
+            __m256 outside = _mm256_setzero_ps();
+            for (uint32_t p = plane_first; p < 6; p++)
+            {
+                const Plane& plane = m_planes[p];
+
+                const __m256 nx = _mm256_set1_ps(plane.normal.x);
+                const __m256 ny = _mm256_set1_ps(plane.normal.y);
+                const __m256 nz = _mm256_set1_ps(plane.normal.z);
+
+                __m256 d = _mm256_add_ps(_mm256_mul_ps(cx, nx), _mm256_mul_ps(cy, ny));
+                d        = _mm256_add_ps(d, _mm256_mul_ps(cz, nz));
+
+                __m256 r = _mm256_add_ps(_mm256_mul_ps(ex, _mm256_andnot_ps(sign_mask, nx)), _mm256_mul_ps(ey, _mm256_andnot_ps(sign_mask, ny)));
+                r        = _mm256_add_ps(r, _mm256_mul_ps(ez, _mm256_andnot_ps(sign_mask, nz)));
+
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), _mm256_set1_ps(-plane.d), _CMP_LT_OQ));
+            }
+
+            const int mask = _mm256_movemask_ps(outside);
+            for (uint32_t lane = 0; lane < 8; lane++)
+            {
+                visible[i + lane] = ((mask >> lane) & 1) ? 0 : 1;
+            }
+        }
+        #endif
+
+        // remainder (or everything, without avx2)
+        for (; i < count; i++)
+        {
+            const Vector3 center(center_x[i], center_y[i], center_z[i]);
+            const Vector3 extent(extent_x[i], extent_y[i], extent_z[i]);
+            visible[i] = IsVisible(center, extent, ignore_depth) ? 1 : 0;
+        }
+    }
+
     Intersection Frustum::CheckCube(const Vector3& center, const Vector3& extent, float ignore_depth /*= false*/) const
     {
         Intersection result = Intersection::Inside;
@@ -38,6 +38,14 @@ namespace spartan::math
 
         bool IsVisible(const Vector3& center, const Vector3& extent, bool ignore_depth = false) const;
 
+        // tests boxes laid out as a structure of arrays, eight at a time when avx2 is available
+        // writes 1 to visible[i] for boxes that are not outside, giving the same results as IsVisible()
+        void IsVisible(
+            const float* center_x, const float* center_y, const float* center_z,
+            const float* extent_x, const float* extent_y, const float* extent_z,
+            const uint32_t count, uint8_t* visible, bool ignore_depth = false
+        ) const;
+
     private:
         Intersection CheckCube(const Vector3& center, const Vector3& extent, float ignore_depth = false) const;
         Intersection CheckSphere(const Vector3& center, float radius, float ignore_depth = false) const;
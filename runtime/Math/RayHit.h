@@ -35,7 +35,8 @@ namespace spartan
         class RayHit
         {
         public:
-            RayHit(const std::shared_ptr<Entity>& entity, const Vector3& position, float distance, bool is_inside)
+            RayHit() = default;
+            RayHit(Entity* entity, const Vector3& position, float distance, bool is_inside)
             {
                 m_entity   = entity;
                 m_position = position;
@@ -43,10 +44,12 @@ namespace spartan
                 m_inside   = is_inside;
             };
 
-            std::shared_ptr<Entity> m_entity;
-            Vector3 m_position;
-            float m_distance;
-            bool m_inside;
+            Entity* m_entity          = nullptr;
+            Vector3 m_position        = Vector3::Zero;
+            float m_distance          = std::numeric_limits<float>::infinity();
+            bool m_inside             = false;
+            Vector3 m_normal          = Vector3::Zero; // triangle hits only
+            uint32_t m_instance_index = 0;             // triangle hits only
         };
     }
 }
@@ -26,8 +26,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Profiling/Profiler.h"
 #include "../Rendering/Renderer.h"
 #include "../Input/Input.h"
+#include "../World/Entity.h"
 #include "../World/Components/Camera.h"
 #include "../World/World.h"
+#include "../Core/ThreadPool.h"
+#include "../IO/FileStream.h"
+#include "../Resource/ResourceCache.h"
 SP_WARNINGS_OFF
 #ifdef DEBUG
     #define _DEBUG 1
@@ -51,8 +55,16 @@ namespace spartan
 {
     namespace settings
     {
-        float gravity = -9.81f; // gravity value in m/s^2
-        float hz      = 60.0f;  // simulation frequency in Hz
+        float gravity       = -9.81f; // gravity value in m/s^2
+        float hz            = 60.0f;  // simulation frequency in Hz
+        float worker_budget = 0.5f;   // fraction of the thread pool workers that the simulation can occupy at once
+        uint32_t max_steps  = 4;      // simulation steps per frame, time beyond that is dropped instead of spiralling into ever slower frames
+
+        // static body streaming, the gap between the two distances keeps bodies near the boundary from flickering in and out
+        float distance_activate   = 40.0f;  // static bodies closer than this enter the scene
+        float distance_deactivate = 80.0f;  // static bodies further than this leave the scene
+        float cell_size           = 32.0f;  // size of the grid cells which static bodies are bucketed in
+        uint32_t streaming_budget = 256;    // scene insertions and removals per frame, the closest bodies go first
     }
 
     class PhysXLogging : public physx::PxErrorCallback
@@ -76,6 +88,130 @@ namespace spartan
         }
     };
 
+    // runs physx tasks on the engine's thread pool, instead of physx spawning and spinning its own threads
+    // at most a budgeted number of tasks run at once, the rest wait here so that physics can't starve other jobs
+    class JobSystemDispatcher : public PxCpuDispatcher
+    {
+    public:
+        void submitTask(PxBaseTask& task) override
+        {
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_tasks_pending.push_back(&task);
+            }
+
+            Schedule();
+        }
+
+        uint32_t getWorkerCount() const override
+        {
+            return GetWorkerLimit();
+        }
+
+        // lets a waiting thread run a task itself, so the simulation progresses even when every worker is busy
+        bool RunPendingTask()
+        {
+            PxBaseTask* task = nullptr;
+            {
+                lock_guard<mutex> lock(m_mutex);
+                if (m_tasks_pending.empty())
+                    return false;
+
+                task = m_tasks_pending.front();
+                m_tasks_pending.pop_front();
+            }
+
+            Run(task);
+            return true;
+        }
+
+        uint32_t GetWorkerLimit() const
+        {
+            const float workers = static_cast<float>(ThreadPool::GetThreadCount()) * settings::worker_budget;
+            return max(static_cast<uint32_t>(workers + 0.5f), 1u);
+        }
+
+    private:
+        void Run(PxBaseTask* task)
+        {
+            {
+                ScopedTimeBlock time_block(task->getName());
+                task->run();
+            }
+            task->release();
+        }
+
+        void Schedule()
+        {
+            // take the tasks out under the lock but add the jobs after releasing it, since a full
+            // thread pool runs a job inline and that job locks again when it completes
+            vector<PxBaseTask*> tasks;
+            {
+                lock_guard<mutex> lock(m_mutex);
+
+                const uint32_t worker_limit = GetWorkerLimit();
+                while (!m_tasks_pending.empty() && m_tasks_running < worker_limit)
+                {
+                    tasks.push_back(m_tasks_pending.front());
+                    m_tasks_pending.pop_front();
+                    m_tasks_running++;
+                }
+            }
+
+            for (PxBaseTask* task : tasks)
+            {
+                ThreadPool::AddJob([this, task]()
+                {
+                    Run(task);
+
+                    {
+                        lock_guard<mutex> lock(m_mutex);
+                        m_tasks_running--;
+                    }
+
+                    Schedule();
+                });
+            }
+        }
+
+        mutex m_mutex;
+        deque<PxBaseTask*> m_tasks_pending;
+        uint32_t m_tasks_running = 0;
+    };
+
+    // runs once a step is done, so that the trace shows the step itself and not only its kick-off and the wait for it
+    class StepCompletionTask : public PxLightCpuTask
+    {
+    public:
+        void Begin(PxTaskManager& task_manager)
+        {
+            m_is_done.store(false, memory_order_relaxed);
+            m_time_start = chrono::steady_clock::now();
+            setContinuation(task_manager, nullptr);
+        }
+
+        void run() override
+        {
+            m_time_end = chrono::steady_clock::now();
+        }
+
+        void release() override
+        {
+            PxLightCpuTask::release();
+            m_is_done.store(true, memory_order_release);
+        }
+
+        const char* getName() const override { return "physics_step_completion"; }
+        bool IsDone() const                  { return m_is_done.load(memory_order_acquire); }
+        chrono::steady_clock::time_point GetTimeStart() const { return m_time_start; }
+        chrono::steady_clock::time_point GetTimeEnd() const   { return m_time_end; }
+
+    private:
+        atomic<bool> m_is_done = true;
+        chrono::steady_clock::time_point m_time_start;
+        chrono::steady_clock::time_point m_time_end;
+    };
+
     namespace
     {
         static PxDefaultAllocator allocator;
@@ -83,10 +219,466 @@ namespace spartan
         static PxFoundation* foundation           = nullptr;
         static PxPhysics* physics                 = nullptr;
         static PxScene* scene                     = nullptr;
-        static PxDefaultCpuDispatcher* dispatcher = nullptr;
+        static JobSystemDispatcher* dispatcher    = nullptr;
+        static StepCompletionTask step_completion;
         static PxRigidDynamic* picked_body        = nullptr;
         static PxReal pick_distance               = 0.0f;
         static PxVec3 pick_direction;
+
+        // stepping, the last step of a frame runs alongside rendering and is fetched at the start of the next frame
+        float accumulated_time     = 0.0f;
+        float interpolation        = 0.0f;
+        uint64_t step_count        = 0;
+        bool is_step_pending       = false; // a step is due, it's started by Simulate()
+        atomic<bool> is_simulating = false; // a step is running
+        mutex mutex_step;                   // world loading waits for steps from workers while the main thread ticks
+
+        float get_fixed_time_step()
+        {
+            return 1.0f / settings::hz;
+        }
+
+        void step_begin()
+        {
+            lock_guard<mutex> lock(mutex_step);
+
+            SP_PROFILE_CPU_START("physics_simulate");
+            step_completion.Begin(*scene->getTaskManager());
+            scene->simulate(get_fixed_time_step(), &step_completion);
+            step_completion.removeReference();
+            is_simulating.store(true, memory_order_release);
+            SP_PROFILE_CPU_END();
+        }
+
+        void step_end()
+        {
+            // one thread fetches the step, the others help with its tasks until it's fetched instead of blocking on the lock
+            unique_lock<mutex> lock(mutex_step, defer_lock);
+            while (!lock.try_lock())
+            {
+                if (!is_simulating.load(memory_order_acquire))
+                    return;
+
+                if (!dispatcher->RunPendingTask())
+                {
+                    this_thread::yield();
+                }
+            }
+
+            if (!is_simulating.load(memory_order_relaxed))
+                return;
+
+            SP_PROFILE_CPU_START("physics_fetch");
+
+            // help with the remaining work instead of blocking, the completion task is part of it as it's reused by the next step
+            while (!scene->checkResults(false) || !step_completion.IsDone())
+            {
+                if (!dispatcher->RunPendingTask())
+                {
+                    this_thread::yield();
+                }
+            }
+            scene->fetchResults(true);
+            Profiler::TimeBlockRecord("physics", "physics_step", step_completion.GetTimeStart(), step_completion.GetTimeEnd());
+
+            step_count++;
+            is_simulating.store(false, memory_order_release);
+
+            SP_PROFILE_CPU_END();
+        }
+
+        // dynamic poses before each of the last two steps that were started, rendering interpolates between them
+        // so it always trails the simulation by two steps, whether or not a frame starts one
+        unordered_map<PxRigidActor*, PxTransform> poses_from;
+        unordered_map<PxRigidActor*, PxTransform> poses_to;
+        vector<PxActor*> actors_dynamic;
+
+        void record_poses()
+        {
+            swap(poses_from, poses_to);
+            poses_to.clear();
+
+            PxU32 count = scene->getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+            actors_dynamic.resize(count);
+            scene->getActors(PxActorTypeFlag::eRIGID_DYNAMIC, actors_dynamic.data(), count);
+            for (PxActor* actor : actors_dynamic)
+            {
+                PxRigidActor* rigid_actor = static_cast<PxRigidActor*>(actor);
+                poses_to[rigid_actor]     = rigid_actor->getGlobalPose();
+            }
+        }
+
+        void clear_poses()
+        {
+            poses_from.clear();
+            poses_to.clear();
+        }
+    }
+
+    namespace cooked_meshes
+    {
+        mutex mutex_meshes;
+        unordered_map<uint64_t, PxBase*> meshes; // each entry holds a reference, bodies hold their own through their shapes
+
+        string get_file_path(const uint64_t key)
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+            return ResourceCache::GetCacheDirectory() + "physics/" + name + ".collision";
+        }
+
+        PxBase* create(PxInputStream& stream, const bool is_convex)
+        {
+            if (is_convex)
+                return physics->createConvexMesh(stream);
+
+            return physics->createTriangleMesh(stream);
+        }
+
+        void release_reference(PxBase* mesh)
+        {
+            if (PxConvexMesh* convex = mesh->is<PxConvexMesh>())
+            {
+                convex->release();
+            }
+            else if (PxTriangleMesh* triangle = mesh->is<PxTriangleMesh>())
+            {
+                triangle->release();
+            }
+        }
+
+        uint32_t get_reference_count(PxBase* mesh)
+        {
+            if (PxConvexMesh* convex = mesh->is<PxConvexMesh>())
+                return convex->getReferenceCount();
+
+            if (PxTriangleMesh* triangle = mesh->is<PxTriangleMesh>())
+                return triangle->getReferenceCount();
+
+            return 0;
+        }
+
+        // releases meshes which no body uses anymore
+        void trim()
+        {
+            lock_guard<mutex> lock(mutex_meshes);
+            for (auto it = meshes.begin(); it != meshes.end();)
+            {
+                if (get_reference_count(it->second) <= 1)
+                {
+                    release_reference(it->second);
+                    it = meshes.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        void clear()
+        {
+            lock_guard<mutex> lock(mutex_meshes);
+            for (auto& [key, mesh] : meshes)
+            {
+                release_reference(mesh);
+            }
+            meshes.clear();
+        }
+    }
+
+    namespace streaming
+    {
+        const int32_t cell_span_max = 8; // bodies spanning more cells than this on either axis are always evaluated
+
+        struct Body
+        {
+            PxRigidActor* actor = nullptr;
+            BoundingBox bounding_box;
+            int32_t cell_min_x  = 0;
+            int32_t cell_min_z  = 0;
+            int32_t cell_max_x  = 0;
+            int32_t cell_max_z  = 0;
+            bool is_large       = false;
+            uint32_t active     = UINT32_MAX; // index in the active list, if in the scene
+            uint64_t visit      = 0;          // last update that evaluated this body
+        };
+
+        mutex mutex_streaming;
+        vector<Body> bodies;
+        vector<uint32_t> bodies_free;
+        unordered_map<PxRigidActor*, uint32_t> body_indices;
+        unordered_map<uint64_t, vector<uint32_t>> cells;
+        vector<uint32_t> bodies_large;
+        vector<uint32_t> bodies_active;
+        uint64_t visit = 0;
+
+        int32_t to_cell(const float value)
+        {
+            return static_cast<int32_t>(floor(value / settings::cell_size));
+        }
+
+        uint64_t get_cell_key(const int32_t x, const int32_t z)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+        }
+
+        void erase(vector<uint32_t>& indices, const uint32_t index)
+        {
+            auto it = find(indices.begin(), indices.end(), index);
+            if (it != indices.end())
+            {
+                *it = indices.back();
+                indices.pop_back();
+            }
+        }
+
+        void set_active(const uint32_t index, const bool active)
+        {
+            Body& body = bodies[index];
+            if (active)
+            {
+                body.active = static_cast<uint32_t>(bodies_active.size());
+                bodies_active.push_back(index);
+            }
+            else
+            {
+                bodies[bodies_active.back()].active = body.active;
+                bodies_active[body.active]          = bodies_active.back();
+                bodies_active.pop_back();
+                body.active                         = UINT32_MAX;
+            }
+        }
+
+        // places a body in the cells its bounds overlap, or in the large list if it spans too many of them
+        void insert_cells(const uint32_t index, const BoundingBox& bounding_box)
+        {
+            Body& body        = bodies[index];
+            body.bounding_box = bounding_box;
+            body.cell_min_x   = to_cell(bounding_box.GetMin().x);
+            body.cell_min_z   = to_cell(bounding_box.GetMin().z);
+            body.cell_max_x   = to_cell(bounding_box.GetMax().x);
+            body.cell_max_z   = to_cell(bounding_box.GetMax().z);
+            body.is_large     = body.cell_max_x - body.cell_min_x >= cell_span_max || body.cell_max_z - body.cell_min_z >= cell_span_max;
+
+            if (body.is_large)
+            {
+                bodies_large.push_back(index);
+            }
+            else
+            {
+                for (int32_t z = body.cell_min_z; z <= body.cell_max_z; z++)
+                {
+                    for (int32_t x = body.cell_min_x; x <= body.cell_max_x; x++)
+                    {
+                        cells[get_cell_key(x, z)].push_back(index);
+                    }
+                }
+            }
+        }
+
+        void erase_cells(const uint32_t index)
+        {
+            Body& body = bodies[index];
+            if (body.is_large)
+            {
+                erase(bodies_large, index);
+            }
+            else
+            {
+                for (int32_t z = body.cell_min_z; z <= body.cell_max_z; z++)
+                {
+                    for (int32_t x = body.cell_min_x; x <= body.cell_max_x; x++)
+                    {
+                        auto cell = cells.find(get_cell_key(x, z));
+                        if (cell != cells.end())
+                        {
+                            erase(cell->second, index);
+                            if (cell->second.empty())
+                            {
+                                cells.erase(cell);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void add(PxRigidActor* actor, const BoundingBox& bounding_box)
+        {
+            lock_guard<mutex> lock(mutex_streaming);
+
+            uint32_t index = 0;
+            if (!bodies_free.empty())
+            {
+                index = bodies_free.back();
+                bodies_free.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(bodies.size());
+                bodies.emplace_back();
+            }
+
+            bodies[index]       = Body();
+            bodies[index].actor = actor;
+            body_indices[actor] = index;
+            insert_cells(index, bounding_box);
+
+            // the body stays out of the scene until the next update finds it close enough
+            if (actor->getScene())
+            {
+                set_active(index, true);
+            }
+        }
+
+        void remove(PxRigidActor* actor)
+        {
+            lock_guard<mutex> lock(mutex_streaming);
+
+            auto it = body_indices.find(actor);
+            if (it == body_indices.end())
+                return;
+
+            const uint32_t index = it->second;
+            body_indices.erase(it);
+            erase_cells(index);
+
+            Body& body = bodies[index];
+            if (body.active != UINT32_MAX)
+            {
+                set_active(index, false);
+            }
+
+            body.actor = nullptr;
+            bodies_free.push_back(index);
+        }
+
+        // moves a body to the cells of its new bounds, the next update streams it in or out accordingly
+        void set_bounding_box(PxRigidActor* actor, const BoundingBox& bounding_box)
+        {
+            lock_guard<mutex> lock(mutex_streaming);
+
+            auto it = body_indices.find(actor);
+            if (it == body_indices.end() || bodies[it->second].bounding_box == bounding_box)
+                return;
+
+            erase_cells(it->second);
+            insert_cells(it->second, bounding_box);
+        }
+
+        // called between steps, evaluates the active bodies and the cells around the camera, then applies the changes in two batches
+        void update()
+        {
+            Camera* camera = World::GetCamera();
+            if (!camera)
+                return;
+
+            SP_PROFILE_CPU();
+
+            lock_guard<mutex> lock(mutex_streaming);
+            visit++;
+
+            const Vector3 camera_position = camera->GetEntity()->GetPosition();
+            vector<pair<float, uint32_t>> to_add;
+            vector<uint32_t> to_remove;
+
+            auto evaluate = [&](const uint32_t index)
+            {
+                Body& body = bodies[index];
+                if (body.visit == visit)
+                    return;
+                body.visit = visit;
+
+                const float distance = Vector3::Distance(camera_position, body.bounding_box.GetClosestPoint(camera_position));
+                if (body.active == UINT32_MAX && distance <= settings::distance_activate)
+                {
+                    to_add.emplace_back(distance, index);
+                }
+                else if (body.active != UINT32_MAX && distance > settings::distance_deactivate)
+                {
+                    to_remove.push_back(index);
+                }
+            };
+
+            // active bodies, anything that has to leave is among them
+            for (const uint32_t index : bodies_active)
+            {
+                evaluate(index);
+            }
+
+            // cells within the activation distance, anything that has to enter is in them
+            const int32_t x_min = to_cell(camera_position.x - settings::distance_activate);
+            const int32_t x_max = to_cell(camera_position.x + settings::distance_activate);
+            const int32_t z_min = to_cell(camera_position.z - settings::distance_activate);
+            const int32_t z_max = to_cell(camera_position.z + settings::distance_activate);
+            for (int32_t z = z_min; z <= z_max; z++)
+            {
+                for (int32_t x = x_min; x <= x_max; x++)
+                {
+                    auto cell = cells.find(get_cell_key(x, z));
+                    if (cell != cells.end())
+                    {
+                        for (const uint32_t index : cell->second)
+                        {
+                            evaluate(index);
+                        }
+                    }
+                }
+            }
+
+            for (const uint32_t index : bodies_large)
+            {
+                evaluate(index);
+            }
+
+            // whatever exceeds the budget is picked up again by the next update, closest first
+            uint32_t budget = settings::streaming_budget;
+            if (to_add.size() > budget)
+            {
+                partial_sort(to_add.begin(), to_add.begin() + budget, to_add.end());
+                to_add.resize(budget);
+            }
+            budget -= static_cast<uint32_t>(to_add.size());
+            if (to_remove.size() > budget)
+            {
+                to_remove.resize(budget);
+            }
+
+            vector<PxActor*> actors;
+            actors.reserve(max(to_add.size(), to_remove.size()));
+            if (!to_remove.empty())
+            {
+                for (const uint32_t index : to_remove)
+                {
+                    actors.push_back(bodies[index].actor);
+                    set_active(index, false);
+                }
+                scene->removeActors(actors.data(), static_cast<PxU32>(actors.size()));
+            }
+
+            if (!to_add.empty())
+            {
+                actors.clear();
+                for (const auto& [distance, index] : to_add)
+                {
+                    actors.push_back(bodies[index].actor);
+                    set_active(index, true);
+                }
+                scene->addActors(actors.data(), static_cast<PxU32>(actors.size()));
+            }
+        }
+
+        void clear()
+        {
+            lock_guard<mutex> lock(mutex_streaming);
+            bodies.clear();
+            bodies_free.clear();
+            body_indices.clear();
+            cells.clear();
+            bodies_large.clear();
+            bodies_active.clear();
+        }
     }
 
     void PhysicsWorld::Initialize()
@@ -101,18 +693,18 @@ namespace spartan
         physics = PxCreatePhysics(PX_PHYSICS_VERSION, *foundation, PxTolerancesScale(), false, nullptr);
         SP_ASSERT(physics);
 
+        // dispatcher
+        dispatcher = new JobSystemDispatcher();
+
         // scene
         PxSceneDesc scene_desc(physics->getTolerancesScale());
         scene_desc.gravity        = PxVec3(0.0f, settings::gravity, 0.0f);
-        scene_desc.cpuDispatcher  = PxDefaultCpuDispatcherCreate(2);
+        scene_desc.cpuDispatcher  = dispatcher;
         scene_desc.filterShader   = PxDefaultSimulationFilterShader;
         scene_desc.flags         |= PxSceneFlag::eENABLE_CCD; // enable continuous collision detection to reduce tunneling
         scene = physics->createScene(scene_desc);
         SP_ASSERT(scene);
 
-        // store dispatcher
-        dispatcher = static_cast<PxDefaultCpuDispatcher*>(scene_desc.cpuDispatcher);
-
         // enable all debug visualization parameters
         scene->setVisualizationParameter(PxVisualizationParameter::eSCALE,               1.0f);
         scene->setVisualizationParameter(PxVisualizationParameter::eWORLD_AXES,          1.0f);
@@ -127,12 +719,21 @@ namespace spartan
         scene->setVisualizationParameter(PxVisualizationParameter::eCONTACT_FORCE,       1.0f);
         scene->setVisualizationParameter(PxVisualizationParameter::eJOINT_LOCAL_FRAMES,  1.0f);
         scene->setVisualizationParameter(PxVisualizationParameter::eJOINT_LIMITS,        1.0f);
+
+        // meshes that the previous world used are kept until the next clear, so reloading the same world doesn't even read the disk cache
+        SP_SUBSCRIBE_TO_EVENT(EventType::WorldClear, []([[maybe_unused]] sp_variant var) { cooked_meshes::trim(); });
     }
 
     void PhysicsWorld::Shutdown()
     {
+        step_end();
+        clear_poses();
+
         PX_RELEASE(scene);
-        PX_RELEASE(dispatcher);
+        streaming::clear();
+        cooked_meshes::clear();
+        delete dispatcher;
+        dispatcher = nullptr;
         PX_RELEASE(physics);
         PX_RELEASE(foundation);
     }
@@ -141,29 +742,18 @@ namespace spartan
     {
         SP_PROFILE_CPU();
 
+        // the step that ran alongside the previous frame
+        step_end();
+
         if (ProgressTracker::IsLoading())
             return;
 
+        // no step is running, so the scene can be changed
+        streaming::update();
+
         if (Engine::IsFlagSet(EngineMode::Playing))
         {
-            // simulation
-            {
-                const float  fixed_time_step  = 1.0f / settings::hz;
-                static float accumulated_time = 0.0f;
-
-                // accumulate delta time
-                accumulated_time += static_cast<float>(Timer::GetDeltaTimeSec());
-
-                // perform simulation steps
-                while (accumulated_time >= fixed_time_step)
-                {
-                    // simulate one fixed time step
-                    scene->simulate(fixed_time_step);
-                    scene->fetchResults(true); // block
-
-                    accumulated_time -= fixed_time_step;
-                }
-            }
+            Step(static_cast<float>(Timer::GetDeltaTimeSec()));
 
             // object picking
             {
@@ -179,24 +769,122 @@ namespace spartan
                 MovePickedBody();
             }
         }
-        else if (Renderer::GetOption<bool>(Renderer_Option::Physics))
+        else
         {
-            const PxRenderBuffer& rb = scene->getRenderBuffer(); // accessing while the simulation is running can result in undefined behavior
-            for (PxU32 i = 0; i < rb.getNbLines(); i++)
+            // bodies follow their entities while editing, older poses would pull them back once playing resumes
+            clear_poses();
+
+            if (Renderer::GetOption<bool>(Renderer_Option::Physics))
             {
-                const PxDebugLine& line = rb.getLines()[i];
-                Vector3 start(line.pos0.x, line.pos0.y, line.pos0.z);
-                Vector3 end(line.pos1.x, line.pos1.y, line.pos1.z);
-                Color color(
-                    ((line.color0 >> 16) & 0xFF) / 255.0f,
-                    ((line.color0 >> 8)  & 0xFF) / 255.0f,
-                     (line.color0        & 0xFF) / 255.0f
-                );
-                Renderer::DrawLine(start, end, color, color);
+                const PxRenderBuffer& rb = scene->getRenderBuffer(); // accessing while the simulation is running can result in undefined behavior
+                for (PxU32 i = 0; i < rb.getNbLines(); i++)
+                {
+                    const PxDebugLine& line = rb.getLines()[i];
+                    Vector3 start(line.pos0.x, line.pos0.y, line.pos0.z);
+                    Vector3 end(line.pos1.x, line.pos1.y, line.pos1.z);
+                    Color color(
+                        ((line.color0 >> 16) & 0xFF) / 255.0f,
+                        ((line.color0 >> 8)  & 0xFF) / 255.0f,
+                         (line.color0        & 0xFF) / 255.0f
+                    );
+                    Renderer::DrawLine(start, end, color, color);
+                }
             }
         }
     }
 
+    void PhysicsWorld::Step(const float delta_time)
+    {
+        const float fixed_time_step = get_fixed_time_step();
+        accumulated_time           += delta_time;
+
+        // cap the steps, a slow frame would otherwise cause even more steps and an even slower frame
+        uint32_t step_total = static_cast<uint32_t>(accumulated_time / fixed_time_step);
+        if (step_total > settings::max_steps)
+        {
+            step_total       = settings::max_steps;
+            accumulated_time = step_total * fixed_time_step;
+        }
+        accumulated_time -= step_total * fixed_time_step;
+
+        // catch up synchronously, except for the last step which overlaps with rendering
+        for (uint32_t i = 0; i < step_total; i++)
+        {
+            // rendering interpolates between the poses before the last two steps, this frame's step is the last one
+            if (i + 2 >= step_total)
+            {
+                record_poses();
+            }
+
+            if (i + 1 == step_total)
+                break;
+
+            step_begin();
+            step_end();
+        }
+        is_step_pending = step_total > 0;
+
+        // how far between the two rendered states the transforms are, the step that's due is already accounted for by the poses
+        interpolation = clamp(accumulated_time / fixed_time_step, 0.0f, 1.0f);
+    }
+
+    void PhysicsWorld::Simulate()
+    {
+        if (!is_step_pending)
+            return;
+
+        is_step_pending = false;
+
+        // a world load that started during this frame changes the scene from workers, a step can't run alongside it
+        if (ProgressTracker::IsLoading())
+            return;
+
+        step_begin();
+    }
+
+    void PhysicsWorld::WaitForSimulation()
+    {
+        step_end();
+    }
+
+    uint64_t PhysicsWorld::GetStepCount()
+    {
+        return step_count;
+    }
+
+    float PhysicsWorld::GetInterpolation()
+    {
+        return interpolation;
+    }
+
+    bool PhysicsWorld::GetPoseInterpolated(void* actor, Vector3& position, Quaternion& rotation)
+    {
+        PxRigidActor* rigid_actor = static_cast<PxRigidActor*>(actor);
+        auto it_to                = poses_to.find(rigid_actor);
+        if (it_to == poses_to.end())
+            return false;
+
+        // a body which was added a step ago has no earlier pose yet
+        auto it_from            = poses_from.find(rigid_actor);
+        const PxTransform& to   = it_to->second;
+        const PxTransform& from = it_from != poses_from.end() ? it_from->second : to;
+
+        position = Vector3::Lerp(Vector3(from.p.x, from.p.y, from.p.z), Vector3(to.p.x, to.p.y, to.p.z), interpolation);
+        rotation = Quaternion::Lerp(Quaternion(from.q.x, from.q.y, from.q.z, from.q.w), Quaternion(to.q.x, to.q.y, to.q.z, to.q.w), interpolation);
+
+        return true;
+    }
+
+    uint32_t PhysicsWorld::GetMaxSteps()
+    {
+        return settings::max_steps;
+    }
+
+    void PhysicsWorld::SetMaxSteps(const uint32_t steps)
+    {
+        settings::max_steps = max(steps, 1u);
+    }
+
     Vector3 PhysicsWorld::GetGravity()
     {
         PxVec3 g = scene->getGravity();
@@ -213,6 +901,16 @@ namespace spartan
         return static_cast<void*>(physics);
     }
 
+    float PhysicsWorld::GetWorkerBudget()
+    {
+        return settings::worker_budget;
+    }
+
+    void PhysicsWorld::SetWorkerBudget(const float fraction)
+    {
+        settings::worker_budget = clamp(fraction, 0.0f, 1.0f);
+    }
+
     void PhysicsWorld::PickBody()
     {
         // get camera
@@ -264,4 +962,97 @@ namespace spartan
         PxVec3 target = origin + direction * pick_distance;
         picked_body->setGlobalPose(PxTransform(target));
     }
+
+    void PhysicsWorld::AddStaticBody(void* actor, const BoundingBox& bounding_box)
+    {
+        streaming::add(static_cast<PxRigidActor*>(actor), bounding_box);
+    }
+
+    void PhysicsWorld::RemoveStaticBody(void* actor)
+    {
+        streaming::remove(static_cast<PxRigidActor*>(actor));
+    }
+
+    void PhysicsWorld::UpdateStaticBody(void* actor, const BoundingBox& bounding_box)
+    {
+        streaming::set_bounding_box(static_cast<PxRigidActor*>(actor), bounding_box);
+    }
+
+    void* PhysicsWorld::GetCookedMesh(const uint64_t key, const bool is_convex, const function<bool(void* stream)>& cook)
+    {
+        // memory
+        {
+            lock_guard<mutex> lock(cooked_meshes::mutex_meshes);
+            auto it = cooked_meshes::meshes.find(key);
+            if (it != cooked_meshes::meshes.end())
+                return it->second;
+        }
+
+        // disk
+        PxBase* mesh           = nullptr;
+        const string file_path = cooked_meshes::get_file_path(key);
+        if (FileSystem::IsFile(file_path))
+        {
+            FileStream file(file_path, FileStream_Read);
+            if (file.IsOpen())
+            {
+                span<const byte> bytes = file.ViewBytes(file.GetSize());
+                PxDefaultMemoryInputData input(const_cast<PxU8*>(reinterpret_cast<const PxU8*>(bytes.data())), static_cast<PxU32>(bytes.size()));
+                mesh = cooked_meshes::create(input, is_convex);
+            }
+
+            if (!mesh)
+            {
+                SP_LOG_WARNING("Failed to load cooked collision \"%s\", it will be cooked again", file_path.c_str());
+            }
+        }
+
+        // cook
+        PxDefaultMemoryOutputStream output;
+        if (!mesh)
+        {
+            if (!cook(&output))
+                return nullptr;
+
+            PxDefaultMemoryInputData input(output.getData(), output.getSize());
+            mesh = cooked_meshes::create(input, is_convex);
+            if (!mesh)
+                return nullptr;
+        }
+
+        // another thread may have created the same mesh in the meantime, keep whichever came first
+        {
+            lock_guard<mutex> lock(cooked_meshes::mutex_meshes);
+            auto [it, inserted] = cooked_meshes::meshes.emplace(key, mesh);
+            if (!inserted)
+            {
+                cooked_meshes::release_reference(mesh);
+                return it->second;
+            }
+        }
+
+        // persist, through a temporary file so that an interrupted write never leaves a truncated entry behind
+        if (output.getSize() != 0)
+        {
+            FileSystem::CreateDirectory_(FileSystem::GetDirectoryFromFilePath(file_path));
+            const string file_path_temp = file_path + ".tmp";
+            bool is_written             = false;
+            {
+                FileStream file(file_path_temp, FileStream_Write);
+                if (file.IsOpen())
+                {
+                    file.WriteBytes(output.getData(), output.getSize());
+                    file.Close();
+                    is_written = true;
+                }
+            }
+
+            if (!is_written || !FileSystem::Rename(file_path_temp, file_path))
+            {
+                FileSystem::Delete(file_path_temp);
+            }
+        }
+
+        return mesh;
+    }
 }
@@ -21,10 +21,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES ===============
+//= INCLUDES ===================
 #include <vector>
+#include <functional>
 #include "../Math/Vector3.h"
-//==========================
+#include "../Math/Quaternion.h"
+#include "../Math/BoundingBox.h"
+//==============================
 
 namespace spartan
 {
@@ -33,12 +36,37 @@ namespace spartan
     public:
         static void Initialize();
         static void Shutdown();
-        static void Tick();
+        static void Tick();     // fetches the step which ran during the previous frame, and catches up if needed
+        static void Simulate(); // starts this frame's step, it runs alongside rendering
+        static void Step(const float delta_time); // advances the simulation by a frame's time, Tick() calls it while playing, Simulate() starts the last step
+
+        // waits for a running step, required before reading or writing actors and before creating or releasing bodies
+        static void WaitForSimulation();
+
+        // stepping
+        static uint64_t GetStepCount();
+        static float GetInterpolation(); // [0, 1] between the two rendered states
+        static bool GetPoseInterpolated(void* actor, math::Vector3& position, math::Quaternion& rotation); // rendered pose of a dynamic actor, two steps behind the simulation
+        static uint32_t GetMaxSteps();
+        static void SetMaxSteps(const uint32_t steps);
 
         static math::Vector3 GetGravity();
         static void* GetScene();
         static void* GetPhysics();
 
+        // fraction of the thread pool that the simulation can occupy at once, at least one worker is always used
+        static float GetWorkerBudget();
+        static void SetWorkerBudget(const float fraction);
+
+        // static bodies with bounds are streamed in and out of the scene by their distance to the camera
+        static void AddStaticBody(void* actor, const math::BoundingBox& bounding_box);
+        static void RemoveStaticBody(void* actor);
+        static void UpdateStaticBody(void* actor, const math::BoundingBox& bounding_box); // call when a registered body moves
+
+        // cooked collision meshes, shared between bodies and persisted in the cache directory
+        // the key has to cover everything that affects the cooked result, cook() writes into a PxOutputStream and only runs on a miss
+        static void* GetCookedMesh(const uint64_t key, const bool is_convex, const std::function<bool(void* stream)>& cook);
+
     private:
         // picking
         static void PickBody();
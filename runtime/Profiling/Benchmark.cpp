@@ -0,0 +1,121 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "pch.h"
+#include "Benchmark.h"
+#include "Benchmarks/Benchmarks.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace spartan
+{
+    namespace
+    {
+        mutex mutex_cases;
+        vector<pair<string, function<void(BenchmarkCase&)>>> cases;
+
+        void register_engine_cases()
+        {
+            static bool registered = false;
+            if (registered)
+                return;
+
+            benchmarks::register_thread_pool();
+            benchmarks::register_resource_cache();
+            benchmarks::register_renderer();
+            benchmarks::register_renderable();
+            benchmarks::register_log();
+            benchmarks::register_terrain();
+            benchmarks::register_spatial_index();
+            benchmarks::register_texture();
+            benchmarks::register_file_stream();
+            benchmarks::register_physics();
+            registered = true;
+        }
+    }
+
+    void Benchmark::Register(const char* name, function<void(BenchmarkCase& result)>&& function)
+    {
+        lock_guard<mutex> lock(mutex_cases);
+        cases.emplace_back(name, move(function));
+    }
+
+    bool Benchmark::Run()
+    {
+        register_engine_cases();
+
+        vector<pair<string, function<void(BenchmarkCase&)>>> cases_to_run;
+        {
+            lock_guard<mutex> lock(mutex_cases);
+            cases_to_run = cases;
+        }
+
+        ofstream file("benchmark_cases.txt");
+        bool all_passed = true;
+        for (auto& [name, function] : cases_to_run)
+        {
+            BenchmarkCase result;
+            function(result);
+            all_passed = all_passed && result.passed;
+
+            const double speedup = (result.time_reference_ms > 0.0 && result.time_ms > 0.0) ? result.time_reference_ms / result.time_ms : 0.0;
+            if (result.passed)
+            {
+                SP_LOG_INFO("Benchmark case %s: %.3f ms, reference %.3f ms (%.2fx) %s", name.c_str(), result.time_ms, result.time_reference_ms, speedup, result.note.c_str());
+            }
+            else
+            {
+                SP_LOG_ERROR("Benchmark case %s failed: %.3f ms, reference %.3f ms %s", name.c_str(), result.time_ms, result.time_reference_ms, result.note.c_str());
+            }
+
+            if (file.is_open())
+            {
+                file << name << ": time_ms " << result.time_ms << ", reference_ms " << result.time_reference_ms << ", speedup " << speedup;
+                file << ", " << (result.passed ? "passed" : "failed");
+                if (!result.note.empty())
+                {
+                    file << ", " << result.note;
+                }
+                file << "\n";
+            }
+        }
+
+        return all_passed;
+    }
+
+    double Benchmark::Time(const function<void()>& function, const uint32_t runs /*= 3*/)
+    {
+        double time_best = numeric_limits<double>::max();
+        for (uint32_t i = 0; i < max(runs, 1u); i++)
+        {
+            const auto start = chrono::high_resolution_clock::now();
+            function();
+            const chrono::duration<double, milli> elapsed = chrono::high_resolution_clock::now() - start;
+            time_best = min(time_best, elapsed.count());
+        }
+
+        return time_best;
+    }
+}
@@ -0,0 +1,53 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ========
+#include <functional>
+#include <string>
+//===================
+
+namespace spartan
+{
+    struct BenchmarkCase
+    {
+        double time_ms           = 0.0;
+        double time_reference_ms = 0.0;  // what the engine's implementation is compared against, 0 if nothing
+        bool passed              = true; // false if the outputs of the two disagree, or a check failed
+        std::string note;                // optional detail for the report
+    };
+
+    // micro benchmarks and equivalence checks of individual systems, they run in -benchmark and -ci_test mode, before a world loads
+    // a case times the engine's implementation against a reference on the same input (usually what it replaced) and checks that both agree
+    class Benchmark
+    {
+    public:
+        // the engine's own cases live in Profiling/Benchmarks and are registered by Run(), anything else can add its own
+        static void Register(const char* name, std::function<void(BenchmarkCase& result)>&& function);
+
+        // runs every case, logs the results and writes them to benchmark_cases.txt, returns false if any case failed
+        static bool Run();
+
+        // best of a few runs, in milliseconds
+        static double Time(const std::function<void()>& function, const uint32_t runs = 3);
+    };
+}
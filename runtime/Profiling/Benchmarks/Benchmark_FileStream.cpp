@@ -0,0 +1,122 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =================
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+#include "../../IO/FileStream.h"
+//============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace spartan
+{
+    namespace
+    {
+        const char* file_name           = "file_stream_benchmark.bin";
+        const char* file_name_reference = "file_stream_benchmark_reference.bin";
+        const uint32_t value_count      = 4 * 1024 * 1024;
+
+        vector<float> make_values()
+        {
+            vector<float> values(value_count);
+            for (uint32_t i = 0; i < value_count; i++)
+            {
+                values[i] = static_cast<float>(i) * 0.25f - 1000.0f;
+            }
+
+            return values;
+        }
+
+        vector<char> read_file(const char* path)
+        {
+            ifstream file_in(path, ios::binary);
+            return vector<char>(istreambuf_iterator<char>(file_in), istreambuf_iterator<char>());
+        }
+
+        // a large buffer is written one scalar at a time and read back, through the file stream
+        // and through the iostream path it replaced, which did one stream call per scalar
+        void run_round_trip(BenchmarkCase& result)
+        {
+            const vector<float> values = make_values();
+            vector<float> values_read(value_count);
+            vector<float> values_read_reference(value_count);
+
+            result.time_ms = Benchmark::Time([&]()
+            {
+                {
+                    FileStream file(file_name, FileStream_Write);
+                    for (const float value : values)
+                    {
+                        file.Write(value);
+                    }
+                }
+
+                {
+                    FileStream file(file_name, FileStream_Read);
+                    for (float& value : values_read)
+                    {
+                        file.Read(&value);
+                    }
+                }
+            });
+
+            result.time_reference_ms = Benchmark::Time([&]()
+            {
+                {
+                    ofstream out(file_name_reference, ios::binary | ios::out);
+                    for (float value : values)
+                    {
+                        out.write(reinterpret_cast<char*>(&value), sizeof(value));
+                    }
+                }
+
+                {
+                    ifstream in(file_name_reference, ios::binary | ios::in);
+                    for (float& value : values_read_reference)
+                    {
+                        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+                    }
+                }
+            });
+
+            const bool bytes_match = read_file(file_name) == read_file(file_name_reference);
+            const bool values_match =
+                memcmp(values_read.data(), values.data(), values.size() * sizeof(float)) == 0 &&
+                memcmp(values_read_reference.data(), values.data(), values.size() * sizeof(float)) == 0;
+            FileSystem::Delete(file_name);
+            FileSystem::Delete(file_name_reference);
+
+            result.passed = bytes_match && values_match;
+            result.note   = to_string(value_count) + " floats written and read one at a time, " +
+                            (bytes_match ? "files identical" : "files differ") + ", " +
+                            (values_match ? "values identical" : "values differ");
+        }
+    }
+
+    void benchmarks::register_file_stream()
+    {
+        Benchmark::Register("file_stream_round_trip", run_round_trip);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ============
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+//=======================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace spartan
+{
+    namespace
+    {
+        const char* file_name           = "log_benchmark.txt";
+        const char* file_name_reference = "log_benchmark_reference.txt";
+
+        // the logger which the queue and the writer thread replaced, a global lock, a stream formatted timestamp,
+        // an unbounded history and a file which is opened and closed for every message
+        void write_reference(const char* text, const LogType type)
+        {
+            static mutex log_mutex;
+            static vector<LogCmd> logs;
+            lock_guard<mutex> guard(log_mutex);
+
+            auto t = time(nullptr);
+            tm tm_struct{};
+            localtime_s(&tm_struct, &t);
+
+            ostringstream oss;
+            oss << put_time(&tm_struct, "[%H:%M:%S]");
+            const string final_text = oss.str() + ": " + string(text);
+            logs.emplace_back(final_text, type);
+
+            ofstream fout;
+            fout.open(file_name_reference, ofstream::out | ofstream::app);
+            if (fout.is_open())
+            {
+                fout << (type == LogType::Info ? "Info: " : type == LogType::Warning ? "Warning: " : "Error: ") << final_text << endl;
+                fout.close();
+            }
+        }
+
+        uint32_t count_lines(const char* path)
+        {
+            ifstream file_in(path);
+            return static_cast<uint32_t>(count(istreambuf_iterator<char>(file_in), istreambuf_iterator<char>(), '\n'));
+        }
+
+        // a few threads log formatted messages at the same time, timed until every message is in the file
+        void run_throughput(BenchmarkCase& result)
+        {
+            const uint32_t thread_count        = 4;
+            const uint32_t messages_per_thread = 5000;
+            const uint32_t message_count       = thread_count * messages_per_thread;
+            const LogType level                = Log::GetLevel();
+            Log::SetLevel(LogType::Info);
+
+            auto produce = [](const function<void(uint32_t, uint32_t)>& log)
+            {
+                vector<thread> threads;
+                for (uint32_t t = 0; t < thread_count; t++)
+                {
+                    threads.emplace_back([&log, t]()
+                    {
+                        Log::SetBenchmarkThread(true);
+                        for (uint32_t i = 0; i < messages_per_thread; i++)
+                        {
+                            log(t, i);
+                        }
+                    });
+                }
+
+                for (thread& thread : threads)
+                {
+                    thread.join();
+                }
+            };
+
+            // the writer thread is the only one that touches the file while it's open, the flush orders both sides
+            Log::SetBenchmarkFile(file_name);
+            result.time_ms = Benchmark::Time([&]()
+            {
+                produce([](uint32_t thread_index, uint32_t i) { Log::WriteFInfo("benchmark message %u from thread %u", i, thread_index); });
+                Log::Flush();
+            }, 1);
+            Log::SetBenchmarkFile("");
+
+            ofstream(file_name_reference, ofstream::out | ofstream::trunc).close();
+            result.time_reference_ms = Benchmark::Time([&]()
+            {
+                produce([](uint32_t thread_index, uint32_t i)
+                {
+                    char buffer[1024];
+                    snprintf(buffer, sizeof(buffer), "benchmark message %u from thread %u", i, thread_index);
+                    write_reference(buffer, LogType::Info);
+                });
+            }, 1);
+
+            Log::SetLevel(level);
+
+            const uint32_t lines           = count_lines(file_name);
+            const uint32_t lines_reference = count_lines(file_name_reference);
+            FileSystem::Delete(file_name);
+            FileSystem::Delete(file_name_reference);
+
+            result.passed = lines == message_count && lines_reference == message_count;
+            result.note   = to_string(message_count) + " messages from " + to_string(thread_count) + " threads, " + to_string(lines) + " written";
+        }
+    }
+
+    void benchmarks::register_log()
+    {
+        Benchmark::Register("log_throughput", run_throughput);
+    }
+}
@@ -0,0 +1,128 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===================
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+#include "../../Physics/PhysicsWorld.h"
+SP_WARNINGS_OFF
+#ifdef DEBUG
+    #define _DEBUG 1
+    #undef NDEBUG
+#else
+    #define NDEBUG 1
+    #undef _DEBUG
+#endif
+#define PX_PHYSX_STATIC_LIB
+#include <physx/PxPhysicsAPI.h>
+SP_WARNINGS_ON
+//==============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+using namespace physx;
+//============================
+
+namespace spartan
+{
+    namespace
+    {
+        // a body moving at a constant velocity is stepped through frames both faster and slower than the simulation
+        // the rendered positions have to keep increasing and trail the simulation by the same amount every frame
+        void run_interpolation(BenchmarkCase& result)
+        {
+            const float velocity       = 1.0f;
+            const uint32_t frame_count = 600;
+            const float frame_times[]  = { 1.0f / 144.0f, 1.0f / 240.0f, 1.0f / 90.0f, 1.0f / 60.0f, 1.0f / 45.0f, 1.0f / 30.0f, 1.0f / 165.0f };
+
+            PxPhysics* physics = static_cast<PxPhysics*>(PhysicsWorld::GetPhysics());
+            PxScene* scene     = static_cast<PxScene*>(PhysicsWorld::GetScene());
+
+            PhysicsWorld::WaitForSimulation();
+            PxMaterial* material = physics->createMaterial(0.0f, 0.0f, 0.0f);
+            PxRigidDynamic* body = PxCreateDynamic(*physics, PxTransform(PxVec3(0.0f, 1000.0f, 0.0f)), PxSphereGeometry(0.5f), *material, 1.0f);
+            body->setActorFlag(PxActorFlag::eDISABLE_GRAVITY, true);
+            body->setLinearDamping(0.0f);
+            body->setSleepThreshold(0.0f);
+            body->setLinearVelocity(PxVec3(velocity, 0.0f, 0.0f));
+            scene->addActor(*body);
+
+            // the first frames have no pose history yet, after that every frame has to move the body forward
+            const uint32_t frame_warm_up = 16;
+            uint32_t backward_count      = 0;
+            float position_previous      = -numeric_limits<float>::max();
+            float time                   = 0.0f;
+            float lag_min                = numeric_limits<float>::max();
+            float lag_max                = 0.0f;
+
+            result.time_ms = Benchmark::Time([&]()
+            {
+                for (uint32_t frame = 0; frame < frame_count; frame++)
+                {
+                    // the order of a frame, see Engine::Tick
+                    PhysicsWorld::WaitForSimulation();
+                    const float frame_time = frame_times[frame % size(frame_times)];
+                    time += frame_time;
+                    PhysicsWorld::Step(frame_time);
+
+                    Vector3 position;
+                    Quaternion rotation;
+                    if (!PhysicsWorld::GetPoseInterpolated(body, position, rotation))
+                    {
+                        position = Vector3(body->getGlobalPose().p.x, 0.0f, 0.0f);
+                    }
+
+                    if (frame >= frame_warm_up)
+                    {
+                        backward_count += position.x <= position_previous ? 1 : 0;
+
+                        const float lag = time - position.x / velocity;
+                        lag_min         = min(lag_min, lag);
+                        lag_max         = max(lag_max, lag);
+                    }
+                    position_previous = position.x;
+
+                    PhysicsWorld::Simulate();
+                }
+                PhysicsWorld::WaitForSimulation();
+            }, 1);
+
+            scene->removeActor(*body);
+            body->release();
+            material->release();
+
+            // a lag which alternates between frames shows up as a spread, float accumulation over the run stays well below it
+            const float lag_spread = lag_max - lag_min;
+            result.passed          = backward_count == 0 && lag_spread < 0.001f;
+
+            char note[256];
+            snprintf(note, sizeof(note), "%u frames, %u not moving forward, lag %.2f to %.2f ms", frame_count, backward_count, lag_min * 1000.0f, lag_max * 1000.0f);
+            result.note = note;
+        }
+    }
+
+    void benchmarks::register_physics()
+    {
+        Benchmark::Register("physics_interpolation", run_interpolation);
+    }
+}
@@ -0,0 +1,106 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ====================================
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+#include "../../World/Entity.h"
+#include "../../World/Components/Renderable.h"
+//===============================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+namespace spartan
+{
+    namespace
+    {
+        // what every renderable used to carry, three arrays with an element per possible entity, instanced or not
+        const uint64_t state_size_reference = sizeof(array<float, renderer_max_entities>) + sizeof(array<bool, renderer_max_entities>) + sizeof(array<uint32_t, renderer_max_entities>);
+
+        // a synthetic scene of plain renderables and instanced ones whose instances land in an 8x8 grid of cells (one instance group each),
+        // reports the distance, visibility and lod state that they hold against the fixed arrays they replaced, the time is that of creating them
+        void run_visibility_memory(BenchmarkCase& result)
+        {
+            const uint32_t renderable_count           = 10000;
+            const uint32_t renderable_instanced_count = 100;
+            const uint32_t grid_size                  = 8;
+            const float cell_size                     = 300.0f; // see grid_partitioning in Renderable.cpp
+
+            vector<Matrix> instances;
+            for (uint32_t z = 0; z < grid_size; z++)
+            {
+                for (uint32_t x = 0; x < grid_size; x++)
+                {
+                    instances.emplace_back(Matrix::CreateTranslation(Vector3((x + 0.5f) * cell_size, 0.0f, (z + 0.5f) * cell_size)));
+                }
+            }
+
+            vector<shared_ptr<Entity>> entities;
+            vector<shared_ptr<Renderable>> renderables;
+            entities.reserve(renderable_count + renderable_instanced_count);
+            renderables.reserve(renderable_count + renderable_instanced_count);
+            result.time_ms = Benchmark::Time([&]()
+            {
+                for (uint32_t i = 0; i < renderable_count + renderable_instanced_count; i++)
+                {
+                    entities.emplace_back(make_shared<Entity>());
+                    renderables.emplace_back(make_shared<Renderable>(entities.back().get()));
+                    if (i >= renderable_count)
+                    {
+                        renderables.back()->SetInstances(instances);
+                    }
+                }
+            }, 1);
+
+            uint64_t state_size  = 0;
+            uint32_t group_count = 0;
+            bool groups_match    = true;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(renderables.size()); i++)
+            {
+                const Renderable* renderable = renderables[i].get();
+                state_size                  += renderable->GetVisibilityStateSize();
+                group_count                 += max(renderable->GetInstanceGroupCount(), 1u);
+                groups_match                 = groups_match && renderable->GetInstanceGroupCount() == (i >= renderable_count ? grid_size * grid_size : 0);
+            }
+            const uint64_t state_size_old = state_size_reference * renderables.size();
+
+            renderables.clear();
+            entities.clear();
+
+            char note[192];
+            snprintf(note, sizeof(note), "%u renderables (%u instanced), %u instance groups, %.2f MB instead of %.2f MB (%.1f bytes per group)",
+                renderable_count + renderable_instanced_count, renderable_instanced_count, group_count,
+                static_cast<double>(state_size) / (1024.0 * 1024.0), static_cast<double>(state_size_old) / (1024.0 * 1024.0),
+                static_cast<double>(state_size) / group_count);
+            result.passed = groups_match && state_size < state_size_old;
+            result.note   = note;
+        }
+    }
+
+    void benchmarks::register_renderable()
+    {
+        Benchmark::Register("renderable_visibility_memory", run_visibility_memory);
+    }
+}
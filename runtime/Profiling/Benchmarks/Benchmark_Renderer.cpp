@@ -0,0 +1,188 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ====================================
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+#include "../../Rendering/Renderer_Definitions.h"
+#include "../../Math/Frustum.h"
+//===============================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+namespace spartan
+{
+    namespace
+    {
+        // what the comparator of the std::sort which the radix sort replaced had to chase a pointer for
+        struct MaterialSynthetic
+        {
+            bool transparent;
+            uint64_t id;
+        };
+
+        struct DrawCallReference
+        {
+            const MaterialSynthetic* material;
+            float distance_squared;
+        };
+
+        // sorts a synthetic draw list with the radix sort, and with the old comparator based std::sort as the reference,
+        // material slots are handed out in id order so that both have to produce the same sequence
+        void run_sort(BenchmarkCase& result)
+        {
+            const uint32_t draw_call_count = 20000;
+            const uint32_t material_count  = 512;
+            mt19937 generator(0);
+
+            vector<MaterialSynthetic> materials(material_count);
+            for (MaterialSynthetic& material : materials)
+            {
+                material.transparent = generator() % 8 == 0;
+                material.id          = (static_cast<uint64_t>(generator()) << 32) | generator();
+            }
+            sort(materials.begin(), materials.end(), [](const MaterialSynthetic& a, const MaterialSynthetic& b) { return a.id < b.id; });
+
+            vector<Renderer_DrawCall> draw_calls(draw_call_count);
+            vector<DrawCallReference> draw_calls_reference(draw_call_count);
+            uniform_real_distribution<float> distribution(0.0f, 1000.0f * 1000.0f);
+            for (uint32_t i = 0; i < draw_call_count; i++)
+            {
+                const uint32_t material_index = generator() % material_count;
+                const float distance_squared  = distribution(generator);
+
+                draw_calls[i]                  = {};
+                draw_calls[i].distance_squared = distance_squared;
+                draw_calls[i].sort_key         = draw_call_sorting::compute_key(materials[material_index].transparent, material_index, distance_squared);
+                draw_calls_reference[i]        = { &materials[material_index], distance_squared };
+            }
+
+            vector<Renderer_DrawCall> draw_calls_sorted;
+            result.time_ms = Benchmark::Time([&]()
+            {
+                draw_calls_sorted = draw_calls;
+                draw_call_sorting::sort(draw_calls_sorted.data(), draw_call_count);
+            });
+
+            vector<DrawCallReference> draw_calls_reference_sorted;
+            result.time_reference_ms = Benchmark::Time([&]()
+            {
+                draw_calls_reference_sorted = draw_calls_reference;
+                std::sort(draw_calls_reference_sorted.begin(), draw_calls_reference_sorted.end(), [](const DrawCallReference& a, const DrawCallReference& b)
+                {
+                    if (a.material->transparent != b.material->transparent)
+                        return !a.material->transparent;
+
+                    if (a.material->id != b.material->id)
+                        return a.material->id < b.material->id;
+
+                    return a.material->transparent ? a.distance_squared > b.distance_squared : a.distance_squared < b.distance_squared;
+                });
+            });
+
+            // equal keys can be in any order, so the keys are compared rather than the draw calls
+            uint32_t mismatches = 0;
+            for (uint32_t i = 0; i < draw_call_count; i++)
+            {
+                const DrawCallReference& reference = draw_calls_reference_sorted[i];
+                const uint32_t material_index      = static_cast<uint32_t>(reference.material - materials.data());
+                mismatches += draw_calls_sorted[i].sort_key != draw_call_sorting::compute_key(reference.material->transparent, material_index, reference.distance_squared);
+            }
+
+            result.passed = mismatches == 0;
+            result.note   = to_string(draw_call_count) + " draw calls, " + to_string(material_count) + " materials";
+        }
+
+        // tests random boxes around a camera with the structure of arrays path (avx2 where available) and one box at a time as the reference,
+        // with and without depth, both have to agree on every box
+        void run_frustum(BenchmarkCase& result)
+        {
+            const uint32_t box_count = 100000;
+            const float near_plane   = 0.1f;
+            const float far_plane    = 1000.0f;
+            const Matrix view        = Matrix::CreateLookAtLH(Vector3(0.0f, 2.0f, 0.0f), Vector3(1.0f, 2.0f, 1.0f), Vector3::Up);
+            const Matrix projection  = Matrix::CreatePerspectiveFieldOfViewLH(1.57f, 16.0f / 9.0f, far_plane, near_plane); // reverse-z, like the camera
+            const Frustum frustum(view, projection, near_plane);
+
+            mt19937 generator(0);
+            uniform_real_distribution<float> distribution_position(-far_plane * 1.2f, far_plane * 1.2f);
+            uniform_real_distribution<float> distribution_extent(0.01f, 50.0f);
+            array<vector<float>, 6> boxes; // center xyz, extent xyz
+            for (vector<float>& component : boxes)
+            {
+                component.resize(box_count);
+            }
+            for (uint32_t i = 0; i < box_count; i++)
+            {
+                for (uint32_t axis = 0; axis < 3; axis++)
+                {
+                    boxes[axis][i]     = distribution_position(generator);
+                    boxes[axis + 3][i] = distribution_extent(generator);
+                }
+            }
+
+            vector<uint8_t> visible(box_count);
+            vector<uint8_t> visible_reference(box_count);
+            uint32_t mismatches    = 0;
+            uint32_t visible_count = 0;
+            for (const bool ignore_depth : { false, true })
+            {
+                const double time = Benchmark::Time([&]()
+                {
+                    frustum.IsVisible(boxes[0].data(), boxes[1].data(), boxes[2].data(), boxes[3].data(), boxes[4].data(), boxes[5].data(), box_count, visible.data(), ignore_depth);
+                });
+
+                const double time_reference = Benchmark::Time([&]()
+                {
+                    for (uint32_t i = 0; i < box_count; i++)
+                    {
+                        const Vector3 center(boxes[0][i], boxes[1][i], boxes[2][i]);
+                        const Vector3 extent(boxes[3][i], boxes[4][i], boxes[5][i]);
+                        visible_reference[i] = frustum.IsVisible(center, extent, ignore_depth) ? 1 : 0;
+                    }
+                });
+
+                for (uint32_t i = 0; i < box_count; i++)
+                {
+                    mismatches    += visible[i] != visible_reference[i];
+                    visible_count += visible[i];
+                }
+
+                result.time_ms           += time;
+                result.time_reference_ms += time_reference;
+            }
+
+            // a frustum that rejects or accepts everything would agree with itself without testing anything
+            result.passed = mismatches == 0 && visible_count != 0 && visible_count != box_count * 2;
+            result.note   = to_string(box_count) + " boxes x 2 (with and without depth), " + to_string(visible_count) + " visible, " + to_string(mismatches) + " mismatches";
+        }
+    }
+
+    void benchmarks::register_renderer()
+    {
+        Benchmark::Register("renderer_draw_call_sort",  run_sort);
+        Benchmark::Register("renderer_frustum_culling", run_frustum);
+    }
+}
@@ -0,0 +1,134 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ============================
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+#include "../../Resource/ResourceCache.h"
+//=======================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace spartan
+{
+    namespace
+    {
+        // a resource with nothing but a path and a name, so that only the cache is measured
+        class ResourceSynthetic : public IResource
+        {
+        public:
+            ResourceSynthetic() : IResource(ResourceType::Unknown) { }
+        };
+
+        // loads synthetic resources through the cache the way a level load does (cache, then look up by path and by name), then removes them
+        // the reference is the linear scan over a single vector which the indices replaced
+        void run_load(BenchmarkCase& result)
+        {
+            const uint32_t resource_count = 50000;
+            vector<shared_ptr<IResource>> resources;
+            resources.reserve(resource_count);
+            for (uint32_t i = 0; i < resource_count; i++)
+            {
+                shared_ptr<IResource> resource = make_shared<ResourceSynthetic>();
+                resource->SetResourceFilePath("benchmark/resource_" + to_string(i) + ".synthetic");
+                resources.emplace_back(resource);
+            }
+
+            const uint32_t count_before = ResourceCache::GetResourceCount();
+            uint32_t mismatches         = 0;
+            uint32_t count_loaded       = 0;
+
+            result.time_ms = Benchmark::Time([&]()
+            {
+                for (const shared_ptr<IResource>& resource : resources)
+                {
+                    mismatches += ResourceCache::Cache(resource) != resource;
+                }
+                count_loaded = ResourceCache::GetResourceCount();
+
+                for (const shared_ptr<IResource>& resource : resources)
+                {
+                    mismatches += ResourceCache::GetByPath(resource->GetResourceFilePath()) != resource;
+                    mismatches += ResourceCache::GetByName(resource->GetObjectName(), ResourceType::Unknown) != resource;
+                }
+
+                for (const shared_ptr<IResource>& resource : resources)
+                {
+                    ResourceCache::Remove(resource.get());
+                }
+            });
+
+            // the reference is quadratic, so only every n-th resource pays for the scans (against all of them) and the time is scaled up
+            const uint32_t stride    = 16;
+            result.time_reference_ms = stride * Benchmark::Time([&]()
+            {
+                vector<shared_ptr<IResource>> resources_reference;
+                auto find = [&resources_reference](auto matches) -> shared_ptr<IResource>
+                {
+                    for (const shared_ptr<IResource>& resource : resources_reference)
+                    {
+                        if (matches(resource.get()))
+                            return resource;
+                    }
+
+                    return nullptr;
+                };
+
+                for (uint32_t i = 0; i < resource_count; i++)
+                {
+                    const string& path = resources[i]->GetResourceFilePath();
+                    if (i % stride != 0 || !find([&path](const IResource* cached) { return cached->GetResourceFilePath() == path; }))
+                    {
+                        resources_reference.emplace_back(resources[i]);
+                    }
+                }
+
+                for (uint32_t i = 0; i < resource_count; i += stride)
+                {
+                    const string& path = resources[i]->GetResourceFilePath();
+                    const string& name = resources[i]->GetObjectName();
+                    mismatches += find([&path](const IResource* cached) { return cached->GetResourceFilePath() == path; }) != resources[i];
+                    mismatches += find([&name](const IResource* cached) { return cached->GetObjectName() == name; }) != resources[i];
+                }
+
+                for (uint32_t i = 0; i < resource_count; i += stride)
+                {
+                    const uint64_t id = resources[i]->GetObjectId();
+                    resources_reference.erase(find_if(resources_reference.begin(), resources_reference.end(), [id](const shared_ptr<IResource>& cached) { return cached->GetObjectId() == id; }));
+
+                    // the rest of the stride goes at once, so that the vector shrinks like it would if they had been removed one by one
+                    resources_reference.erase(resources_reference.begin(), resources_reference.begin() + min<size_t>(stride - 1, resources_reference.size()));
+                }
+            }, 1);
+
+            result.passed = mismatches == 0 && count_loaded == count_before + resource_count && ResourceCache::GetResourceCount() == count_before;
+            result.note   = to_string(resource_count) + " resources, " + to_string(mismatches) + " mismatches";
+        }
+    }
+
+    void benchmarks::register_resource_cache()
+    {
+        Benchmark::Register("resource_cache_load", run_load);
+    }
+}
@@ -0,0 +1,167 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+#include "../../World/Entity.h"
+#include "../../World/SpatialIndex.h"
+#include "../../Math/Frustum.h"
+#include "../../Math/Ray.h"
+//======================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+namespace spartan
+{
+    namespace
+    {
+        // the same query against the exact boxes, index results are refined with it like callers do (leaves are enlarged)
+        using Overlaps = function<bool(const BoundingBox&)>;
+
+        // scatters boxes at a constant density, so the number of results per query stays about the same at every size,
+        // and runs box, sphere, frustum and ray queries through the index and through a scan of every box (what the world had before it),
+        // both have to return the same entities
+        void run_queries(BenchmarkCase& result, const uint32_t entity_count)
+        {
+            const uint32_t query_count = 64; // of each kind
+            const float world_size     = 10.0f * cbrt(static_cast<float>(entity_count)); // one entity per 1000 cubic units
+            mt19937 generator(entity_count);
+            uniform_real_distribution<float> distribution_position(0.0f, world_size);
+            uniform_real_distribution<float> distribution_extent(0.25f, 2.0f);
+            uniform_real_distribution<float> distribution_direction(-1.0f, 1.0f);
+
+            vector<Entity> entities(entity_count); // the index only stores the pointers, the offset gives the box back
+            vector<BoundingBox> boxes(entity_count);
+            for (BoundingBox& box : boxes)
+            {
+                const Vector3 center(distribution_position(generator), distribution_position(generator), distribution_position(generator));
+                const Vector3 extent(distribution_extent(generator), distribution_extent(generator), distribution_extent(generator));
+                box = BoundingBox(center - extent, center + extent);
+            }
+
+            SpatialIndex index;
+            const double time_build = Benchmark::Time([&]()
+            {
+                index.Clear();
+                for (uint32_t i = 0; i < entity_count; i++)
+                {
+                    index.Insert(&entities[i], boxes[i]);
+                }
+            }, 1);
+
+            // queries
+            vector<function<void(vector<Entity*>&)>> queries_index;
+            vector<Overlaps> queries_exact;
+            for (uint32_t i = 0; i < query_count; i++)
+            {
+                const Vector3 center(distribution_position(generator), distribution_position(generator), distribution_position(generator));
+                const Vector3 direction = Vector3(distribution_direction(generator), distribution_direction(generator), distribution_direction(generator)).Normalized();
+
+                const BoundingBox box(center - Vector3(10.0f), center + Vector3(10.0f));
+                queries_index.emplace_back([&index, box](vector<Entity*>& out) { index.QueryBox(box, out); });
+                queries_exact.emplace_back([box](const BoundingBox& exact) { return exact.Intersects(box) != Intersection::Outside; });
+
+                const float radius = 12.0f;
+                queries_index.emplace_back([&index, center, radius](vector<Entity*>& out) { index.QuerySphere(center, radius, out); });
+                queries_exact.emplace_back([center, radius](const BoundingBox& exact) { return Vector3::DistanceSquared(center, exact.GetClosestPoint(center)) <= radius * radius; });
+
+                // bounded in depth like a spot light's, a camera's reaches the whole world
+                const float near_plane  = 0.1f;
+                const float far_plane   = 30.0f;
+                const Matrix view       = Matrix::CreateLookAtLH(center, center + direction, abs(direction.y) > 0.99f ? Vector3::Forward : Vector3::Up);
+                const Matrix projection = Matrix::CreatePerspectiveFieldOfViewLH(1.0f, 1.0f, near_plane, far_plane);
+                const Frustum frustum(view, projection, far_plane);
+                queries_index.emplace_back([&index, frustum](vector<Entity*>& out) { index.QueryFrustum(frustum, out); });
+                queries_exact.emplace_back([frustum](const BoundingBox& exact) { return frustum.IsVisible(exact.GetCenter(), exact.GetExtents()); });
+
+                const Ray ray(center, direction);
+                queries_index.emplace_back([&index, ray](vector<Entity*>& out) { index.QueryRay(ray, out); });
+                queries_exact.emplace_back([ray](const BoundingBox& exact) { return ray.HitDistance(exact) != numeric_limits<float>::infinity(); });
+            }
+
+            const uint32_t query_total = static_cast<uint32_t>(queries_index.size());
+            vector<vector<uint32_t>> results(query_total);
+            vector<vector<uint32_t>> results_reference(query_total);
+
+            vector<Entity*> candidates;
+            result.time_ms = Benchmark::Time([&]()
+            {
+                for (uint32_t q = 0; q < query_total; q++)
+                {
+                    candidates.clear();
+                    results[q].clear();
+                    queries_index[q](candidates);
+                    for (Entity* entity : candidates)
+                    {
+                        const uint32_t i = static_cast<uint32_t>(entity - entities.data());
+                        if (queries_exact[q](boxes[i]))
+                        {
+                            results[q].push_back(i);
+                        }
+                    }
+                }
+            });
+
+            result.time_reference_ms = Benchmark::Time([&]()
+            {
+                for (uint32_t q = 0; q < query_total; q++)
+                {
+                    results_reference[q].clear();
+                    for (uint32_t i = 0; i < entity_count; i++)
+                    {
+                        if (queries_exact[q](boxes[i]))
+                        {
+                            results_reference[q].push_back(i);
+                        }
+                    }
+                }
+            });
+
+            // the scan returns entities in order, the index in tree order
+            uint32_t mismatches = 0;
+            uint64_t hit_count  = 0;
+            for (uint32_t q = 0; q < query_total; q++)
+            {
+                sort(results[q].begin(), results[q].end());
+                mismatches += results[q] != results_reference[q];
+                hit_count  += results_reference[q].size();
+            }
+
+            char note[160];
+            snprintf(note, sizeof(note), "%u entities, %u queries, %.1f results per query, tree height %u, built in %.1f ms, %u mismatching queries",
+                entity_count, query_total, static_cast<double>(hit_count) / query_total, index.GetHeight(), time_build, mismatches);
+            result.passed = mismatches == 0 && hit_count != 0;
+            result.note   = note;
+        }
+    }
+
+    void benchmarks::register_spatial_index()
+    {
+        Benchmark::Register("spatial_index_1k",   [](BenchmarkCase& result) { run_queries(result, 1'000);   });
+        Benchmark::Register("spatial_index_10k",  [](BenchmarkCase& result) { run_queries(result, 10'000);  });
+        Benchmark::Register("spatial_index_100k", [](BenchmarkCase& result) { run_queries(result, 100'000); });
+    }
+}
@@ -0,0 +1,101 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============================
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+#include "../../World/Components/Terrain.h"
+//=========================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+namespace spartan
+{
+    namespace
+    {
+        uint64_t hash_heights(const vector<Vector3>& positions)
+        {
+            uint64_t hash = 0;
+            for (const Vector3& position : positions)
+            {
+                hash = FileSystem::HashBytes(&position.y, sizeof(position.y), hash);
+            }
+
+            return hash;
+        }
+
+        // erodes the same synthetic height map twice in parallel and once on the calling thread,
+        // all three have to produce the same heights, the serial run is the reference
+        void run_erosion(BenchmarkCase& result)
+        {
+            const uint32_t width         = 512;
+            const uint32_t height        = 512;
+            const uint32_t iterations    = 1'000'000; // what terrain generation uses
+            const uint32_t wind_interval = 50'000;
+
+            vector<Vector3> positions_source(width * height);
+            for (uint32_t z = 0; z < height; z++)
+            {
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    const float fx = static_cast<float>(x);
+                    const float fz = static_cast<float>(z);
+                    const float y  = 100.0f * sin(fx * 0.02f) * cos(fz * 0.03f) + 20.0f * sin(fx * 0.11f + fz * 0.07f);
+                    positions_source[z * width + x] = Vector3(fx, y, fz);
+                }
+            }
+
+            array<uint64_t, 3> hashes = {};
+            for (uint32_t run = 0; run < 3; run++)
+            {
+                const bool parallel       = run != 2;
+                vector<Vector3> positions = positions_source;
+                const double time         = Benchmark::Time([&]()
+                {
+                    Terrain::Erode(positions, width, height, iterations, wind_interval, parallel);
+                }, 1);
+
+                hashes[run] = hash_heights(positions);
+                if (parallel)
+                {
+                    result.time_ms = run == 0 ? time : min(result.time_ms, time);
+                }
+                else
+                {
+                    result.time_reference_ms = time;
+                }
+            }
+
+            // the erosion has to have done something, otherwise equal hashes prove nothing
+            result.passed = hashes[0] == hashes[1] && hashes[0] == hashes[2] && hashes[0] != hash_heights(positions_source);
+            result.note   = to_string(width) + "x" + to_string(height) + ", " + to_string(iterations) + " droplets, hash " + to_string(hashes[0]);
+        }
+    }
+
+    void benchmarks::register_terrain()
+    {
+        Benchmark::Register("terrain_erosion", run_erosion);
+    }
+}
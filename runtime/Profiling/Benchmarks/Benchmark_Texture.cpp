@@ -0,0 +1,255 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ================================
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+#include "../../RHI/RHI_Texture.h"
+#include "../../RHI/RHI_Texture_Processing.h"
+//===========================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace spartan
+{
+    namespace
+    {
+        // the compression which the strips replaced, a whole level per call, with the compressonator's own threads
+        void compress_level_reference(const vector<byte>& source, vector<byte>& destination, const uint32_t width, const uint32_t height)
+        {
+            CMP_Texture source_texture = {};
+            source_texture.format      = compressonator::to_cmp_format(RHI_Format::R8G8B8A8_Unorm);
+            source_texture.dwSize      = sizeof(CMP_Texture);
+            source_texture.dwWidth     = width;
+            source_texture.dwHeight    = height;
+            source_texture.dwPitch     = width * 4;
+            source_texture.dwDataSize  = static_cast<uint32_t>(source.size());
+            source_texture.pData       = reinterpret_cast<uint8_t*>(const_cast<byte*>(source.data()));
+
+            CMP_Texture destination_texture = {};
+            destination_texture.format      = compressonator::to_cmp_format(compressonator::destination_format);
+            destination_texture.dwSize      = sizeof(CMP_Texture);
+            destination_texture.dwWidth     = width;
+            destination_texture.dwHeight    = height;
+            destination_texture.dwDataSize  = CMP_CalculateBufferSize(&destination_texture);
+            destination.assign(destination_texture.dwDataSize, byte(0));
+            destination_texture.pData       = reinterpret_cast<uint8_t*>(destination.data());
+
+            CMP_CompressOptions options    = compressonator::get_options();
+            options.bDisableMultiThreading = false;
+            options.dwnumThreads           = ThreadPool::GetIdleThreadCount();
+
+            SP_ASSERT(CMP_ConvertTexture(&source_texture, &destination_texture, &options, nullptr) == CMP_OK);
+        }
+
+        // compresses synthetic levels as strips, all of them at once like compress() does, and one level at a time as the reference,
+        // the sizes cover strips that split evenly, a partial last strip, heights and widths that aren't a multiple of the block size,
+        // levels narrower than a block and a level that fits in a single strip, every byte has to match
+        void run_compress(BenchmarkCase& result)
+        {
+            const array<pair<uint32_t, uint32_t>, 7> sizes =
+            {{
+                { 2048, 2048 }, // 64 strips of 8 block rows
+                { 1000, 600  }, // 16 block rows per strip, the last one has 6
+                { 1366, 770  }, // neither side a multiple of 4, partial last strip and partial last block row
+                { 256,  1    },
+                { 3,    5    },
+                { 1,    1    },
+                { 128,  128  }  // a single strip
+            }};
+
+            vector<vector<byte>> sources(sizes.size());
+            uint64_t texel_count = 0;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(sizes.size()); i++)
+            {
+                const auto [width, height] = sizes[i];
+                texel_count               += static_cast<uint64_t>(width) * height;
+                sources[i].resize(static_cast<size_t>(width) * height * 4);
+                for (uint32_t y = 0; y < height; y++)
+                {
+                    for (uint32_t x = 0; x < width; x++)
+                    {
+                        for (uint32_t c = 0; c < 4; c++)
+                        {
+                            sources[i][(static_cast<size_t>(y) * width + x) * 4 + c] = static_cast<byte>((x * 5 + y * 11 + c * 67 + ((x ^ y) & 0x1F) * 3) & 0xFF);
+                        }
+                    }
+                }
+            }
+
+            const CMP_CompressOptions options = compressonator::get_options();
+            vector<vector<byte>> destinations(sizes.size());
+            result.time_ms = Benchmark::Time([&]()
+            {
+                vector<JobHandle> jobs;
+                for (uint32_t i = 0; i < static_cast<uint32_t>(sizes.size()); i++)
+                {
+                    const auto [width, height] = sizes[i];
+                    destinations[i].assign(compressonator::get_level_size(width, height), byte(0));
+                    compressonator::add_level_jobs(sources[i].data(), destinations[i].data(), width, height, RHI_Format::R8G8B8A8_Unorm, 4, options, jobs);
+                }
+                ThreadPool::Wait(jobs);
+            }, 1);
+
+            vector<vector<byte>> destinations_reference(sizes.size());
+            result.time_reference_ms = Benchmark::Time([&]()
+            {
+                for (uint32_t i = 0; i < static_cast<uint32_t>(sizes.size()); i++)
+                {
+                    compress_level_reference(sources[i], destinations_reference[i], sizes[i].first, sizes[i].second);
+                }
+            }, 1);
+
+            uint32_t mismatches = 0;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(sizes.size()); i++)
+            {
+                mismatches += destinations[i] != destinations_reference[i];
+            }
+
+            const double megapixels = static_cast<double>(texel_count) / 1'000'000.0;
+            char note[128];
+            snprintf(note, sizeof(note), "%.2f MP in %u levels, %.1f MP/s, %u mismatching levels", megapixels, static_cast<uint32_t>(sizes.size()), megapixels / (max(result.time_ms, 0.001) / 1000.0), mismatches);
+            result.passed = mismatches == 0;
+            result.note   = note;
+        }
+
+        // the mip generator which this one replaced, one byte at a time, gamma space, rgba8 only, on the calling thread
+        void downsample_reference(const vector<byte>& input, vector<byte>& output, uint32_t width, uint32_t height)
+        {
+            const uint32_t channels   = 4;
+            const uint32_t new_width  = max(1u, width  >> 1);
+            const uint32_t new_height = max(1u, height >> 1);
+
+            for (uint32_t y = 0; y < new_height; y++)
+            {
+                for (uint32_t x = 0; x < new_width; x++)
+                {
+                    uint32_t src_idx              = (y * 2 * width + x * 2) * channels;
+                    uint32_t src_idx_right        = src_idx + channels;
+                    uint32_t src_idx_bottom       = src_idx + (width * channels);
+                    uint32_t src_idx_bottom_right = src_idx + (width * channels) + channels;
+                    uint32_t dst_idx              = (y * new_width + x) * channels;
+
+                    for (uint32_t c = 0; c < channels; c++)
+                    {
+                        uint32_t sum   = to_integer<uint32_t>(input[src_idx + c]);
+                        uint32_t count = 1;
+
+                        if (x * 2 + 1 < width)
+                        {
+                            sum += to_integer<uint32_t>(input[src_idx_right + c]);
+                            count++;
+                        }
+
+                        if (y * 2 + 1 < height)
+                        {
+                            sum += to_integer<uint32_t>(input[src_idx_bottom + c]);
+                            count++;
+                        }
+
+                        if ((x * 2 + 1 < width) && (y * 2 + 1 < height))
+                        {
+                            sum += to_integer<uint32_t>(input[src_idx_bottom_right + c]);
+                            count++;
+                        }
+
+                        output[dst_idx + c] = byte(sum / count);
+                    }
+                }
+            }
+        }
+
+        // the whole chain of a square rgba8 texture, the way RHI_Texture::PrepareForGpu() generates it
+        using Downsample = function<void(const vector<byte>&, vector<byte>&, uint32_t, uint32_t)>;
+        void generate_chain(vector<vector<byte>>& chain, const uint32_t size, const Downsample& downsample)
+        {
+            const uint32_t mip_count = mips::compute_count(size, size);
+            chain.resize(max(mip_count, 1u));
+            for (uint32_t mip_index = 1; mip_index < mip_count; mip_index++)
+            {
+                const uint32_t size_output = max(1u, size >> mip_index);
+                chain[mip_index].resize(static_cast<size_t>(size_output) * size_output * 4);
+                downsample(chain[mip_index - 1], chain[mip_index], max(1u, size >> (mip_index - 1)), max(1u, size >> (mip_index - 1)));
+            }
+        }
+
+        // times the box filter against the old path on the same texture, every level has to be within rounding of what
+        // the old path makes out of the same larger level (it truncated, this rounds), the srgb and kaiser chains are timed for reference
+        void run_size(BenchmarkCase& result, const uint32_t size)
+        {
+            vector<vector<byte>> chain(1);
+            chain[0].resize(static_cast<size_t>(size) * size * 4);
+            for (uint32_t y = 0; y < size; y++)
+            {
+                for (uint32_t x = 0; x < size; x++)
+                {
+                    for (uint32_t c = 0; c < 4; c++)
+                    {
+                        chain[0][(static_cast<size_t>(y) * size + x) * 4 + c] = static_cast<byte>((x * 7 + y * 13 + c * 31 + ((x * y) >> 5)) & 0xFF);
+                    }
+                }
+            }
+
+            auto downsample_with = [](const RHI_Format format, const bool srgb, const mips::Filter filter) -> Downsample
+            {
+                return [format, srgb, filter](const vector<byte>& input, vector<byte>& output, uint32_t width, uint32_t height)
+                {
+                    mips::downsample(input, output, width, height, format, srgb, filter);
+                };
+            };
+
+            vector<vector<byte>> chain_reference = { chain[0] };
+            result.time_ms                       = Benchmark::Time([&]() { generate_chain(chain, size, downsample_with(RHI_Format::R8G8B8A8_Unorm, false, mips::Filter::Box)); }, 1);
+            result.time_reference_ms             = Benchmark::Time([&]() { generate_chain(chain_reference, size, downsample_reference); }, 1);
+
+            uint32_t difference_max = 0;
+            vector<byte> level_reference;
+            for (uint32_t mip_index = 1; mip_index < static_cast<uint32_t>(chain.size()); mip_index++)
+            {
+                level_reference.resize(chain[mip_index].size());
+                downsample_reference(chain[mip_index - 1], level_reference, size >> (mip_index - 1), size >> (mip_index - 1));
+                for (size_t i = 0; i < level_reference.size(); i++)
+                {
+                    difference_max = max(difference_max, static_cast<uint32_t>(abs(to_integer<int32_t>(chain[mip_index][i]) - to_integer<int32_t>(level_reference[i]))));
+                }
+            }
+            chain_reference.clear();
+
+            const double time_srgb   = Benchmark::Time([&]() { generate_chain(chain, size, downsample_with(RHI_Format::R8G8B8A8_Unorm, true, mips::Filter::Box)); }, 1);
+            const double time_kaiser = Benchmark::Time([&]() { generate_chain(chain, size, downsample_with(RHI_Format::R8G8B8A8_Unorm, true, mips::Filter::Kaiser)); }, 1);
+
+            char note[128];
+            snprintf(note, sizeof(note), "%ux%u rgba8, max difference %u, srgb box %.1f ms, srgb kaiser %.1f ms", size, size, difference_max, time_srgb, time_kaiser);
+            result.passed = difference_max <= 1;
+            result.note   = note;
+        }
+    }
+
+    void benchmarks::register_texture()
+    {
+        Benchmark::Register("texture_mips_4k",            [](BenchmarkCase& result) { run_size(result, 4096); });
+        Benchmark::Register("texture_mips_8k",            [](BenchmarkCase& result) { run_size(result, 8192); });
+        Benchmark::Register("texture_compression_strips", run_compress);
+    }
+}
@@ -0,0 +1,248 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "pch.h"
+#include "Benchmarks.h"
+#include "../Benchmark.h"
+#include "../../Core/ThreadPool.h"
+//=========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace spartan
+{
+    namespace
+    {
+        // the single mutex pool which the work stealing one replaced, one shared queue guarded by a lock and a condition variable
+        class ThreadPoolReference
+        {
+        public:
+            ThreadPoolReference(const uint32_t count)
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    m_threads.emplace_back([this]() { loop(); });
+                }
+            }
+
+            ~ThreadPoolReference()
+            {
+                {
+                    lock_guard<mutex> lock(m_mutex);
+                    m_is_stopping = true;
+                }
+                m_condition.notify_all();
+
+                for (thread& thread : m_threads)
+                {
+                    thread.join();
+                }
+            }
+
+            future<void> AddTask(Task&& task)
+            {
+                auto task_packaged = make_shared<packaged_task<void()>>(move(task));
+                future<void> result = task_packaged->get_future();
+                {
+                    lock_guard<mutex> lock(m_mutex);
+                    m_tasks.emplace_back([task_packaged]() { (*task_packaged)(); });
+                }
+                m_condition.notify_one();
+
+                return result;
+            }
+
+        private:
+            void loop()
+            {
+                while (true)
+                {
+                    unique_lock<mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this] { return !m_tasks.empty() || m_is_stopping; });
+                    if (m_is_stopping && m_tasks.empty())
+                        return;
+
+                    Task task = move(m_tasks.front());
+                    m_tasks.pop_front();
+                    lock.unlock();
+
+                    task();
+                }
+            }
+
+            vector<thread> m_threads;
+            deque<Task> m_tasks;
+            mutex m_mutex;
+            condition_variable m_condition;
+            bool m_is_stopping = false;
+        };
+
+        // a few hundred nanoseconds of work, small enough for scheduling to dominate
+        uint64_t work(const uint32_t index)
+        {
+            uint64_t value = index;
+            for (uint32_t i = 0; i < 64; i++)
+            {
+                value = value * 6364136223846793005ull + 1442695040888963407ull;
+            }
+
+            return value;
+        }
+
+        // many small independent tasks through AddTask() on both pools, each has to run exactly once
+        void run_tasks(BenchmarkCase& result)
+        {
+            const uint32_t thread_count = ThreadPool::GetThreadCount();
+            const uint32_t task_count   = 50000;
+            vector<uint64_t> values(task_count, 0);
+            vector<uint64_t> values_reference(task_count, 0);
+            atomic<uint32_t> executions = 0;
+            vector<future<void>> futures;
+            futures.reserve(task_count);
+
+            {
+                ThreadPoolReference pool(thread_count);
+                result.time_reference_ms = Benchmark::Time([&]()
+                {
+                    futures.clear();
+                    for (uint32_t i = 0; i < task_count; i++)
+                    {
+                        futures.emplace_back(pool.AddTask([&values_reference, i]() { values_reference[i] = work(i); }));
+                    }
+
+                    for (future<void>& task_future : futures)
+                    {
+                        task_future.wait();
+                    }
+                });
+            }
+
+            result.time_ms = Benchmark::Time([&]()
+            {
+                executions = 0;
+                futures.clear();
+                for (uint32_t i = 0; i < task_count; i++)
+                {
+                    futures.emplace_back(ThreadPool::AddTask([&values, &executions, i]() { values[i] = work(i); executions.fetch_add(1); }));
+                }
+
+                for (future<void>& task_future : futures)
+                {
+                    task_future.wait();
+                }
+            });
+
+            result.passed = executions == task_count && values == values_reference;
+            result.note   = to_string(task_count) + " tasks";
+        }
+
+        // a loop split across the pool, the reference splits it the way the old pool's ParallelLoop did, one range per idle thread
+        void run_parallel_loop(BenchmarkCase& result)
+        {
+            const uint32_t thread_count = ThreadPool::GetThreadCount();
+            const uint32_t work_total   = 1 << 20;
+            vector<uint64_t> values(work_total, 0);
+            vector<uint64_t> values_reference(work_total, 0);
+
+            {
+                ThreadPoolReference pool(thread_count);
+                result.time_reference_ms = Benchmark::Time([&]()
+                {
+                    const uint32_t work_per_thread = (work_total + thread_count - 1) / thread_count;
+                    atomic<uint32_t> work_done     = 0;
+                    for (uint32_t start = 0; start < work_total; start += work_per_thread)
+                    {
+                        const uint32_t end = min(start + work_per_thread, work_total);
+                        pool.AddTask([&values_reference, &work_done, start, end]()
+                        {
+                            for (uint32_t i = start; i < end; i++)
+                            {
+                                values_reference[i] = work(i);
+                            }
+                            work_done.fetch_add(end - start);
+                        });
+                    }
+
+                    while (work_done.load() != work_total)
+                    {
+                        this_thread::yield();
+                    }
+                });
+            }
+
+            result.time_ms = Benchmark::Time([&]()
+            {
+                ThreadPool::ParallelLoop([&values](uint32_t start, uint32_t end)
+                {
+                    for (uint32_t i = start; i < end; i++)
+                    {
+                        values[i] = work(i);
+                    }
+                }, work_total);
+            });
+
+            result.passed = values == values_reference;
+            result.note   = to_string(work_total) + " items";
+        }
+
+        // workers add more jobs than their deque and the shared queue hold together, without waiting in between,
+        // so the queues fill up with nobody draining them, the adds have to run what doesn't fit instead of waiting for space
+        void run_saturation(BenchmarkCase& result)
+        {
+            const uint32_t producer_count    = ThreadPool::GetThreadCount();
+            const uint32_t jobs_per_producer = 8192;
+            atomic<uint32_t> executions      = 0;
+
+            result.time_ms = Benchmark::Time([&]()
+            {
+                executions = 0;
+                vector<JobHandle> producers;
+                for (uint32_t i = 0; i < producer_count; i++)
+                {
+                    producers.emplace_back(ThreadPool::AddJob([&executions, jobs_per_producer]()
+                    {
+                        vector<JobHandle> jobs;
+                        jobs.reserve(jobs_per_producer);
+                        for (uint32_t j = 0; j < jobs_per_producer; j++)
+                        {
+                            jobs.emplace_back(ThreadPool::AddJob([&executions]() { executions.fetch_add(1); }));
+                        }
+                        ThreadPool::Wait(jobs);
+                    }));
+                }
+                ThreadPool::Wait(producers);
+            }, 1);
+
+            result.passed = executions == producer_count * jobs_per_producer;
+            result.note   = to_string(producer_count) + " producers x " + to_string(jobs_per_producer) + " jobs, " + to_string(executions.load()) + " executed";
+        }
+    }
+
+    void benchmarks::register_thread_pool()
+    {
+        Benchmark::Register("thread_pool_tasks",         run_tasks);
+        Benchmark::Register("thread_pool_parallel_loop", run_parallel_loop);
+        Benchmark::Register("thread_pool_saturation",    run_saturation);
+    }
+}
@@ -29,6 +29,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/Debugging.h"
 #include "../Rendering/Renderer.h"
 #include "../Display/Display.h"
+#include "../IO/FileStream.h"
 //====================================
 
 //= NAMESPACES =====
@@ -106,6 +107,7 @@ namespace spartan
         string cpu_name           = "N/A";
         bool poll                 = false;
         bool allow_time_block_end = true;
+        thread::id main_thread_id;
 
         string get_cpu_name()
         {
@@ -148,9 +150,254 @@ namespace spartan
             #endif
         }
     }
+
+    namespace trace
+    {
+        // a completed cpu time block, or a frame marker, sized to a cache line
+        struct Event
+        {
+            uint64_t start   = 0; // nanoseconds, relative to the start of the capture
+            uint64_t end     = 0;
+            uint32_t capture = 0; // events of older captures which are still in the ring are skipped
+            bool is_frame    = false;
+            char name[43]    = {};
+        };
+
+        // ring of events, written only by the thread that owns it, so recording doesn't need locks
+        // when a capture outgrows it, the oldest events are overwritten
+        struct ThreadBuffer
+        {
+            static const uint32_t capacity = 16384;
+
+            array<Event, capacity> events;
+            atomic<uint64_t> write_index = 0;
+            uint32_t id                  = 0;
+            bool is_track                = false;
+            string name;
+        };
+
+        // open time blocks of a thread, they are tracked even when not capturing so that begin/end stay paired
+        struct Scope
+        {
+            const char* name = nullptr;
+            uint64_t start   = 0;
+            bool record      = false;
+        };
+
+        struct ThreadState
+        {
+            array<Scope, 64> scopes;
+            uint32_t depth       = 0;
+            ThreadBuffer* buffer = nullptr;
+            string name;
+        };
+
+        thread_local ThreadState thread_state;
+        mutex mutex_buffers;
+        vector<unique_ptr<ThreadBuffer>> buffers;
+
+        // capture state, frames are counted and the file is written on the main thread
+        atomic<bool> is_capturing         = false;
+        atomic<uint32_t> writers          = 0; // threads which are recording, the file is only written once they are done
+        atomic<uint32_t> capture_id       = 0;
+        atomic<int64_t> capture_start_ns  = 0;
+        uint32_t capture_frames_remaining = 0;
+        string capture_file_path;
+
+        uint64_t to_capture_time(const chrono::steady_clock::time_point time)
+        {
+            const int64_t time_ns = chrono::duration_cast<chrono::nanoseconds>(time.time_since_epoch()).count();
+            return static_cast<uint64_t>(max<int64_t>(time_ns - capture_start_ns.load(memory_order_relaxed), 0));
+        }
+
+        uint64_t now()
+        {
+            return to_capture_time(chrono::steady_clock::now());
+        }
+
+        ThreadBuffer* get_buffer()
+        {
+            if (!thread_state.buffer)
+            {
+                lock_guard<mutex> lock(mutex_buffers);
+
+                ThreadBuffer* buffer = buffers.emplace_back(make_unique<ThreadBuffer>()).get();
+                buffer->id           = static_cast<uint32_t>(buffers.size() - 1);
+                buffer->name         = thread_state.name.empty() ? "thread_" + to_string(buffer->id) : thread_state.name;
+                thread_state.buffer  = buffer;
+            }
+
+            return thread_state.buffer;
+        }
+
+        // a track which isn't a thread, for blocks that begin and end on different threads, it's written by one thread at a time
+        ThreadBuffer* get_track_buffer(const char* name)
+        {
+            lock_guard<mutex> lock(mutex_buffers);
+
+            for (const unique_ptr<ThreadBuffer>& buffer : buffers)
+            {
+                if (buffer->is_track && buffer->name == name)
+                    return buffer.get();
+            }
+
+            ThreadBuffer* buffer = buffers.emplace_back(make_unique<ThreadBuffer>()).get();
+            buffer->id           = static_cast<uint32_t>(buffers.size() - 1);
+            buffer->name         = name;
+            buffer->is_track     = true;
+
+            return buffer;
+        }
+
+        void record(ThreadBuffer* buffer, const char* name, const uint64_t start, const uint64_t end, const bool is_frame)
+        {
+            const uint64_t index = buffer->write_index.load(memory_order_relaxed);
+
+            Event& event   = buffer->events[index % ThreadBuffer::capacity];
+            event.start    = start;
+            event.end      = end;
+            event.capture  = capture_id.load(memory_order_relaxed);
+            event.is_frame = is_frame;
+            strncpy(event.name, name ? name : "N/A", sizeof(event.name) - 1);
+            event.name[sizeof(event.name) - 1] = '\0';
+
+            buffer->write_index.store(index + 1, memory_order_release);
+        }
+
+        void record(const char* name, const uint64_t start, const uint64_t end, const bool is_frame)
+        {
+            record(get_buffer(), name, start, end, is_frame);
+        }
+
+        void begin(const char* name, const bool is_cpu)
+        {
+            const uint32_t depth = thread_state.depth++;
+            if (depth >= thread_state.scopes.size())
+                return;
+
+            Scope& scope = thread_state.scopes[depth];
+            scope.name   = name;
+            scope.record = is_cpu && is_capturing.load(memory_order_acquire);
+            scope.start  = scope.record ? now() : 0;
+        }
+
+        void end()
+        {
+            if (thread_state.depth == 0)
+                return;
+
+            const uint32_t depth = --thread_state.depth;
+            if (depth >= thread_state.scopes.size())
+                return;
+
+            const Scope& scope = thread_state.scopes[depth];
+            if (!scope.record)
+                return;
+
+            // register before checking the flag, so that write() either sees this thread or this thread sees the capture stopped
+            writers.fetch_add(1);
+            if (is_capturing.load())
+            {
+                record(scope.name, scope.start, now(), false);
+            }
+            writers.fetch_sub(1, memory_order_release);
+        }
+
+        void stop()
+        {
+            is_capturing.store(false);
+
+            // wait for the threads which are still recording, after that the buffers are no longer written
+            while (writers.load(memory_order_acquire) != 0)
+            {
+                this_thread::yield();
+            }
+        }
+
+        void append_escaped(string& json, const char* text)
+        {
+            for (const char* c = text; *c; c++)
+            {
+                if (*c == '"' || *c == '\\')
+                {
+                    json += '\\';
+                    json += *c;
+                }
+                else
+                {
+                    json += static_cast<unsigned char>(*c) < 0x20 ? ' ' : *c;
+                }
+            }
+        }
+
+        void write(const string& file_path, const uint32_t capture)
+        {
+            string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            char line[256];
+            uint32_t event_count = 0;
+
+            lock_guard<mutex> lock(mutex_buffers);
+            for (const unique_ptr<ThreadBuffer>& buffer : buffers)
+            {
+                // thread name
+                json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + to_string(buffer->id) + ",\"args\":{\"name\":\"";
+                append_escaped(json, buffer->name.c_str());
+                json += "\"}},\n";
+
+                const uint64_t index_end   = buffer->write_index.load(memory_order_acquire);
+                const uint64_t index_begin = index_end > ThreadBuffer::capacity ? index_end - ThreadBuffer::capacity : 0;
+                bool overflowed            = false;
+                for (uint64_t i = index_begin; i < index_end; i++)
+                {
+                    const Event& event = buffer->events[i % ThreadBuffer::capacity];
+                    if (event.capture != capture || event.end < event.start)
+                        continue;
+
+                    overflowed = overflowed || (i == index_begin && index_begin != 0);
+
+                    json += "{\"name\":\"";
+                    append_escaped(json, event.name);
+                    if (event.is_frame)
+                    {
+                        snprintf(line, sizeof(line), "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":%u,\"ts\":%.3f},\n",
+                            buffer->id, static_cast<double>(event.start) / 1000.0);
+                    }
+                    else
+                    {
+                        snprintf(line, sizeof(line), "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n",
+                            buffer->id, static_cast<double>(event.start) / 1000.0, static_cast<double>(event.end - event.start) / 1000.0);
+                    }
+                    json += line;
+                    event_count++;
+                }
+
+                if (overflowed)
+                {
+                    SP_LOG_WARNING("The trace of \"%s\" exceeded %u events, the oldest ones were dropped", buffer->name.c_str(), ThreadBuffer::capacity);
+                }
+            }
+
+            // drop the trailing comma
+            if (json.size() >= 2 && json[json.size() - 2] == ',')
+            {
+                json.erase(json.size() - 2, 1);
+            }
+            json += "]}\n";
+
+            FileStream file(file_path, FileStream_Write);
+            if (!file.IsOpen())
+                return;
+
+            file.WriteBytes(json.data(), json.size());
+            SP_LOG_INFO("Wrote %u trace events to \"%s\"", event_count, file_path.c_str());
+        }
+    }
   
     void Profiler::Initialize()
     {
+        main_thread_id = this_thread::get_id();
+        SetThreadName("main");
+
         m_time_blocks_read.reserve(max_timeblocks);
         m_time_blocks_read.resize(max_timeblocks);
         m_time_blocks_write.reserve(max_timeblocks);
@@ -161,6 +408,19 @@ namespace spartan
 
     void Profiler::PostTick()
     {
+        // trace
+        if (trace::is_capturing.load(memory_order_relaxed))
+        {
+            const uint64_t time = trace::now();
+            trace::record(("frame " + to_string(Renderer::GetFrameNumber())).c_str(), time, time, true);
+
+            if (--trace::capture_frames_remaining == 0)
+            {
+                trace::stop();
+                trace::write(trace::capture_file_path, trace::capture_id.load(memory_order_relaxed));
+            }
+        }
+
         // compute timings
         {
             is_stuttering_cpu = time_cpu_last > (time_cpu_avg + stutter_delta_ms);
@@ -279,7 +539,10 @@ namespace spartan
 
     void Profiler::TimeBlockStart(const char* func_name, TimeBlockType type, RHI_CommandList* cmd_list /*= nullptr*/)
     {
-        if (!Debugging::IsGpuTimingEnabled() || !poll)
+        trace::begin(func_name, type == TimeBlockType::Cpu);
+
+        // the time block tree is built by the main thread only, other threads show up in traces
+        if (!Debugging::IsGpuTimingEnabled() || !poll || this_thread::get_id() != main_thread_id)
             return;
 
         const bool can_profile_cpu = (type == TimeBlockType::Cpu) && profile_cpu;
@@ -291,6 +554,9 @@ namespace spartan
         // last incomplete block of the same type, is the parent
         TimeBlock* time_block_parent = GetLastIncompleteTimeBlock(type);
 
+        if (m_time_block_index + 1 >= static_cast<int>(max_timeblocks))
+            return;
+
         // get new time block
         TimeBlock& new_time_block = m_time_blocks_write[++m_time_block_index];
         new_time_block.Begin(++m_rhi_timeblock_count, func_name, type, time_block_parent, cmd_list);
@@ -298,6 +564,11 @@ namespace spartan
 
     void Profiler::TimeBlockEnd()
     {
+        trace::end();
+
+        if (this_thread::get_id() != main_thread_id)
+            return;
+
         if (TimeBlock* time_block = GetLastIncompleteTimeBlock(TimeBlockType::Cpu))
         {
             time_block->End();
@@ -325,6 +596,50 @@ namespace spartan
         time_gpu_last   = 0.0f;
     }
 
+    void Profiler::CaptureTrace(const uint32_t frame_count, const string& file_path)
+    {
+        if (trace::is_capturing.load())
+        {
+            SP_LOG_WARNING("A trace is already being captured");
+            return;
+        }
+
+        trace::capture_frames_remaining = max(frame_count, 1u);
+        trace::capture_file_path        = file_path;
+        trace::capture_start_ns         = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+        trace::capture_id++;
+        trace::is_capturing.store(true, memory_order_release);
+    }
+
+    bool Profiler::IsCapturingTrace()
+    {
+        return trace::is_capturing.load();
+    }
+
+    void Profiler::TimeBlockRecord(const char* track, const char* name, const chrono::steady_clock::time_point start, const chrono::steady_clock::time_point end)
+    {
+        if (!trace::is_capturing.load(memory_order_acquire))
+            return;
+
+        trace::writers.fetch_add(1);
+        if (trace::is_capturing.load())
+        {
+            trace::record(trace::get_track_buffer(track), name, trace::to_capture_time(start), trace::to_capture_time(end), false);
+        }
+        trace::writers.fetch_sub(1, memory_order_release);
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        trace::thread_state.name = name;
+
+        if (trace::thread_state.buffer)
+        {
+            lock_guard<mutex> lock(trace::mutex_buffers);
+            trace::thread_state.buffer->name = name;
+        }
+    }
+
     const vector<TimeBlock>& Profiler::GetTimeBlocks()
     {
         return m_time_blocks_read;
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =========
 #include <string>
 #include <vector>
+#include <chrono>
 #include "TimeBlock.h"
 //====================
 
@@ -48,6 +49,14 @@ namespace spartan
         static void TimeBlockStart(const char* func_name, TimeBlockType type, RHI_CommandList* cmd_list = nullptr);
         static void TimeBlockEnd();
         static void ClearMetrics();
+
+        // trace, records the cpu time blocks of every thread for a number of frames and writes them as chrome trace event json
+        static void CaptureTrace(const uint32_t frame_count, const std::string& file_path);
+        static bool IsCapturingTrace();
+        static void SetThreadName(const char* name);
+
+        // records a cpu block that was timed elsewhere, for work which doesn't begin and end on one thread, it goes to a track of its own
+        static void TimeBlockRecord(const char* track, const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
         
         // properties
         static const std::vector<TimeBlock>& GetTimeBlocks();
@@ -265,7 +265,9 @@ namespace spartan
         RHI_Buffer* material_parameters,
         RHI_Buffer* light_parameters,
         const std::array<std::shared_ptr<RHI_Sampler>, static_cast<uint32_t>(Renderer_Sampler::Max)>* samplers,
-        RHI_Buffer* aabbs
+        RHI_Buffer* aabbs,
+        const uint32_t material_textures_start,
+        const uint32_t material_textures_count
     )
     {
 
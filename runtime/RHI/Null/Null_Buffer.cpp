@@ -0,0 +1,102 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_Buffer.h"
+#include "../RHI_Device.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_Implementation.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace spartan
+{
+    void RHI_Buffer::RHI_DestroyResource()
+    {
+        if (m_rhi_resource)
+        {
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::Buffer, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+    }
+
+    void RHI_Buffer::RHI_CreateResource(const void* data)
+    {
+        RHI_DestroyResource();
+
+        // only buffers that the cpu can see get system memory, the rest are just handles
+        uint32_t flags_memory = m_mappable ? null_memory_mappable : 0;
+
+        if (m_type == RHI_Buffer_Type::Storage)
+        {
+            // calculate required alignment based on minimum device offset alignment
+            size_t min_alignment = RHI_Device::PropertyGetMinStorageBufferOffsetAlignment();
+            if (min_alignment > 0 && min_alignment != m_stride)
+            {
+                m_stride      = static_cast<uint32_t>(static_cast<uint64_t>((m_stride + min_alignment - 1) & ~(min_alignment - 1)));
+                m_object_size = m_stride * m_element_count;
+            }
+        }
+        else if (m_type == RHI_Buffer_Type::Constant)
+        {
+            // calculate required alignment based on minimum device offset alignment
+            size_t min_alignment = RHI_Device::PropertyGetMinUniformBufferOffsetAlignment();
+            if (min_alignment > 0 && min_alignment != m_stride)
+            {
+                m_stride      = static_cast<uint32_t>(static_cast<uint64_t>((m_stride + min_alignment - 1) & ~(min_alignment - 1)));
+                m_object_size = m_stride * m_element_count;
+            }
+
+            flags_memory = null_memory_mappable; // always host visible, like the other backends
+        }
+
+        RHI_Device::MemoryBufferCreate(m_rhi_resource, m_object_size, 0, flags_memory, data, m_object_name.c_str());
+
+        SP_ASSERT_MSG(m_rhi_resource != nullptr, "Failed to create buffer");
+        m_data_gpu = m_mappable ? RHI_Device::MemoryGetMappedDataFromBuffer(m_rhi_resource) : nullptr;
+        RHI_Device::SetResourceName(m_rhi_resource, RHI_Resource_Type::Buffer, m_object_name.c_str());
+    }
+
+    void RHI_Buffer::Update(RHI_CommandList* cmd_list, void* data_cpu, const uint32_t size)
+    {
+        SP_ASSERT(cmd_list);
+        SP_ASSERT_MSG(m_mappable,                           "Can't update unmapped buffer");
+        SP_ASSERT_MSG(data_cpu != nullptr,                  "Invalid cpu data");
+        SP_ASSERT_MSG(m_data_gpu != nullptr,                "Invalid gpu data");
+        SP_ASSERT_MSG(m_offset + m_stride <= m_object_size, "Out of memory");
+
+        // advance offset
+        if (first_update)
+        {
+            first_update = false;
+        }
+        else
+        {
+            m_offset += m_stride;
+        }
+
+        cmd_list->UpdateBuffer(this, m_offset, size != 0 ? size : m_stride, data_cpu);
+    }
+}
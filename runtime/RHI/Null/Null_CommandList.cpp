@@ -0,0 +1,971 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "pch.h"
+#include "../RHI_Device.h"
+#include "../RHI_Queue.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_Buffer.h"
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_SyncPrimitive.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_RasterizerState.h"
+#include "../RHI_VendorTechnology.h"
+#include "../Rendering/Renderer.h"
+#include "../../Profiling/Profiler.h"
+#include "../Core/Debugging.h"
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+// the null backend records nothing and submits nothing, but it walks the exact same state
+// machine as the real backends (layouts, deferred barriers, pipeline and descriptor set caching),
+// this way the cpu cost of a frame can be measured and regression tested on machines without a gpu
+
+namespace spartan
+{
+    namespace image_barrier
+    {
+        static unordered_map<void*, array<RHI_Image_Layout, rhi_max_mip_count>> image_layouts;
+        static mutex image_layouts_mutex;
+
+        RHI_Image_Layout get_layout(void* image, uint32_t mip_index)
+        {
+            SP_ASSERT(image != nullptr);
+            lock_guard<mutex> lock(image_layouts_mutex);
+
+            auto it = image_layouts.find(image);
+            if (it == image_layouts.end())
+                return RHI_Image_Layout::Max;
+
+            SP_ASSERT(mip_index < rhi_max_mip_count);
+            return it->second[mip_index];
+        }
+
+        void set_layout(void* image, uint32_t mip_index, uint32_t mip_range, RHI_Image_Layout layout)
+        {
+            SP_ASSERT(image != nullptr);
+            SP_ASSERT(mip_index < rhi_max_mip_count);
+            SP_ASSERT(mip_index + mip_range <= rhi_max_mip_count);
+            lock_guard<mutex> lock(image_layouts_mutex);
+
+            auto it = image_layouts.find(image);
+            if (it == image_layouts.end())
+            {
+                array<RHI_Image_Layout, rhi_max_mip_count> layouts;
+                layouts.fill(RHI_Image_Layout::Max);
+                it = image_layouts.emplace(image, layouts).first;
+            }
+
+            uint32_t mip_end = min(mip_index + mip_range, rhi_max_mip_count);
+            for (uint32_t i = mip_index; i < mip_end; ++i)
+            {
+                it->second[i] = layout;
+            }
+        }
+
+        void remove_layout(void* image)
+        {
+            lock_guard<mutex> lock(image_layouts_mutex);
+            image_layouts.erase(image);
+        }
+    }
+
+    namespace descriptor_sets
+    {
+        bool bind_dynamic = false;
+
+        void set_dynamic(RHI_DescriptorSetLayout* layout)
+        {
+            // resolving the set is where the hashing and caching happens, so it's done even though nothing is bound
+            RHI_DescriptorSet* descriptor_set = layout->GetDescriptorSet();
+            SP_ASSERT(descriptor_set->GetResource() != nullptr);
+
+            array<uint32_t, 10> dynamic_offsets;
+            uint32_t dynamic_offset_count = 0;
+            layout->GetDynamicOffsets(&dynamic_offsets, &dynamic_offset_count);
+
+            bind_dynamic = false;
+        }
+    }
+
+    namespace queries
+    {
+        namespace timestamp
+        {
+            const uint32_t query_count = 128;
+            array<uint64_t, query_count> data; // nothing executes, so every duration reads back as zero
+        }
+
+        namespace occlusion
+        {
+            uint32_t index              = 0;
+            uint32_t index_active       = 0;
+            bool occlusion_query_active = false;
+            const uint32_t query_count  = 4096;
+            array<uint64_t, query_count> data; // nothing is rasterized, so every query reports visible pixels
+            unordered_map<uint64_t, uint32_t> id_to_index;
+        }
+
+        void initialize()
+        {
+            timestamp::data.fill(0);
+            occlusion::data.fill(1);
+        }
+    }
+
+    RHI_CommandList::RHI_CommandList(RHI_Queue* queue, void* cmd_pool, const char* name)
+    {
+        m_queue                 = queue;
+        m_rhi_cmd_pool_resource = cmd_pool;
+        m_rhi_resource          = null_handle();
+        m_object_name           = name;
+        RHI_Device::SetResourceName(m_rhi_resource, RHI_Resource_Type::CommandList, name);
+
+        // semaphores
+        m_rendering_complete_semaphore          = make_shared<RHI_SyncPrimitive>(RHI_SyncPrimitive_Type::Semaphore, (string(name) + "_binary").c_str());
+        m_rendering_complete_semaphore_timeline = make_shared<RHI_SyncPrimitive>(RHI_SyncPrimitive_Type::SemaphoreTimeline, (string(name) + "timeline").c_str());
+
+        queries::initialize();
+    }
+
+    RHI_CommandList::~RHI_CommandList()
+    {
+
+    }
+
+    void RHI_CommandList::Begin()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Idle);
+
+        // enable breadcrumbs for this command list
+        if (Debugging::IsBreadcrumbsEnabled())
+        {
+            RHI_VendorTechnology::Breadcrumbs_RegisterCommandList(this, m_queue, m_object_name.c_str());
+        }
+
+        // set states
+        m_state     = RHI_CommandListState::Recording;
+        m_pso       = RHI_PipelineState();
+        m_cull_mode = RHI_CullMode::Max;
+
+        // set dynamic states
+        if (m_queue->GetType() == RHI_Queue_Type::Graphics)
+        {
+            // cull mode
+            SetCullMode(RHI_CullMode::Back);
+
+            // scissor rectangle
+            math::Rectangle scissor_rect;
+            scissor_rect.left   = 0.0f;
+            scissor_rect.top    = 0.0f;
+            scissor_rect.right  = static_cast<float>(m_pso.GetWidth());
+            scissor_rect.bottom = static_cast<float>(m_pso.GetHeight());
+            SetScissorRectangle(scissor_rect);
+        }
+
+        // queries
+        if (m_queue->GetType() != RHI_Queue_Type::Copy)
+        {
+            m_timestamp_index = 0;
+        }
+    }
+
+    void RHI_CommandList::Submit(RHI_SyncPrimitive* semaphore_wait, const bool is_immediate)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // end
+        RenderPassEnd();
+
+        // immediate command lists wait on the CPU using the timeline semaphore
+        RHI_SyncPrimitive* semaphore_binary = is_immediate ? nullptr : m_rendering_complete_semaphore.get();
+
+        m_queue->Submit(
+            m_rhi_resource,                               // cmd buffer
+            0,                                            // wait flags
+            semaphore_wait,                               // wait semaphore
+            semaphore_binary,                             // signal semaphore
+            m_rendering_complete_semaphore_timeline.get() // signal semaphore
+        );
+
+        if (semaphore_wait)
+        {
+            semaphore_wait->SetUserCmdList(this);
+        }
+
+        m_state = RHI_CommandListState::Submitted;
+    }
+
+    void RHI_CommandList::SetPipelineState(RHI_PipelineState& pso)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // early exit if the pipeline state hasn't changed
+        pso.Prepare();
+        if (m_pso.GetHash() == pso.GetHash())
+            return;
+
+        // determine if the new render pass should clear the render targets or not
+        if ((m_pso.shaders[RHI_Shader_Type::Vertex] != nullptr && m_pso.shaders[RHI_Shader_Type::Vertex] == pso.shaders[RHI_Shader_Type::Vertex]) && m_pso.render_target_array_index == pso.render_target_array_index)
+        {
+            m_load_depth_render_target = (pso.render_target_depth_texture == m_pso.render_target_depth_texture);
+            for (uint32_t i = 0; i < rhi_max_render_target_count; i++)
+            {
+                m_load_color_render_targets[i] = (pso.render_target_color_textures[i] == m_pso.render_target_color_textures[i]);
+            }
+        }
+        else
+        {
+            m_load_depth_render_target = false;
+            for (uint32_t i = 0; i < rhi_max_render_target_count; i++)
+            {
+                m_load_color_render_targets[i] = false;
+            }
+        }
+
+        // get (or create) a pipeline which matches the requested pipeline state
+        m_pso = pso;
+        RHI_Device::GetOrCreatePipeline(m_pso, m_pipeline, m_descriptor_layout_current);
+
+        RenderPassBegin();
+
+        // set pipeline
+        {
+            SP_ASSERT(m_pipeline != nullptr);
+            SP_ASSERT(m_pipeline->GetRhiResource() != nullptr);
+            Profiler::m_rhi_bindings_pipeline++;
+
+            // set some dynamic states
+            if (m_pso.IsGraphics())
+            {
+                // cull mode
+                if (m_pso.rasterizer_state->GetPolygonMode() == RHI_PolygonMode::Wireframe)
+                {
+                    SetCullMode(RHI_CullMode::None);
+                }
+
+                // scissor rectangle
+                math::Rectangle scissor_rect;
+                scissor_rect.left   = 0.0f;
+                scissor_rect.top    = 0.0f;
+                scissor_rect.right  = static_cast<float>(m_pso.GetWidth());
+                scissor_rect.bottom = static_cast<float>(m_pso.GetHeight());
+                SetScissorRectangle(scissor_rect);
+
+                // vertex and index buffer state
+                m_buffer_id_index  = 0;
+                m_buffer_id_vertex = 0;
+            }
+
+            if (Debugging::IsBreadcrumbsEnabled())
+            { 
+                RHI_VendorTechnology::Breadcrumbs_SetPipelineState(this, m_pipeline);
+            }
+        }
+
+        // bind descriptors
+        {
+            // set standard resources (dynamic descriptors)
+            Renderer::SetStandardResources(this);
+            descriptor_sets::set_dynamic(m_descriptor_layout_current);
+        }
+    }
+
+    void RHI_CommandList::RenderPassBegin()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        RenderPassEnd();
+
+        if (!m_pso.IsGraphics())
+            return;
+
+        // color attachments
+        if (RHI_SwapChain* swapchain = m_pso.render_target_swapchain)
+        {
+            // transition to the appropriate layout
+            InsertBarrier(swapchain->GetRhiRt(), swapchain->GetFormat(), 0, 1, 1, RHI_Image_Layout::Attachment);
+            SP_ASSERT(swapchain->GetRhiRtv() != nullptr);
+        }
+        else // regular render target(s)
+        {
+            for (uint32_t i = 0; i < rhi_max_render_target_count; i++)
+            {
+                RHI_Texture* rt = m_pso.render_target_color_textures[i];
+
+                if (rt == nullptr)
+                    break;
+
+                SP_ASSERT_MSG(rt->IsRtv(), "The texture wasn't created with the RHI_Texture_RenderTarget flag and/or isn't a color format");
+
+                // transition to the appropriate layout
+                rt->SetLayout(RHI_Image_Layout::Attachment, this);
+                SP_ASSERT(rt->GetRhiRtv(m_pso.render_target_array_index) != nullptr);
+            }
+        }
+
+        // depth-stencil attachment
+        if (RHI_Texture* rt = m_pso.render_target_depth_texture)
+        {
+            if (Renderer::GetOption<float>(Renderer_Option::ResolutionScale) == 1.0f)
+            { 
+                SP_ASSERT_MSG(rt->GetWidth() == m_pso.GetWidth(), "The depth buffer doesn't match the output resolution");
+            }
+            SP_ASSERT(rt->IsDsv());
+
+            // transition to the appropriate layout
+            rt->SetLayout(RHI_Image_Layout::Attachment, this);
+            SP_ASSERT(rt->GetRhiDsv(m_pso.render_target_array_index) != nullptr);
+        }
+
+        // variable rate shading
+        if (m_pso.vrs_input_texture)
+        {
+            m_pso.vrs_input_texture->SetLayout(RHI_Image_Layout::Shading_Rate_Attachment, this);
+        }
+
+        // begin render pass
+        InsertPendingBarrierGroup();
+
+        // set dynamic states
+        {
+            // variable rate shading
+            RHI_Device::SetVariableRateShading(this, m_pso.vrs_input_texture != nullptr);
+
+            // set viewport
+            RHI_Viewport viewport = RHI_Viewport(
+                0.0f, 0.0f,
+                static_cast<float>(m_pso.GetWidth()),
+                static_cast<float>(m_pso.GetHeight())
+            );
+            SetViewport(viewport);
+        }
+
+        // reset
+        m_load_depth_render_target = false;
+        for (uint32_t i = 0; i < rhi_max_render_target_count; i++)
+        {
+            m_load_color_render_targets[i] = false;
+        }
+        m_render_pass_active     = true;
+        m_render_pass_draw_calls = 0;
+    }
+
+    void RHI_CommandList::RenderPassEnd()
+    {
+        if (!m_render_pass_active)
+            return;
+
+        m_render_pass_active = false;
+    }
+
+    void RHI_CommandList::ClearPipelineStateRenderTargets(RHI_PipelineState& pipeline_state)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::ClearTexture(
+        RHI_Texture* texture,
+        const Color& clear_color     /*= rhi_color_load*/,
+        const float clear_depth      /*= rhi_depth_load*/,
+        const uint32_t clear_stencil /*= rhi_stencil_load*/
+    )
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG((texture->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearBlit flag");
+        SP_ASSERT(texture && texture->GetRhiSrv());
+
+        // one of the required layouts for clear functions
+        texture->SetLayout(RHI_Image_Layout::Transfer_Destination, this);
+    }
+
+    void RHI_CommandList::Draw(const uint32_t vertex_count, const uint32_t vertex_start_index /*= 0*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        PreDraw();
+
+        Profiler::m_rhi_draw++;
+        m_render_pass_draw_calls++;
+    }
+
+    void RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset, const uint32_t instance_index, const uint32_t instance_count)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        PreDraw();
+
+        Profiler::m_rhi_draw++;
+        m_render_pass_draw_calls++;
+    }
+
+    void RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z /*= 1*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        PreDraw();
+    }
+
+    void RHI_CommandList::Blit(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips, const float source_scaling)
+    {
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0,      "Blit requires the texture to be created with the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT_MSG((destination->GetFlags() & RHI_Texture_ClearBlit) != 0, "Blit requires the texture to be created with the RHI_Texture_ClearOrBlit flag");
+        if (blit_mips)
+        {
+            SP_ASSERT_MSG(source->GetMipCount() == destination->GetMipCount(),
+                "If the mips are blitted, then the mip count between the source and the destination textures must match");
+        }
+
+        // save the initial layouts
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_source      = source->GetLayouts();
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_destination = destination->GetLayouts();
+
+        // transition to blit appropriate layouts
+        source->SetLayout(RHI_Image_Layout::Transfer_Source, this);
+        destination->SetLayout(RHI_Image_Layout::Transfer_Destination, this);
+
+        // transition to the initial layouts
+        if (blit_mips)
+        {
+            for (uint32_t i = 0; i < source->GetMipCount(); i++)
+            {
+                source->SetLayout(layouts_initial_source[i], this, i, 1);
+                destination->SetLayout(layouts_initial_destination[i], this, i, 1);
+            }
+        }
+        else
+        {
+            source->SetLayout(layouts_initial_source[0], this);
+            destination->SetLayout(layouts_initial_destination[0], this);
+        }
+    }
+
+    void RHI_CommandList::Blit(RHI_Texture* source, RHI_SwapChain* destination)
+    {
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT_MSG(source->GetWidth() <= destination->GetWidth() && source->GetHeight() <= destination->GetHeight(),
+            "The source texture dimension(s) are larger than the those of the destination texture");
+
+        // save the initial layout
+        RHI_Image_Layout source_layout_initial = source->GetLayout(0);
+
+        // transition to blit appropriate layouts
+        source->SetLayout(RHI_Image_Layout::Transfer_Source, this);
+        InsertBarrier(destination->GetRhiRt(), destination->GetFormat(), 0, 1, 1, RHI_Image_Layout::Transfer_Destination);
+
+        // transition to the initial layouts
+        source->SetLayout(source_layout_initial, this);
+        InsertBarrier(destination->GetRhiRt(), destination->GetFormat(), 0, 1, 1, RHI_Image_Layout::Present_Source);
+    }
+
+    void RHI_CommandList::Copy(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips)
+    {
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT_MSG((destination->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT(source->GetWidth() == destination->GetWidth());
+        SP_ASSERT(source->GetHeight() == destination->GetHeight());
+        SP_ASSERT(source->GetFormat() == destination->GetFormat());
+        if (blit_mips)
+        {
+            SP_ASSERT_MSG(source->GetMipCount() == destination->GetMipCount(),
+                "If the mips are blitted, then the mip count between the source and the destination textures must match");
+        }
+
+        // save the initial layouts
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_source      = source->GetLayouts();
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_destination = destination->GetLayouts();
+
+        // transition to blit appropriate layouts
+        source->SetLayout(RHI_Image_Layout::Transfer_Source, this);
+        destination->SetLayout(RHI_Image_Layout::Transfer_Destination, this);
+
+        // transition to the initial layouts
+        if (blit_mips)
+        {
+            for (uint32_t i = 0; i < source->GetMipCount(); i++)
+            {
+                source->SetLayout(layouts_initial_source[i], this, i, 1);
+                destination->SetLayout(layouts_initial_destination[i], this, i, 1);
+            }
+        }
+        else
+        {
+            source->SetLayout(layouts_initial_source[0], this);
+            destination->SetLayout(layouts_initial_destination[0], this);
+        }
+    }
+
+    void RHI_CommandList::Copy(RHI_Texture* source, RHI_SwapChain* destination)
+    {
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT(source->GetWidth() == destination->GetWidth());
+        SP_ASSERT(source->GetHeight() == destination->GetHeight());
+        SP_ASSERT(source->GetFormat() == destination->GetFormat());
+
+        // transition to copy appropriate layouts
+        RHI_Image_Layout layout_initial_source = source->GetLayout(0);
+        source->SetLayout(RHI_Image_Layout::Transfer_Source, this);
+        InsertBarrier(destination->GetRhiRt(), destination->GetFormat(), 0, 1, 1, RHI_Image_Layout::Transfer_Destination);
+
+        // transition to the initial layout
+        source->SetLayout(layout_initial_source, this);
+        InsertBarrier(destination->GetRhiRt(), destination->GetFormat(), 0, 1, 1, RHI_Image_Layout::Present_Source);
+    }
+
+    void RHI_CommandList::SetViewport(const RHI_Viewport& viewport) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(viewport.width != 0);
+        SP_ASSERT(viewport.height != 0);
+    }
+
+    void RHI_CommandList::SetScissorRectangle(const math::Rectangle& scissor_rectangle) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::SetCullMode(const RHI_CullMode cull_mode)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        m_cull_mode = cull_mode;
+    }
+
+    void RHI_CommandList::SetBufferVertex(const RHI_Buffer* vertex, RHI_Buffer* instance)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // the instance buffer is optional but always part of the pipeline therefore it can't be null
+        if (!instance)
+        {
+            instance = Renderer::GetBuffer(Renderer_Buffer::DummyInstance);
+        }
+        SP_ASSERT(vertex->GetRhiResource() != nullptr && instance->GetRhiResource() != nullptr);
+
+        // check if vertex buffer id has changed to trigger binding
+        if (m_buffer_id_vertex != vertex->GetObjectId())
+        {
+            m_buffer_id_vertex = vertex->GetObjectId();
+            Profiler::m_rhi_bindings_buffer_vertex++;
+        }
+    }
+
+    void RHI_CommandList::SetBufferIndex(const RHI_Buffer* buffer)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(buffer != nullptr);
+        SP_ASSERT(buffer->GetRhiResource() != nullptr);
+
+        if (m_buffer_id_index == buffer->GetObjectId())
+            return;
+
+        m_buffer_id_index = buffer->GetObjectId();
+        Profiler::m_rhi_bindings_buffer_index++;
+    }
+
+    void RHI_CommandList::PushConstants(const uint32_t offset, const uint32_t size, const void* data)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(size <= RHI_Device::PropertyGetMaxPushConstantSize());
+        SP_ASSERT(m_pipeline != nullptr);
+    }
+
+    void RHI_CommandList::SetConstantBuffer(const uint32_t slot, RHI_Buffer* constant_buffer) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+        {
+            SP_LOG_WARNING("Descriptor layout not set, try setting constant buffer \"%s\" within a render pass", constant_buffer->GetObjectName().c_str());
+            return;
+        }
+
+        m_descriptor_layout_current->SetConstantBuffer(slot, constant_buffer);
+        descriptor_sets::bind_dynamic = true;
+    }
+
+    void RHI_CommandList::SetTexture(const uint32_t slot, RHI_Texture* texture, const uint32_t mip_index /*= all_mips*/, uint32_t mip_range /*= 0*/, const bool uav /*= false*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (mip_index != rhi_all_mips)
+        {
+            SP_ASSERT_MSG(mip_range != 0, "If a mip was specified, then mip_range can't be 0");
+        }
+
+        if (!m_descriptor_layout_current)
+        {
+            SP_LOG_WARNING("Descriptor layout not set, try setting texture \"%s\" within a render pass", texture->GetObjectName().c_str());
+            return;
+        }
+
+        // if the texture is null or it's still loading, ignore it
+        if (!texture || texture->GetResourceState() != ResourceState::PreparedForGpu)
+            return;
+
+        // get some texture info
+        const uint32_t mip_count        = texture->GetMipCount();
+        const bool mip_specified        = mip_index != rhi_all_mips;
+        const uint32_t mip_start        = mip_specified ? mip_index : 0;
+        RHI_Image_Layout current_layout = texture->GetLayout(mip_start);
+
+        SP_ASSERT_MSG(current_layout != RHI_Image_Layout::Max && current_layout != RHI_Image_Layout::Preinitialized, "Invalid layout");
+
+        // transition to appropriate layout (if needed)
+        {
+            RHI_Image_Layout target_layout = RHI_Image_Layout::Max;
+            if (uav)
+            {
+                SP_ASSERT(texture->IsUav());
+                target_layout = RHI_Image_Layout::General;
+            }
+            else
+            {
+                SP_ASSERT(texture->IsSrv());
+                target_layout = RHI_Image_Layout::Shader_Read;
+            }
+
+            // determine if a layout transition is needed
+            bool transition_required = current_layout != target_layout;
+            {
+                array<RHI_Image_Layout, rhi_max_mip_count> layouts = texture->GetLayouts();
+                for (uint32_t i = mip_start; i < mip_count; i++)
+                {
+                    if (target_layout != layouts[i])
+                    {
+                        transition_required = true;
+                        break;
+                    }
+                }
+            }
+
+            // transition
+            if (transition_required)
+            {
+                texture->SetLayout(target_layout, this, mip_index, mip_range);
+            }
+        }
+
+        m_descriptor_layout_current->SetTexture(slot, texture, mip_index, mip_range);
+        descriptor_sets::bind_dynamic = true;
+    }
+
+    void RHI_CommandList::SetBuffer(const uint32_t slot, RHI_Buffer* buffer) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+        {
+            SP_LOG_WARNING("Descriptor layout not set, try setting buffer \"%s\" within a render pass", buffer->GetObjectName().c_str());
+            return;
+        }
+
+        m_descriptor_layout_current->SetBuffer(slot, buffer);
+        descriptor_sets::bind_dynamic = true;
+    }
+
+    void RHI_CommandList::BeginMarker(const char* name)
+    {
+        if (Debugging::IsGpuMarkingEnabled())
+        {
+            RHI_Device::MarkerBegin(this, name, Vector4::Zero);
+        }
+
+        if (Debugging::IsBreadcrumbsEnabled())
+        {
+            RHI_VendorTechnology::Breadcrumbs_MarkerBegin(this, AMD_FFX_Marker::Pass, name);
+        }
+    }
+
+    void RHI_CommandList::EndMarker()
+    {
+        if (Debugging::IsGpuMarkingEnabled())
+        {
+            RHI_Device::MarkerEnd(this);
+        }
+
+        if (Debugging::IsBreadcrumbsEnabled())
+        {
+            RHI_VendorTechnology::Breadcrumbs_MarkerEnd(this);
+        }
+    }
+
+    uint32_t RHI_CommandList::BeginTimestamp()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(m_timestamp_index + 1 < queries::timestamp::query_count);
+
+        uint32_t timestamp_index = m_timestamp_index++;
+        return timestamp_index;
+    }
+
+    void RHI_CommandList::EndTimestamp()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        m_timestamp_index++;
+    }
+
+    float RHI_CommandList::GetTimestampResult(const uint32_t index_timestamp)
+    {
+        SP_ASSERT_MSG(index_timestamp + 1 < queries::timestamp::data.size(), "index out of range");
+
+        uint64_t start    = queries::timestamp::data[index_timestamp];
+        uint64_t end      = queries::timestamp::data[index_timestamp + 1];
+        uint64_t duration = end - start;
+
+        return static_cast<float>(duration * RHI_Device::PropertyGetTimestampPeriod() * 1e-6f);
+    }
+
+    void RHI_CommandList::BeginOcclusionQuery(const uint64_t entity_id)
+    {
+        SP_ASSERT_MSG(m_pso.IsGraphics(), "Occlusion queries are only supported in graphics pipelines");
+
+        queries::occlusion::index_active = queries::occlusion::id_to_index[entity_id];
+        if (queries::occlusion::index_active == 0)
+        {
+            queries::occlusion::index_active           = ++queries::occlusion::index;
+            queries::occlusion::id_to_index[entity_id] = queries::occlusion::index;
+        }
+        SP_ASSERT(queries::occlusion::index_active < queries::occlusion::query_count);
+
+        if (!m_render_pass_active)
+        {
+            RenderPassBegin();
+        }
+
+        queries::occlusion::occlusion_query_active = true;
+    }
+
+    void RHI_CommandList::EndOcclusionQuery()
+    {
+        queries::occlusion::occlusion_query_active = false;
+    }
+
+    bool RHI_CommandList::GetOcclusionQueryResult(const uint64_t entity_id)
+    {
+        if (queries::occlusion::id_to_index.find(entity_id) == queries::occlusion::id_to_index.end())
+            return false;
+
+        uint32_t index  = queries::occlusion::id_to_index[entity_id];
+        uint64_t result = queries::occlusion::data[index]; // visible pixel count
+
+        return result == 0;
+    }
+
+    void RHI_CommandList::UpdateOcclusionQueries()
+    {
+
+    }
+
+    void RHI_CommandList::BeginTimeblock(const char* name, const bool gpu_marker, const bool gpu_timing)
+    {
+        SP_ASSERT(name != nullptr);
+
+        // timing
+        Profiler::TimeBlockStart(name, TimeBlockType::Cpu, this);
+        if (Debugging::IsGpuTimingEnabled() && gpu_timing)
+        {
+            Profiler::TimeBlockStart(name, TimeBlockType::Gpu, this);
+        }
+
+        // markers (support nesting)
+        if (Debugging::IsGpuMarkingEnabled() && gpu_marker)
+        {
+            RHI_Device::MarkerBegin(this, name, Vector4::Zero);
+            m_debug_label_stack.push(name);
+        }
+
+        // track active time blocks (for nesting)
+        m_active_timeblocks.push(name);
+    }
+
+    void RHI_CommandList::EndTimeblock()
+    {
+        SP_ASSERT(!m_active_timeblocks.empty());
+
+        // markers (only end if one was started)
+        if (Debugging::IsGpuMarkingEnabled() && !m_debug_label_stack.empty())
+        {
+            RHI_Device::MarkerEnd(this);
+            m_debug_label_stack.pop();
+        }
+
+        // timing
+        if (Debugging::IsGpuTimingEnabled())
+        {
+            Profiler::TimeBlockEnd(); // gpu
+        }
+        Profiler::TimeBlockEnd(); // cpu
+
+        // pop the active time block
+        m_active_timeblocks.pop();
+    }
+
+    void RHI_CommandList::UpdateBuffer(RHI_Buffer* buffer, const uint64_t offset, const uint64_t size, const void* data)
+    {
+        SP_ASSERT(buffer);
+        SP_ASSERT(size);
+        SP_ASSERT(data);
+        SP_ASSERT(offset + size <= buffer->GetObjectSize());
+
+        // same split as the real backends, so the barrier count matches
+        bool synchronized_update  = true;
+        synchronized_update      &= (offset % 4 == 0);
+        synchronized_update      &= (size % 4 == 0);
+        synchronized_update      &= (size <= rhi_max_buffer_update_size);
+
+        if (synchronized_update)
+        {
+            RenderPassEnd();
+            Profiler::m_rhi_pipeline_barriers += 2; // before and after the update
+        }
+
+        // the device executes instantly, so the write lands right away (if the memory is visible to the cpu)
+        if (void* mapped_data = buffer->GetMappedData())
+        {
+            memcpy(static_cast<char*>(mapped_data) + offset, data, size);
+        }
+    }
+
+    void RHI_CommandList::InsertBarrier(
+        void* image,
+        const RHI_Format format,
+        const uint32_t mip_index,
+        const uint32_t mip_range,
+        const uint32_t array_length,
+        const RHI_Image_Layout layout_new
+        )
+    {
+        SP_ASSERT(image != nullptr);
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(mip_index < rhi_max_mip_count);
+        SP_ASSERT(mip_index + mip_range <= rhi_max_mip_count);
+
+        bool is_depth = format == RHI_Format::D16_Unorm || format == RHI_Format::D32_Float || format == RHI_Format::D32_Float_S8X24_Uint;
+
+        // get layouts for all mips in the range
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts;
+        bool all_mips_same_layout     = true;
+        bool all_mips_match           = true;
+        RHI_Image_Layout first_layout = image_barrier::get_layout(image, mip_index);
+        for (uint32_t i = 0; i < mip_range; i++)
+        {
+            layouts[i] = image_barrier::get_layout(image, mip_index + i);
+            all_mips_same_layout &= layouts[i] == first_layout && layouts[i] != layout_new;
+            all_mips_match       &= layouts[i] == layout_new;
+        }
+
+        // early exit if all mips match target layout
+        if (all_mips_match)
+            return;
+
+        // defer barriers and group into one (if eligible)
+        if (!m_render_pass_active)
+        {
+            bool immediate_barrier = first_layout == RHI_Image_Layout::Max                  ||
+                                     first_layout == RHI_Image_Layout::Preinitialized       ||
+                                     first_layout == RHI_Image_Layout::Transfer_Source      || layout_new == RHI_Image_Layout::Transfer_Source      ||
+                                     first_layout == RHI_Image_Layout::Transfer_Destination || layout_new == RHI_Image_Layout::Transfer_Destination ||
+                                     first_layout == RHI_Image_Layout::Present_Source       || layout_new == RHI_Image_Layout::Present_Source;
+
+            if (!immediate_barrier)
+            {
+                if (all_mips_same_layout)
+                {
+                    m_image_barriers.emplace_back(image, 0, mip_index, mip_range, array_length, first_layout, layout_new, is_depth);
+                }
+                else
+                {
+                    for (uint32_t i = 0; i < mip_range; i++)
+                    {
+                        if (layouts[i] != layout_new)
+                        {
+                            m_image_barriers.emplace_back(image, 0, mip_index + i, 1, array_length, layouts[i], layout_new, is_depth);
+                        }
+                    }
+                }
+
+                image_barrier::set_layout(image, mip_index, mip_range, layout_new);
+                return;
+            }
+        }
+
+        RenderPassEnd();
+        Profiler::m_rhi_pipeline_barriers++;
+        image_barrier::set_layout(image, mip_index, mip_range, layout_new);
+    }
+
+    void RHI_CommandList::InsertBarrierReadWrite(RHI_Texture* texture)
+    {
+        SP_ASSERT(texture->GetRhiResource() != nullptr);
+
+        RenderPassEnd();
+        Profiler::m_rhi_pipeline_barriers++;
+    }
+
+    void RHI_CommandList::InsertBarrierReadWrite(RHI_Buffer* buffer)
+    {
+        SP_ASSERT(buffer->GetRhiResource() != nullptr);
+
+        RenderPassEnd();
+        Profiler::m_rhi_pipeline_barriers++;
+    }
+
+    void RHI_CommandList::InsertPendingBarrierGroup()
+    {
+        if (!m_image_barriers.empty())
+        {
+            RenderPassEnd();
+            Profiler::m_rhi_pipeline_barriers++;
+            m_image_barriers.clear();
+        }
+    }
+
+    void RHI_CommandList::RemoveLayout(void* image)
+    {
+        image_barrier::remove_layout(image);
+    }
+
+    RHI_Image_Layout RHI_CommandList::GetImageLayout(void* image, const uint32_t mip_index)
+    {
+        return image_barrier::get_layout(image, mip_index);
+    }
+
+    void RHI_CommandList::PreDraw()
+    {
+        InsertPendingBarrierGroup();
+
+        if (!m_render_pass_active && m_pso.IsGraphics())
+        {
+            RenderPassBegin();
+        }
+
+        if (descriptor_sets::bind_dynamic)
+        {
+            descriptor_sets::set_dynamic(m_descriptor_layout_current);
+        }
+    }
+}
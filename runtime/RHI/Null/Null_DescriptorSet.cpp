@@ -0,0 +1,59 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_Device.h"
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Buffer.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace spartan
+{
+    void RHI_DescriptorSet::Update(const vector<RHI_Descriptor>& descriptors)
+    {
+        m_descriptors = descriptors;
+
+        // validate descriptor set
+        SP_ASSERT(m_resource != nullptr);
+
+        // there is nothing to write, but what would be written has to be valid
+        for (const RHI_Descriptor& descriptor : descriptors)
+        {
+            if (!descriptor.data)
+                continue;
+
+            if (descriptor.type == RHI_Descriptor_Type::ConstantBuffer || descriptor.type == RHI_Descriptor_Type::StructuredBuffer)
+            {
+                SP_ASSERT(static_cast<RHI_Buffer*>(descriptor.data)->GetRhiResource() != nullptr);
+            }
+            else if (descriptor.type != RHI_Descriptor_Type::Image && descriptor.type != RHI_Descriptor_Type::TextureStorage)
+            {
+                SP_ASSERT_MSG(false, "Unhandled descriptor type");
+            }
+        }
+    }
+}
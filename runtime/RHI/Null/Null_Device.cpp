@@ -0,0 +1,721 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "pch.h"
+#include "../../Profiling/Profiler.h"
+#include "../Rendering/Renderer.h"
+#include "../RHI_Device.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Queue.h"
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_Shader.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_Buffer.h"
+#include "../RHI_Texture.h"
+#include "../../Core/ProgressTracker.h"
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+namespace spartan
+{
+    namespace
+    {
+        mutex mutex_deletion_queue;
+        unordered_map<RHI_Resource_Type, vector<void*>> deletion_queue;
+    }
+
+    namespace queues
+    {
+        array<shared_ptr<RHI_Queue>, static_cast<uint32_t>(RHI_Queue_Type::Max)> regular;   // graphics, compute, and copy
+        array<shared_ptr<RHI_Queue>, static_cast<uint32_t>(RHI_Queue_Type::Max)> immediate; // graphics, compute, and copy
+
+        // there are no api queues, these only need to be unique and non-null
+        void* graphics = nullptr;
+        void* compute  = nullptr;
+        void* copy     = nullptr;
+
+        // sync for immediate execution
+        mutex mutex_immediate_execution;
+        condition_variable condition_variable_immediate_execution;
+        bool is_immediate_executing = false;
+        RHI_Queue* queue            = nullptr;
+
+        void destroy()
+        {
+            regular.fill(nullptr);
+            immediate.fill(nullptr);
+        }
+    }
+
+    namespace memory
+    {
+        // reported as the device's memory, nothing is actually reserved
+        const uint64_t budget = 8ull * 1024 * 1024 * 1024;
+
+        struct Allocation
+        {
+            vector<std::byte> data; // only mappable allocations are backed by system memory
+            uint64_t size = 0;
+        };
+
+        mutex mutex_allocations;
+        unordered_map<void*, Allocation> allocations;
+        uint64_t usage = 0;
+
+        void* allocate(const uint64_t size, const bool mappable)
+        {
+            void* resource = null_handle();
+
+            lock_guard<mutex> lock(mutex_allocations);
+            Allocation& allocation = allocations[resource];
+            allocation.size        = size;
+            if (mappable)
+            {
+                // nothing writes gpu memory, so whatever the cpu reads back (e.g. occlusion visibility) reads as "all bits set"
+                allocation.data.resize(static_cast<size_t>(size), std::byte{ 0xFF });
+            }
+            usage += size;
+
+            return resource;
+        }
+
+        void free(void*& resource)
+        {
+            lock_guard<mutex> lock(mutex_allocations);
+
+            auto it = allocations.find(resource);
+            if (it != allocations.end())
+            {
+                usage -= it->second.size;
+                allocations.erase(it);
+                resource = nullptr;
+            }
+        }
+
+        void* get_data(void* resource)
+        {
+            lock_guard<mutex> lock(mutex_allocations);
+
+            auto it = allocations.find(resource);
+            if (it != allocations.end() && !it->second.data.empty())
+                return it->second.data.data();
+
+            return nullptr;
+        }
+
+        void destroy()
+        {
+            SP_ASSERT_MSG(allocations.empty(), "There are still allocations");
+        }
+    }
+
+    namespace descriptors
+    {
+        mutex descriptor_pipeline_mutex;
+
+        // cache
+        unordered_map<uint64_t, RHI_DescriptorSet> sets;
+        unordered_map<uint64_t, shared_ptr<RHI_DescriptorSetLayout>> layouts;
+        unordered_map<uint64_t, shared_ptr<RHI_Pipeline>> pipelines;
+        unordered_map<uint64_t, vector<RHI_Descriptor>> descriptor_cache;
+
+        void merge_descriptors(vector<RHI_Descriptor>& base_descriptors, const std::vector<RHI_Descriptor>& additional_descriptors)
+        {
+            for (const RHI_Descriptor& descriptor_additional : additional_descriptors)
+            {
+                bool updated_existing = false;
+                for (RHI_Descriptor& descriptor_base : base_descriptors)
+                {
+                    if (descriptor_base.slot == descriptor_additional.slot)
+                    {
+                        descriptor_base.stage |= descriptor_additional.stage;
+                        updated_existing = true;
+                        break;
+                    }
+                }
+
+                // if no updating took place, this is an additional shader only resource, add it
+                if (!updated_existing)
+                {
+                    base_descriptors.emplace_back(descriptor_additional);
+                }
+            }
+        }
+
+        void get_descriptors_from_pipeline_state(RHI_PipelineState& pipeline_state, vector<RHI_Descriptor>& descriptors)
+        {
+            pipeline_state.Prepare();
+
+            // use the hash of the pipeline state as the key for the cache
+            uint64_t pipeline_state_hash = pipeline_state.GetHash();
+
+            // check if descriptors for this pipeline state are already cached
+            auto cached_descriptors = descriptor_cache.find(pipeline_state_hash);
+            if (cached_descriptors != descriptor_cache.end())
+            {
+                // fetch from cache
+                descriptors = cached_descriptors->second;
+                return;
+            }
+
+            // if not cached, generate descriptors
+            descriptors.clear();
+
+            if (pipeline_state.IsCompute())
+            {
+                SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Compute]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                descriptors = pipeline_state.shaders[RHI_Shader_Type::Compute]->GetDescriptors();
+            }
+            else if (pipeline_state.IsGraphics())
+            {
+                SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Vertex]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                descriptors = pipeline_state.shaders[RHI_Shader_Type::Vertex]->GetDescriptors();
+
+                if (pipeline_state.shaders[RHI_Shader_Type::Pixel])
+                {
+                    SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Pixel]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                    merge_descriptors(descriptors, pipeline_state.shaders[RHI_Shader_Type::Pixel]->GetDescriptors());
+                }
+
+                if (pipeline_state.shaders[RHI_Shader_Type::Hull])
+                {
+                    SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Hull]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                    merge_descriptors(descriptors, pipeline_state.shaders[RHI_Shader_Type::Hull]->GetDescriptors());
+                }
+
+                if (pipeline_state.shaders[RHI_Shader_Type::Domain])
+                {
+                    SP_ASSERT(pipeline_state.shaders[RHI_Shader_Type::Domain]->GetCompilationState() == RHI_ShaderCompilationState::Succeeded);
+                    merge_descriptors(descriptors, pipeline_state.shaders[RHI_Shader_Type::Domain]->GetDescriptors());
+                }
+            }
+
+            // sort descriptors by slot, dynamic offsets are expected as a list which is ordered by slot
+            sort(descriptors.begin(), descriptors.end(), [](const RHI_Descriptor& a, const RHI_Descriptor& b)
+            {
+                return a.slot < b.slot;
+            });
+
+            // cache the newly created descriptors
+            descriptor_cache[pipeline_state_hash] = descriptors;
+        }
+
+        shared_ptr<RHI_DescriptorSetLayout> get_or_create_descriptor_set_layout(RHI_PipelineState& pipeline_state)
+        {
+            // get descriptors from pipeline state
+            vector<RHI_Descriptor> descriptors;
+            get_descriptors_from_pipeline_state(pipeline_state, descriptors);
+
+            // compute a hash for the descriptors
+            uint64_t hash = 0;
+            for (RHI_Descriptor& descriptor : descriptors)
+            {
+                hash = rhi_hash_combine(hash, static_cast<uint64_t>(descriptor.slot));
+                hash = rhi_hash_combine(hash, static_cast<uint64_t>(descriptor.stage));
+            }
+
+            // search for a descriptor set layout which matches this hash
+            auto it     = layouts.find(hash);
+            bool cached = it != layouts.end();
+
+            // if there is no descriptor set layout for this particular hash, create one
+            if (!cached)
+            {
+                it = layouts.emplace(make_pair(hash, make_shared<RHI_DescriptorSetLayout>(descriptors, pipeline_state.name))).first;
+            }
+            shared_ptr<RHI_DescriptorSetLayout> descriptor_set_layout = it->second;
+
+            if (cached)
+            {
+                descriptor_set_layout->ClearDescriptorData();
+            }
+
+            return descriptor_set_layout;
+        }
+
+        namespace bindless
+        {
+            array<void*, static_cast<uint32_t>(RHI_Device_Bindless_Resource::Max)> sets;
+            array<void*, static_cast<uint32_t>(RHI_Device_Bindless_Resource::Max)> layouts;
+
+            void update(const RHI_Device_Bindless_Resource type, const uint32_t count, const uint32_t start = 0)
+            {
+                SP_ASSERT(start + count <= rhi_max_array_size);
+
+                // on the first run, create layout and set
+                if (layouts[static_cast<uint32_t>(type)] == nullptr)
+                {
+                    SP_ASSERT_MSG(start == 0, "The first update has to cover the whole array");
+                    layouts[static_cast<uint32_t>(type)] = null_handle();
+                    sets[static_cast<uint32_t>(type)]    = null_handle();
+                }
+            }
+        }
+
+        void release()
+        {
+            sets.clear();
+            layouts.clear();
+            pipelines.clear();
+            descriptor_cache.clear();
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(bindless::layouts.size()); i++)
+            {
+                RHI_Device::DeletionQueueAdd(RHI_Resource_Type::DescriptorSetLayout, bindless::layouts[i]);
+                bindless::layouts[i] = nullptr;
+                bindless::sets[i]    = nullptr;
+            }
+        }
+    }
+
+    void RHI_Device::Initialize()
+    {
+        RHI_Context::api_version_str = "1.0";
+
+        // a single cpu "device" that satisfies every limit the renderer asks for
+        {
+            PhysicalDeviceRegister(PhysicalDevice(1, 1, 0, RHI_PhysicalDevice_Type::Cpu, "Null", memory::budget, nullptr));
+            PhysicalDeviceSetPrimary(0);
+
+            m_timestamp_period                     = 1.0f;
+            m_min_uniform_buffer_offset_alignment  = 256;
+            m_min_storage_buffer_offset_alignment  = 256;
+            m_max_texture_1d_dimension             = 16384;
+            m_max_texture_2d_dimension             = 16384;
+            m_max_texture_3d_dimension             = 2048;
+            m_max_texture_cube_dimension           = 16384;
+            m_max_texture_array_layers             = 2048;
+            m_max_push_constant_size               = 256;
+            m_max_shading_rate_texel_size_x        = 16;
+            m_max_shading_rate_texel_size_y        = 16;
+            m_optimal_buffer_copy_offset_alignment = 256;
+            m_is_shading_rate_supported            = false;
+            m_xess_supported                       = false;
+        }
+
+        // create queues
+        {
+            queues::graphics = null_handle();
+            queues::compute  = null_handle();
+            queues::copy     = null_handle();
+
+            queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Graphics)] = make_shared<RHI_Queue>(RHI_Queue_Type::Graphics, "graphics");
+            queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Compute)]  = make_shared<RHI_Queue>(RHI_Queue_Type::Compute,  "compute");
+            queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Copy)]     = make_shared<RHI_Queue>(RHI_Queue_Type::Copy,     "copy");
+
+            queues::immediate[static_cast<uint32_t>(RHI_Queue_Type::Graphics)] = make_shared<RHI_Queue>(RHI_Queue_Type::Graphics, "graphics");
+            queues::immediate[static_cast<uint32_t>(RHI_Queue_Type::Compute)]  = make_shared<RHI_Queue>(RHI_Queue_Type::Compute,  "compute");
+            queues::immediate[static_cast<uint32_t>(RHI_Queue_Type::Copy)]     = make_shared<RHI_Queue>(RHI_Queue_Type::Copy,     "copy");
+        }
+
+        SP_LOG_INFO("Null device created, nothing will be rendered");
+    }
+
+    void RHI_Device::Tick(const uint64_t frame_count)
+    {
+
+    }
+
+    void RHI_Device::Destroy()
+    {
+        SP_ASSERT(queues::graphics != nullptr);
+
+        // destroy queues
+        QueueWaitAll();
+        queues::destroy();
+
+        // descriptors
+        descriptors::release();
+
+        // the destructor of all the resources enqueues their memory for de-allocation, this is where it happens
+        RHI_Device::DeletionQueueParse();
+
+        // assert if any allocations are left
+        memory::destroy();
+    }
+
+    // queues
+
+    uint32_t RHI_Device::GetQueueIndex(const RHI_Queue_Type type)
+    {
+        return static_cast<uint32_t>(type);
+    }
+
+    RHI_Queue* RHI_Device::GetQueue(const RHI_Queue_Type type)
+    {
+        if (type == RHI_Queue_Type::Graphics)
+            return queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Graphics)].get();
+
+        if (type == RHI_Queue_Type::Compute)
+            return queues::regular[static_cast<uint32_t>(RHI_Queue_Type::Compute)].get();
+
+        return nullptr;
+    }
+
+    void* RHI_Device::GetQueueRhiResource(const RHI_Queue_Type type)
+    {
+        if (type == RHI_Queue_Type::Graphics)
+            return queues::graphics;
+
+        if (type == RHI_Queue_Type::Copy)
+            return queues::copy;
+
+        if (type == RHI_Queue_Type::Compute)
+            return queues::compute;
+
+        return nullptr;
+    }
+
+    void RHI_Device::QueueWaitAll(const bool flush)
+    {
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            queues::regular[i]->Wait(flush);
+        }
+    }
+
+    // deletion queue
+
+    void RHI_Device::DeletionQueueAdd(const RHI_Resource_Type resource_type, void* resource)
+    {
+        if (!resource)
+            return;
+
+        lock_guard<mutex> guard(mutex_deletion_queue);
+        deletion_queue[resource_type].emplace_back(resource);
+    }
+
+    void RHI_Device::DeletionQueueParse()
+    {
+        lock_guard<mutex> guard(mutex_deletion_queue);
+
+        for (auto& it : deletion_queue)
+        {
+            RHI_Resource_Type resource_type = it.first;
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(it.second.size()); i++)
+            {
+                void* resource = it.second[i];
+
+                switch (resource_type)
+                {
+                    case RHI_Resource_Type::Image:     MemoryTextureDestroy(resource);                     break;
+                    case RHI_Resource_Type::Buffer:    MemoryBufferDestroy(resource);                      break;
+                    case RHI_Resource_Type::Semaphore: delete static_cast<atomic<uint64_t>*>(resource); break;
+                    case RHI_Resource_Type::Fence:     delete static_cast<atomic<uint64_t>*>(resource); break;
+                    default:                           break; // plain handles, nothing to release
+                }
+
+                // delete descriptor sets which are now invalid (because they are referring to a deleted resource)
+                if (resource_type == RHI_Resource_Type::ImageView || resource_type == RHI_Resource_Type::Buffer)
+                {
+                    for (auto it = descriptors::sets.begin(); it != descriptors::sets.end();)
+                    {
+                        if (it->second.IsReferingToResource(resource))
+                        {
+                            it = descriptors::sets.erase(it);
+                        }
+                        else
+                        {
+                            ++it;
+                        }
+                    }
+                }
+            }
+        }
+
+        deletion_queue.clear();
+    }
+
+    bool RHI_Device::DeletionQueueNeedsToParse()
+    {
+        static uint32_t frames_equilibrium         = 0;
+        static uint32_t objects_to_delete_previous = 0;
+    
+        // count deletions in the queue
+        uint32_t objects_to_delete = 0;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(RHI_Resource_Type::Max); i++)
+        {
+            objects_to_delete += static_cast<uint32_t>(deletion_queue[static_cast<RHI_Resource_Type>(i)].size());
+        }
+    
+        // check if the number of objects to delete has remained unchanged
+        if (objects_to_delete > 0 && objects_to_delete == objects_to_delete_previous)
+        {
+            frames_equilibrium++;
+
+            // if it's been stable for renderer_resource_frame_lifetime frames, reset counter and delete
+            if (frames_equilibrium >= renderer_resource_frame_lifetime)
+            {
+                frames_equilibrium = 0;
+                return true;
+            }
+        }
+        else
+        {
+            // reset counter if the count changed or if nothing is in the queue
+            frames_equilibrium = 0;
+        }
+    
+        // update the previous object count to the current count
+        objects_to_delete_previous = objects_to_delete;
+    
+        return false;
+    }
+
+    // descriptors
+
+    void RHI_Device::AllocateDescriptorSet(void*& resource, RHI_DescriptorSetLayout* descriptor_set_layout, const vector<RHI_Descriptor>& descriptors_)
+    {
+        SP_ASSERT(resource == nullptr);
+        SP_ASSERT(descriptor_set_layout->GetRhiResource() != nullptr);
+
+        resource = null_handle();
+        Profiler::m_descriptor_set_count++;
+    }
+
+    void* RHI_Device::GetDescriptorSet(const RHI_Device_Bindless_Resource resource_type)
+    {
+        return descriptors::bindless::sets[static_cast<uint32_t>(resource_type)];
+    }
+
+    void* RHI_Device::GetDescriptorSetLayout(const RHI_Device_Bindless_Resource resource_type)
+    {
+        return descriptors::bindless::layouts[static_cast<uint32_t>(resource_type)];
+    }
+
+    unordered_map<uint64_t, RHI_DescriptorSet>& RHI_Device::GetDescriptorSets()
+    {
+        return descriptors::sets;
+    }
+
+    uint32_t RHI_Device::GetDescriptorType(const RHI_Descriptor& descriptor)
+    {
+        if (descriptor.type == RHI_Descriptor_Type::Image            ||
+            descriptor.type == RHI_Descriptor_Type::TextureStorage   ||
+            descriptor.type == RHI_Descriptor_Type::StructuredBuffer ||
+            descriptor.type == RHI_Descriptor_Type::ConstantBuffer)
+            return static_cast<uint32_t>(descriptor.type);
+
+        SP_ASSERT_MSG(false, "Unhandled descriptor type");
+        return numeric_limits<uint32_t>::max();
+    }
+
+    void RHI_Device::UpdateBindlessResources(
+        array<RHI_Texture*, rhi_max_array_size>* material_textures,
+        RHI_Buffer* material_parameteres,
+        RHI_Buffer* light_parameters,
+        const array<shared_ptr<RHI_Sampler>, static_cast<uint32_t>(Renderer_Sampler::Max)>* samplers,
+        RHI_Buffer* bindless_aabbs,
+        const uint32_t material_textures_start,
+        const uint32_t material_textures_count
+    )
+    {
+        if (samplers)
+        {
+            descriptors::bindless::update(RHI_Device_Bindless_Resource::SamplersComparison, 1);
+            descriptors::bindless::update(RHI_Device_Bindless_Resource::SamplersRegular,    8);
+        }
+
+        if (light_parameters)
+        {
+            descriptors::bindless::update(RHI_Device_Bindless_Resource::LightParameters, 1);
+        }
+
+        if (material_textures)
+        {
+            descriptors::bindless::update(RHI_Device_Bindless_Resource::MaterialTextures, material_textures_count, material_textures_start);
+        }
+
+        if (material_parameteres)
+        {
+            descriptors::bindless::update(RHI_Device_Bindless_Resource::MaterialParameters, 1);
+        }
+
+        if (bindless_aabbs)
+        {
+            descriptors::bindless::update(RHI_Device_Bindless_Resource::Aabbs, 1);
+        }
+    }
+
+    // pipelines
+
+    void RHI_Device::GetOrCreatePipeline(RHI_PipelineState& pso, RHI_Pipeline*& pipeline, RHI_DescriptorSetLayout*& descriptor_set_layout)
+    {
+        pso.Prepare();
+
+        lock_guard<mutex> lock(descriptors::descriptor_pipeline_mutex);
+
+        descriptor_set_layout = descriptors::get_or_create_descriptor_set_layout(pso).get();
+
+        // if no pipeline exists, create one
+        uint64_t hash = pso.GetHash();
+        auto it = descriptors::pipelines.find(hash);
+        if (it == descriptors::pipelines.end())
+        {
+            it = descriptors::pipelines.emplace(make_pair(hash, make_shared<RHI_Pipeline>(pso, descriptor_set_layout))).first;
+        }
+
+        pipeline = it->second.get();
+    }
+
+    uint32_t RHI_Device::GetPipelineCount()
+    {
+        return static_cast<uint32_t>(descriptors::pipelines.size());
+    }
+
+    // memory
+
+    void* RHI_Device::MemoryGetMappedDataFromBuffer(void* resource)
+    {
+        return memory::get_data(resource);
+    }
+
+    void RHI_Device::MemoryBufferCreate(void*& resource, const uint64_t size, uint32_t flags_usage, uint32_t flags_memory, const void* data, const char* name)
+    {
+        bool is_mappable = (flags_memory & null_memory_mappable) != 0;
+        resource         = memory::allocate(size, is_mappable);
+
+        // if a pointer to the buffer data has been passed, copy it over
+        if (data)
+        {
+            SP_ASSERT_MSG(is_mappable, "Mapping initial data requires the buffer to be created with the null_memory_mappable flag");
+            memcpy(memory::get_data(resource), data, static_cast<size_t>(size));
+        }
+    }
+
+    void RHI_Device::MemoryBufferDestroy(void*& resource)
+    {
+        memory::free(resource);
+    }
+
+    void RHI_Device::MemoryTextureCreate(RHI_Texture* texture)
+    {
+        // account for the whole mip chain, so the reported usage is in the same ballpark as a real device
+        uint64_t size = 0;
+        for (uint32_t mip_index = 0; mip_index < texture->GetMipCount(); mip_index++)
+        {
+            uint32_t mip_width  = max(1u, texture->GetWidth()  >> mip_index);
+            uint32_t mip_height = max(1u, texture->GetHeight() >> mip_index);
+            uint32_t mip_depth  = texture->GetType() == RHI_Texture_Type::Type3D ? max(1u, texture->GetDepth() >> mip_index) : 1;
+            size               += RHI_Texture::CalculateMipSize(mip_width, mip_height, mip_depth, texture->GetFormat(), texture->GetBitsPerChannel(), texture->GetChannelCount());
+        }
+        if (texture->GetType() != RHI_Texture_Type::Type3D)
+        {
+            size *= texture->GetDepth();
+        }
+
+        bool is_mappable         = (texture->GetFlags() & RHI_Texture_Mappable) != 0;
+        texture->GetRhiResource() = memory::allocate(size, is_mappable);
+
+        // get mapped data pointer
+        if (is_mappable)
+        {
+            texture->GetMappedData() = memory::get_data(texture->GetRhiResource());
+        }
+    }
+
+    void RHI_Device::MemoryTextureDestroy(void*& resource)
+    {
+        memory::free(resource);
+    }
+
+    void RHI_Device::MemoryMap(void* resource, void*& mapped_data)
+    {
+        mapped_data = memory::get_data(resource);
+    }
+
+    void RHI_Device::MemoryUnmap(void* resource)
+    {
+
+    }
+
+    uint32_t RHI_Device::MemoryGetUsageMb()
+    {
+        lock_guard<mutex> lock(memory::mutex_allocations);
+        return static_cast<uint32_t>(memory::usage / 1024 / 1024);
+    }
+
+    uint32_t RHI_Device::MemoryGetBudgetMb()
+    {
+        return static_cast<uint32_t>(memory::budget / 1024 / 1024);
+    }
+
+    // immediate command list
+
+    RHI_CommandList* RHI_Device::CmdImmediateBegin(const RHI_Queue_Type queue_type)
+    {
+        // wait until it's safe to proceed
+        unique_lock<mutex> lock(queues::mutex_immediate_execution);
+        queues::condition_variable_immediate_execution.wait(lock, [] { return !queues::is_immediate_executing; });
+        queues::is_immediate_executing = true;
+        ProgressTracker::SetGlobalLoadingState(true);
+
+        // get command pool
+        queues::queue = queues::immediate[static_cast<uint32_t>(queue_type)].get();
+        RHI_CommandList* cmd_list = queues::queue->NextCommandList();
+        cmd_list->Begin();
+
+        return cmd_list;
+    }
+
+    void RHI_Device::CmdImmediateSubmit(RHI_CommandList* cmd_list)
+    {
+        cmd_list->Submit(nullptr, true);
+        cmd_list->WaitForExecution();
+
+        // signal that it's safe to proceed with the next ImmediateBegin()
+        queues::is_immediate_executing = false;
+        queues::condition_variable_immediate_execution.notify_one();
+        ProgressTracker::SetGlobalLoadingState(false);
+    }
+
+    // markers
+
+    void RHI_Device::MarkerBegin(RHI_CommandList* cmd_list, const char* name, const math::Vector4& color)
+    {
+
+    }
+
+    void RHI_Device::MarkerEnd(RHI_CommandList* cmd_list)
+    {
+
+    }
+
+    // misc
+
+    void RHI_Device::SetResourceName(void* resource, const RHI_Resource_Type resource_type, const char* name)
+    {
+
+    }
+
+    void RHI_Device::SetVariableRateShading(const RHI_CommandList* cmd_list, const bool enabled)
+    {
+
+    }
+}
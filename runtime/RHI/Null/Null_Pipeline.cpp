@@ -0,0 +1,90 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "pch.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Shader.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_Device.h"
+#include "../RHI_VendorTechnology.h"
+#include "../Core/Debugging.h"
+//=====================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace spartan
+{
+    RHI_Pipeline::RHI_Pipeline(RHI_PipelineState& pipeline_state, RHI_DescriptorSetLayout* descriptor_set_layout)
+    {
+        m_state = pipeline_state;
+
+        // shader stages
+        for (uint32_t i = 0; i < static_cast<uint32_t>(RHI_Shader_Type::Max); i++)
+        {
+            if (RHI_Shader* shader = m_state.shaders[i])
+            {
+                SP_ASSERT(shader->GetRhiResource() != nullptr);
+                SP_ASSERT(shader->GetEntryPoint() != nullptr);
+            }
+        }
+
+        // layout
+        {
+            SP_ASSERT(descriptor_set_layout->GetRhiResource() != nullptr);
+            for (size_t i = 0; i < static_cast<size_t>(RHI_Device_Bindless_Resource::Max); i++)
+            {
+                SP_ASSERT(RHI_Device::GetDescriptorSetLayout(static_cast<RHI_Device_Bindless_Resource>(i)) != nullptr);
+            }
+
+            for (const RHI_Descriptor& descriptor : descriptor_set_layout->GetDescriptors())
+            {
+                if (descriptor.type == RHI_Descriptor_Type::PushConstantBuffer)
+                {
+                    SP_ASSERT(descriptor.struct_size <= RHI_Device::PropertyGetMaxPushConstantSize());
+                }
+            }
+
+            m_rhi_resource_layout = null_handle();
+            RHI_Device::SetResourceName(m_rhi_resource_layout, RHI_Resource_Type::PipelineLayout, pipeline_state.name);
+        }
+
+        m_rhi_resource = null_handle();
+        RHI_Device::SetResourceName(m_rhi_resource, RHI_Resource_Type::Pipeline, pipeline_state.name);
+
+        if (Debugging::IsBreadcrumbsEnabled())
+        { 
+            RHI_VendorTechnology::Breadcrumbs_RegisterPipeline(this);
+        }
+    }
+
+    RHI_Pipeline::~RHI_Pipeline()
+    {
+        RHI_Device::DeletionQueueAdd(RHI_Resource_Type::Pipeline, m_rhi_resource);
+        m_rhi_resource = nullptr;
+
+        RHI_Device::DeletionQueueAdd(RHI_Resource_Type::PipelineLayout, m_rhi_resource_layout);
+        m_rhi_resource_layout = nullptr;
+    }
+}
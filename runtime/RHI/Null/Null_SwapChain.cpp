@@ -0,0 +1,215 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "Window.h"
+#include "../RHI_Device.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_SyncPrimitive.h"
+#include "../RHI_Queue.h"
+#include "../Display/Display.h"
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+namespace spartan
+{
+    RHI_SwapChain::RHI_SwapChain(
+        void* sdl_window,
+        const uint32_t width,
+        const uint32_t height,
+        const RHI_Present_Mode present_mode,
+        const uint32_t buffer_count,
+        const bool hdr,
+        const char* name
+    )
+    {
+        SP_ASSERT_MSG(RHI_Device::IsValidResolution(width, height), "Invalid resolution");
+        SP_ASSERT_MSG(buffer_count >= 2, "Buffer count can't be less than 2");
+    
+        m_format       = hdr ? format_hdr : format_sdr;
+        m_buffer_count = buffer_count;
+        m_width        = width;
+        m_height       = height;
+        m_sdl_window   = sdl_window;
+        m_object_name  = name;
+        m_present_mode = present_mode;
+
+        // there is nothing to present to, the surface only exists so the rest of the swapchain logic holds
+        m_rhi_surface = null_handle();
+
+        Create();
+    
+        m_event_handle_window_resized = SP_SUBSCRIBE_TO_EVENT(EventType::WindowResized, SP_EVENT_HANDLER(ResizeToWindowSize));
+    }
+
+    RHI_SwapChain::~RHI_SwapChain()
+    {
+        Event::Unsubscribe(m_event_handle_window_resized);
+
+        for (void*& image_view : m_rhi_rtv)
+        {
+            if (image_view)
+            {
+                RHI_Device::DeletionQueueAdd(RHI_Resource_Type::ImageView, image_view);
+                image_view = nullptr;
+            }
+        }
+    }
+
+    RHI_SyncPrimitive* RHI_SwapChain::GetImageAcquiredSemaphore() const
+    {
+        // when minimized, image acquisition is not needed, so return nullptr
+        return Window::IsMinimized() ? nullptr : m_image_acquired_semaphore[m_image_index].get();
+    }
+
+    void RHI_SwapChain::Create()
+    {
+        SP_ASSERT(m_sdl_window != nullptr);
+        SP_ASSERT(m_rhi_surface != nullptr);
+
+        RHI_Device::QueueWaitAll();
+
+        m_rhi_swapchain = null_handle();
+
+        // images and views
+        for (uint32_t i = 0; i < m_buffer_count; i++)
+        {
+            if (m_rhi_rtv[i])
+            { 
+                RHI_Device::DeletionQueueAdd(RHI_Resource_Type::ImageView, m_rhi_rtv[i]);
+            }
+
+            m_rhi_rt[i]  = null_handle();
+            m_rhi_rtv[i] = null_handle();
+        }
+
+        // sync primitives
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_image_acquired_semaphore.size()); i++)
+        {
+            m_image_acquired_semaphore[i] = make_shared<RHI_SyncPrimitive>(RHI_SyncPrimitive_Type::Semaphore, ("swapchain_" + to_string(i)).c_str());
+        }
+
+        SP_LOG_INFO(
+            "Swapchain created with resolution: %dx%d, HDR: %s (%s), VSync: %s",
+            m_width,
+            m_height,
+            m_format == format_hdr ? "enabled" : "disabled",
+            rhi_format_to_string(m_format),
+            m_present_mode == RHI_Present_Mode::Fifo ? "enabled" : "disabled"
+        );
+
+        m_image_index = 0;
+    }
+
+    void RHI_SwapChain::Resize(const uint32_t width, const uint32_t height)
+    {
+        SP_ASSERT(RHI_Device::IsValidResolution(width, height));
+
+        if (m_width == width && m_height == height)
+            return;
+
+        m_width  = width;
+        m_height = height;
+
+        Create();
+
+        SP_LOG_INFO("Resolution has been set to %dx%d", width, height);
+    }
+
+    void RHI_SwapChain::ResizeToWindowSize()
+    {
+        Resize(Window::GetWidth(), Window::GetHeight());
+    }
+
+    void RHI_SwapChain::AcquireNextImage()
+    {
+        if (Window::IsMinimized())
+            return;
+
+        RHI_SyncPrimitive* signal_semaphore = m_image_acquired_semaphore[semaphore_index].get();
+
+        // ensure the semaphore is free, same as a real swapchain would
+        if (RHI_CommandList* cmd_list = signal_semaphore->GetUserCmdList())
+        {
+            if (cmd_list->GetState() == RHI_CommandListState::Submitted)
+            { 
+                cmd_list->WaitForExecution();
+            }
+            SP_ASSERT(cmd_list->GetState() == RHI_CommandListState::Idle);
+        }
+
+        // images are handed out in order, there is no presentation engine to hold on to them
+        m_image_index                             = (m_image_index + 1) % m_buffer_count;
+        m_image_acquired_semaphore[m_image_index] = m_image_acquired_semaphore[semaphore_index];
+        semaphore_index                           = (semaphore_index + 1) % m_image_acquired_semaphore.size();
+    }
+    
+    void RHI_SwapChain::Present(RHI_CommandList* cmd_list_frame)
+    {
+        if (Window::IsMinimized())
+            return;
+
+        cmd_list_frame->GetQueue()->Present(m_rhi_swapchain, m_image_index, cmd_list_frame->GetRenderingCompleteSemaphore());
+
+        if (m_is_dirty)
+        {
+            Create();
+            m_is_dirty = false;
+        }
+    }
+
+    void RHI_SwapChain::SetHdr(const bool enabled)
+    {
+        if (enabled)
+        {
+            SP_ASSERT_MSG(Display::GetHdr(), "This display doesn't support HDR");
+        }
+    
+        RHI_Format new_format = enabled ? format_hdr : format_sdr;
+    
+        if (new_format != m_format)
+        {
+            m_format   = new_format;
+            m_is_dirty = true;
+        }
+    }
+
+    void RHI_SwapChain::SetVsync(const bool enabled)
+    {
+        if ((m_present_mode == RHI_Present_Mode::Fifo) != enabled)
+        {
+            m_present_mode = enabled ? RHI_Present_Mode::Fifo : RHI_Present_Mode::Immediate;
+            m_is_dirty     = true;
+            Timer::OnVsyncToggled(enabled);
+        }
+    }
+    
+    bool RHI_SwapChain::GetVsync()
+    {
+        return m_present_mode == RHI_Present_Mode::Fifo;
+    }
+}
@@ -0,0 +1,203 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Texture.h"
+#include "../RHI_CommandList.h"
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+namespace spartan
+{
+    namespace
+    {
+        void set_debug_name(RHI_Texture* texture)
+        {
+            const char* name = texture->GetObjectName().c_str();
+
+            RHI_Device::SetResourceName(texture->GetRhiResource(), RHI_Resource_Type::Image, name);
+
+            if (texture->IsSrv())
+            {
+                RHI_Device::SetResourceName(texture->GetRhiSrv(), RHI_Resource_Type::ImageView, name);
+            }
+
+            if (texture->HasPerMipViews())
+            {
+                for (uint32_t i = 0; i < texture->GetMipCount(); i++)
+                {
+                    RHI_Device::SetResourceName(texture->GetRhiSrvMip(i), RHI_Resource_Type::ImageView, name);
+                }
+            }
+        }
+
+        void stage(RHI_Texture* texture)
+        {
+            SP_ASSERT_MSG(texture->HasData(), "No data to stage");
+
+            // the data never leaves the cpu, but the image goes through the same transitions as an upload would
+            if (RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Graphics))
+            {
+                cmd_list->InsertBarrier(texture->GetRhiResource(), texture->GetFormat(), 0, texture->GetMipCount(), texture->GetDepth(), RHI_Image_Layout::Transfer_Destination);
+                RHI_Device::CmdImmediateSubmit(cmd_list);
+            }
+        }
+
+        RHI_Image_Layout GetAppropriateLayout(RHI_Texture* texture)
+        {
+            RHI_Image_Layout target_layout = RHI_Image_Layout::Preinitialized;
+
+            if (texture->IsRt())
+            {
+                target_layout = RHI_Image_Layout::Attachment;
+            }
+
+            if (texture->IsUav())
+                target_layout = RHI_Image_Layout::General;
+
+            if (texture->IsSrv())
+                target_layout = RHI_Image_Layout::Shader_Read;
+
+            return target_layout;
+        }
+    }
+
+    bool RHI_Texture::RHI_CreateResource()
+    {
+        SP_ASSERT_MSG(m_width  != 0, "Width can't be zero");
+        SP_ASSERT_MSG(m_height != 0, "Height can't be zero");
+
+        // create image
+        RHI_Device::MemoryTextureCreate(this);
+
+        // if the texture has any data, stage it
+        if (HasData())
+        {
+            stage(this);
+        }
+
+        // transition to target layout
+        if (RHI_CommandList* cmd_list = RHI_Device::CmdImmediateBegin(RHI_Queue_Type::Graphics))
+        {
+            uint32_t array_length = m_type == RHI_Texture_Type::Type3D ? 1 : m_depth;
+            cmd_list->InsertBarrier(
+                m_rhi_resource,
+                m_format,
+                0,            // mip start
+                m_mip_count,  // mip count
+                array_length, // array length
+                GetAppropriateLayout(this)
+            );
+        
+            // flush
+            RHI_Device::CmdImmediateSubmit(cmd_list);
+        }
+
+        // create image views
+        {
+            // shader resource views
+            if (IsSrv() || IsUav())
+            {
+                m_rhi_srv = null_handle();
+
+                if (HasPerMipViews())
+                {
+                    for (uint32_t i = 0; i < m_mip_count; i++)
+                    {
+                        m_rhi_srv_mips[i] = null_handle();
+                    }
+                }
+            }
+
+            // render target views
+            if (m_type == RHI_Texture_Type::Type2D || m_type == RHI_Texture_Type::Type2DArray || m_type == RHI_Texture_Type::TypeCube)
+            {
+                // both cube map slices/faces and array length is encoded into m_depth
+                for (uint32_t i = 0; i < m_depth; i++)
+                {
+                    if (IsRtv())
+                    {
+                        m_rhi_rtv[i] = null_handle();
+                    }
+
+                    if (IsDsv())
+                    {
+                        m_rhi_dsv[i] = null_handle();
+                    }
+                }
+            }
+            else if (m_type == RHI_Texture_Type::Type3D)
+            {
+                // for 3d textures, we create a single rtv for the entire volume
+                if (IsRtv())
+                {
+                    m_rhi_rtv[0] = null_handle();
+                }
+            }
+            else
+            {
+                SP_ASSERT_MSG(false, "Unknown resource type")
+            }
+
+            // name the image and image view(s)
+            set_debug_name(this);
+        }
+
+        return true;
+    }
+
+    void RHI_Texture::RHI_DestroyResource()
+    {
+        // srv and uav
+        {
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::ImageView, m_rhi_srv);
+            m_rhi_srv = nullptr;
+
+            for (uint32_t i = 0; i < m_mip_count; i++)
+            {
+                RHI_Device::DeletionQueueAdd(RHI_Resource_Type::ImageView, m_rhi_srv_mips[i]);
+                m_rhi_srv_mips[i] = nullptr;
+            }
+        }
+
+        // rtv and dsv
+        for (uint32_t i = 0; i < rhi_max_render_target_count; i++)
+        {
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::ImageView, m_rhi_dsv[i]);
+            m_rhi_dsv[i] = nullptr;
+
+            RHI_Device::DeletionQueueAdd(RHI_Resource_Type::ImageView, m_rhi_rtv[i]);
+            m_rhi_rtv[i] = nullptr;
+        }
+
+        // rhi resource
+        RHI_CommandList::RemoveLayout(m_rhi_resource);
+        RHI_Device::DeletionQueueAdd(RHI_Resource_Type::Image, m_rhi_resource);
+        m_rhi_resource = nullptr;
+    }
+}
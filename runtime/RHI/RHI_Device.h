@@ -56,7 +56,9 @@ namespace spartan
             RHI_Buffer* material_parameters,
             RHI_Buffer* light_parameters,
             const std::array<std::shared_ptr<RHI_Sampler>, static_cast<uint32_t>(Renderer_Sampler::Max)>* samplers,
-            RHI_Buffer* bindless_aabbs
+            RHI_Buffer* bindless_aabbs,
+            const uint32_t material_textures_start = 0,                 // only this range of material_textures is written
+            const uint32_t material_textures_count = rhi_max_array_size
         );
 
         // pipelines
@@ -387,6 +387,21 @@ static const char* vkresult_to_string(const VkResult result)
     
 #endif // API_GRAPHICS_VULKAN
 
+// definition - null
+#if defined(API_GRAPHICS_NULL)
+#include <atomic>
+
+// there are no api objects, every resource is identified by a unique opaque handle
+inline void* null_handle()
+{
+    static std::atomic<uint64_t> handle_count = 0;
+    return reinterpret_cast<void*>(static_cast<uintptr_t>(++handle_count));
+}
+
+// memory flags, mappable memory is backed by system memory, everything else is just a handle
+static const uint32_t null_memory_mappable = 1 << 0;
+#endif // API_GRAPHICS_NULL
+
 // RHI_Context
 #include "RHI_Definitions.h"
 namespace spartan
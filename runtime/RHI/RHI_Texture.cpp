@@ -27,9 +27,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../IO/FileStream.h"
 #include "../Resource/Import/ImageImporter.h"
 #include "../Core/ProgressTracker.h"
-SP_WARNINGS_OFF
-#include "compressonator.h"
-SP_WARNINGS_ON
+#include "../Resource/ResourceCache.h"
+#include "RHI_Texture_Processing.h"
 //===========================================
 
 //= NAMESPACES =====
@@ -63,113 +62,613 @@ namespace spartan
             return CMP_FORMAT::CMP_FORMAT_Unknown;
         }
 
-        void compress(RHI_Texture* texture, const uint32_t mip_index, const RHI_Format dest_format)
+        atomic<RHI_Texture_Compression_Quality> quality = RHI_Texture_Compression_Quality::Balanced;
+
+        CMP_CompressOptions get_options()
         {
-            // source texture
-            CMP_Texture source_texture = {};
-            source_texture.format      = to_cmp_format(texture->GetFormat());
-            source_texture.dwSize      = sizeof(CMP_Texture);
-            source_texture.dwWidth     = texture->GetWidth() >> mip_index;
-            source_texture.dwHeight    = texture->GetHeight() >> mip_index;
-            source_texture.dwPitch     = source_texture.dwWidth * texture->GetBytesPerPixel();
-            source_texture.dwDataSize  = static_cast<uint32_t>(texture->GetMip(0, mip_index).bytes.size());
-            source_texture.pData       = reinterpret_cast<uint8_t*>(texture->GetMip(0, mip_index).bytes.data());
+            CMP_CompressOptions options    = {};
+            options.dwSize                 = sizeof(CMP_CompressOptions);
+            options.nEncodeWith            = CMP_HPC; // set encoder
+            options.bDisableMultiThreading = true;    // tiles are distributed by the thread pool instead
+            options.dwnumThreads           = 1;
+
+            // bc7 trades speed for quality through fquality, bc1-5 through the speed setting which needs fquality at 0.05 to be respected
+            switch (quality.load())
+            {
+                case RHI_Texture_Compression_Quality::Fast:
+                    options.fquality          = 0.05f;
+                    options.nCompressionSpeed = CMP_Speed_SuperFast;
+                    break;
+                case RHI_Texture_Compression_Quality::High:
+                    options.fquality          = 0.6f;
+                    options.nCompressionSpeed = CMP_Speed_Normal;
+                    break;
+                default:
+                    options.fquality          = 0.05f;
+                    options.nCompressionSpeed = CMP_Speed_Normal;
+                    break;
+            }
 
-            // destination texture
-            CMP_Texture destination_texture = {};
-            destination_texture.format      = to_cmp_format(dest_format);
-            destination_texture.dwSize      = sizeof(CMP_Texture);
-            destination_texture.dwWidth     = source_texture.dwWidth;
-            destination_texture.dwHeight    = source_texture.dwHeight;
-            destination_texture.dwDataSize  = CMP_CalculateBufferSize(&destination_texture);
-            vector<byte> destination_data(destination_texture.dwDataSize);
-            destination_texture.pData       = reinterpret_cast<uint8_t*>(destination_data.data());
+            return options;
+        }
 
-            // compress texture
-            {
-                CMP_CompressOptions options = {};
-                options.dwSize              = sizeof(CMP_CompressOptions);
-                options.fquality            = 0.05f;                            // set for lower quality, faster compression
-                options.dwnumThreads        = ThreadPool::GetIdleThreadCount(); // use all free threads
-                options.nEncodeWith         = CMP_HPC;                          // set encoder
+        // the size of a compressed level, in whole block rows
+        size_t get_level_size(const uint32_t width, const uint32_t height)
+        {
+            return RHI_Texture::CalculateMipSize(width, 4, 1, destination_format, 0, 0) * ((height + 3) / 4);
+        }
 
-                SP_ASSERT(CMP_ConvertTexture(&source_texture, &destination_texture, &options, nullptr) == CMP_OK);
-            }
+        // splits a level into strips of block rows, each strip is a job, the options have to outlive the jobs
+        void add_level_jobs(const byte* source, byte* destination, const uint32_t width, const uint32_t height, const RHI_Format source_format, const uint32_t bytes_per_texel, const CMP_CompressOptions& options, vector<JobHandle>& jobs)
+        {
+            const uint32_t texels_per_tile     = 256 * 256;
+            const uint32_t block_row_count     = (height + 3) / 4;
+            const uint32_t block_row_size      = static_cast<uint32_t>(RHI_Texture::CalculateMipSize(width, 4, 1, destination_format, 0, 0));
+            const uint32_t block_rows_per_tile = max(1u, texels_per_tile / (width * 4));
 
-            // update texture with compressed data
-            texture->GetMip(0, mip_index).bytes = destination_data;
+            for (uint32_t block_row = 0; block_row < block_row_count; block_row += block_rows_per_tile)
+            {
+                jobs.emplace_back(ThreadPool::AddJob([=, &options]()
+                {
+                    const uint32_t tile_block_rows = min(block_rows_per_tile, block_row_count - block_row);
+
+                    CMP_Texture source_texture = {};
+                    source_texture.format      = to_cmp_format(source_format);
+                    source_texture.dwSize      = sizeof(CMP_Texture);
+                    source_texture.dwWidth     = width;
+                    source_texture.dwHeight    = min(tile_block_rows * 4, height - block_row * 4);
+                    source_texture.dwPitch     = width * bytes_per_texel;
+                    source_texture.dwDataSize  = source_texture.dwPitch * source_texture.dwHeight;
+                    source_texture.pData       = reinterpret_cast<uint8_t*>(const_cast<byte*>(source + static_cast<size_t>(block_row) * 4 * source_texture.dwPitch));
+
+                    CMP_Texture destination_texture = {};
+                    destination_texture.format      = to_cmp_format(destination_format);
+                    destination_texture.dwSize      = sizeof(CMP_Texture);
+                    destination_texture.dwWidth     = source_texture.dwWidth;
+                    destination_texture.dwHeight    = source_texture.dwHeight;
+                    destination_texture.dwDataSize  = tile_block_rows * block_row_size;
+                    destination_texture.pData       = reinterpret_cast<uint8_t*>(destination + static_cast<size_t>(block_row) * block_row_size);
+
+                    SP_ASSERT(CMP_ConvertTexture(&source_texture, &destination_texture, &options, nullptr) == CMP_OK);
+                }));
+            }
         }
 
         void compress(RHI_Texture* texture)
         {
             SP_ASSERT(texture != nullptr);
-
-            for (uint32_t mip_index = 0; mip_index < texture->GetMipCount(); mip_index++)
+            const Stopwatch timer;
+
+            // every mip of every slice is split into strips of block rows, each strip is a job, so the work of all the textures
+            // that are being prepared at the same time is spread across the thread pool
+            const CMP_CompressOptions options = get_options();
+            const RHI_Format source_format    = texture->GetFormat();
+            const uint32_t bytes_per_texel    = texture->GetBytesPerPixel();
+            uint64_t texel_count              = 0;
+
+            vector<vector<byte>> destinations;
+            vector<JobHandle> jobs;
+            for (uint32_t slice_index = 0; slice_index < texture->GetDepth(); slice_index++)
             {
-                compress(texture, mip_index, destination_format);
+                for (uint32_t mip_index = 0; mip_index < texture->GetSlice(slice_index).GetMipCount(); mip_index++)
+                {
+                    const uint32_t width  = max(1u, texture->GetWidth()  >> mip_index);
+                    const uint32_t height = max(1u, texture->GetHeight() >> mip_index);
+                    texel_count          += static_cast<uint64_t>(width) * height;
+
+                    destinations.emplace_back(get_level_size(width, height));
+                    add_level_jobs(texture->GetMip(slice_index, mip_index).bytes.data(), destinations.back().data(), width, height, source_format, bytes_per_texel, options, jobs);
+                }
             }
+            ThreadPool::Wait(jobs);
 
+            // update texture with compressed data
+            uint32_t destination_index = 0;
+            for (uint32_t slice_index = 0; slice_index < texture->GetDepth(); slice_index++)
+            {
+                for (uint32_t mip_index = 0; mip_index < texture->GetSlice(slice_index).GetMipCount(); mip_index++)
+                {
+                    texture->GetMip(slice_index, mip_index).bytes = move(destinations[destination_index++]);
+                }
+            }
             texture->SetFormat(destination_format);
+
+            const float duration_ms = max(timer.GetElapsedTimeMs(), 0.001f);
+            const float megapixels  = static_cast<float>(texel_count) / 1'000'000.0f;
+            SP_LOG_INFO("Compressed \"%s\", %.2f MP in %.1f ms (%.1f MP/s)", texture->GetObjectName().c_str(), megapixels, duration_ms, megapixels / (duration_ms / 1000.0f));
         }
     }
 
     namespace mips
     {
-        void downsample_bilinear(const vector<byte>& input, vector<byte>& output, uint32_t width, uint32_t height)
+        atomic<bool> high_quality = false; // import setting, see RHI_Texture::SetMipsHighQuality()
+
+        struct Tap
         {
-            constexpr uint32_t channels = 4; // RGBA32 - engine standard
-  
-            // calculate new dimensions (halving both width and height)
-            uint32_t new_width  = width  >> 1;
-            uint32_t new_height = height >> 1;
-            
-            // ensure minimum size
-            if (new_width < 1) new_width = 1;
-            if (new_height < 1) new_height = 1;
-            
-             // perform bilinear downsampling
-            for (uint32_t y = 0; y < new_height; y++)
+            int32_t offset; // source texel relative to 2x
+            float weight;
+        };
+
+        const vector<Tap>& get_taps(const Filter filter)
+        {
+            static const vector<Tap> box = { { 0, 0.5f }, { 1, 0.5f } };
+
+            static const vector<Tap> kaiser = []()
             {
-                for (uint32_t x = 0; x < new_width; x++)
+                const float radius = 2.0f; // in destination texels
+                const float alpha  = 4.0f;
+
+                auto bessel_i0 = [](float x)
                 {
-                    // calculate base indices for this 2x2 block
-                    uint32_t src_idx              = (y * 2 * width + x * 2) * channels;
-                    uint32_t src_idx_right        = src_idx + channels;                      // right pixel
-                    uint32_t src_idx_bottom       = src_idx + (width * channels);            // bottom pixel
-                    uint32_t src_idx_bottom_right = src_idx + (width * channels) + channels; // bottom-right pixel
-                    uint32_t dst_idx              = (y * new_width + x) * channels;
-
-                    // process all 4 channels (RGBA)
-                    for (uint32_t c = 0; c < channels; c++)
+                    float sum  = 1.0f;
+                    float term = 1.0f;
+                    for (uint32_t k = 1; k < 16; k++)
                     {
-                        uint32_t sum = to_integer<uint32_t>(input[src_idx + c]);
-                        uint32_t count = 1;
-            
-                        // right pixel
-                        if (x * 2 + 1 < width)
-                        {
-                            sum += to_integer<uint32_t>(input[src_idx_right + c]);
-                            count++;
-                        }
-            
-                        // bottom pixel
-                        if (y * 2 + 1 < height)
-                        {
-                            sum += to_integer<uint32_t>(input[src_idx_bottom + c]);
-                            count++;
-                        }
-            
-                        // bottom-right pixel
-                        if ((x * 2 + 1 < width) && (y * 2 + 1 < height))
+                        term *= (x * 0.5f / k) * (x * 0.5f / k);
+                        sum  += term;
+                    }
+                    return sum;
+                };
+
+                // the destination texel is centered between source texels 2x and 2x + 1
+                vector<Tap> taps;
+                float weight_sum = 0.0f;
+                for (int32_t offset = -3; offset <= 4; offset++)
+                {
+                    const float t      = (offset - 0.5f) * 0.5f;
+                    const float sinc   = sinf(math::pi * t) / (math::pi * t);
+                    const float window = bessel_i0(alpha * sqrtf(max(0.0f, 1.0f - (t / radius) * (t / radius)))) / bessel_i0(alpha);
+                    taps.push_back({ offset, sinc * window });
+                    weight_sum += sinc * window;
+                }
+
+                for (Tap& tap : taps)
+                {
+                    tap.weight /= weight_sum;
+                }
+
+                return taps;
+            }();
+
+            return filter == Filter::Kaiser ? kaiser : box;
+        }
+
+        float srgb_to_linear(const float value)
+        {
+            return value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        float linear_to_srgb(const float value)
+        {
+            return value <= 0.0031308f ? value * 12.92f : 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+        }
+
+        // tables for 8-bit srgb, encoding is indexed by the linear value quantized to 14 bits
+        const uint32_t srgb_encode_size = 1 << 14;
+
+        const array<float, 256> srgb_decode_table = []()
+        {
+            array<float, 256> values;
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                values[i] = srgb_to_linear(i / 255.0f);
+            }
+            return values;
+        }();
+
+        const array<uint8_t, srgb_encode_size> srgb_encode_table = []()
+        {
+            array<uint8_t, srgb_encode_size> values;
+            for (uint32_t i = 0; i < srgb_encode_size; i++)
+            {
+                values[i] = static_cast<uint8_t>(linear_to_srgb(i / static_cast<float>(srgb_encode_size - 1)) * 255.0f + 0.5f);
+            }
+            return values;
+        }();
+
+        float half_to_float(const uint16_t value)
+        {
+            const uint32_t sign     = static_cast<uint32_t>(value & 0x8000) << 16;
+            const uint32_t exponent = (value >> 10) & 0x1F;
+            const uint32_t mantissa = value & 0x3FF;
+
+            uint32_t bits;
+            if (exponent == 0)
+            {
+                // zero or subnormal, the latter is exactly mantissa * 2^-24
+                const float magnitude = mantissa * 5.9604644775390625e-8f;
+                memcpy(&bits, &magnitude, sizeof(bits));
+                bits |= sign;
+            }
+            else if (exponent == 31)
+            {
+                bits = sign | 0x7F800000 | (mantissa << 13);
+            }
+            else
+            {
+                bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+            }
+
+            float result;
+            memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        uint16_t float_to_half(const float value)
+        {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+
+            const uint16_t sign    = static_cast<uint16_t>((bits >> 16) & 0x8000);
+            const float magnitude = fabsf(value);
+            if (magnitude != magnitude)
+                return sign | 0x7E00;         // nan
+            if (magnitude >= 65520.0f)
+                return sign | 0x7C00;         // overflow to infinity
+            if (magnitude < 6.103515625e-5f)  // subnormal, rounded to nearest
+                return sign | static_cast<uint16_t>(magnitude * 16777216.0f + 0.5f);
+
+            // round to nearest even on the 13 dropped mantissa bits
+            const uint32_t magnitude_bits = bits & 0x7FFFFFFF;
+            const uint32_t rounded        = magnitude_bits + 0xFFF + ((magnitude_bits >> 13) & 1);
+            return sign | static_cast<uint16_t>((rounded - (112u << 23)) >> 13);
+        }
+
+        bool is_supported(const RHI_Format format)
+        {
+            return format == RHI_Format::R8G8B8A8_Unorm     ||
+                   format == RHI_Format::R16G16B16A16_Unorm ||
+                   format == RHI_Format::R16G16B16A16_Float ||
+                   format == RHI_Format::R32G32B32A32_Float;
+        }
+
+        // 8-bit rgba texels, rgb goes through the srgb tables when srgb is set and alpha is always linear
+        void decode_rgba8(const uint8_t* texel, float* output, const bool srgb)
+        {
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                output[c] = srgb ? srgb_decode_table[texel[c]] : texel[c] * (1.0f / 255.0f);
+            }
+            output[3] = texel[3] * (1.0f / 255.0f);
+        }
+
+    #ifdef __AVX2__
+        __m256 decode_rgba8_x2(const uint8_t* texels, const bool srgb)
+        {
+            uint64_t bytes;
+            memcpy(&bytes, texels, sizeof(bytes));
+            const __m256i indices = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<int64_t>(bytes)));
+            const __m256 linear   = _mm256_mul_ps(_mm256_cvtepi32_ps(indices), _mm256_set1_ps(1.0f / 255.0f));
+            if (!srgb)
+                return linear;
+
+            const __m256 mask_alpha = _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1));
+            return _mm256_blendv_ps(_mm256_i32gather_ps(srgb_decode_table.data(), indices, 4), linear, mask_alpha);
+        }
+    #endif
+
+        void encode_rgba8(const float* texel, uint8_t* output, const bool srgb)
+        {
+            // srgb channels are quantized to an index into the encoding table
+            const float scale_rgb = srgb ? static_cast<float>(srgb_encode_size - 1) : 255.0f;
+
+            alignas(16) int32_t quantized[4];
+        #ifdef __AVX2__
+            const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(texel), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            _mm_store_si128(reinterpret_cast<__m128i*>(quantized), _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_setr_ps(scale_rgb, scale_rgb, scale_rgb, 255.0f))));
+        #else
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                quantized[c] = static_cast<int32_t>(clamp(texel[c], 0.0f, 1.0f) * (c == 3 ? 255.0f : scale_rgb) + 0.5f);
+            }
+        #endif
+
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                output[c] = srgb ? srgb_encode_table[quantized[c]] : static_cast<uint8_t>(quantized[c]);
+            }
+            output[3] = static_cast<uint8_t>(quantized[3]);
+        }
+
+        void decode_row(const byte* input, float* output, const uint32_t width, const RHI_Format format, const bool srgb)
+        {
+            if (format == RHI_Format::R8G8B8A8_Unorm)
+            {
+                const uint8_t* values = reinterpret_cast<const uint8_t*>(input);
+                uint32_t i            = 0;
+            #ifdef __AVX2__
+                for (; i + 8 <= width * 4; i += 8)
+                {
+                    _mm256_storeu_ps(output + i, decode_rgba8_x2(values + i, srgb));
+                }
+            #endif
+                for (; i < width * 4; i += 4)
+                {
+                    decode_rgba8(values + i, output + i, srgb);
+                }
+            }
+            else if (format == RHI_Format::R16G16B16A16_Unorm)
+            {
+                for (uint32_t i = 0; i < width * 4; i++)
+                {
+                    uint16_t value;
+                    memcpy(&value, input + i * sizeof(uint16_t), sizeof(value));
+                    output[i] = value * (1.0f / 65535.0f);
+                    output[i] = (srgb && (i & 3) != 3) ? srgb_to_linear(output[i]) : output[i];
+                }
+            }
+            else if (format == RHI_Format::R16G16B16A16_Float)
+            {
+                uint32_t i = 0;
+            #ifdef __AVX2__
+                for (; i + 8 <= width * 4; i += 8)
+                {
+                    _mm256_storeu_ps(output + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * sizeof(uint16_t)))));
+                }
+            #endif
+                for (; i < width * 4; i++)
+                {
+                    uint16_t value;
+                    memcpy(&value, input + i * sizeof(uint16_t), sizeof(value));
+                    output[i] = half_to_float(value);
+                }
+            }
+            else
+            {
+                memcpy(output, input, width * 4 * sizeof(float));
+            }
+        }
+
+        void encode_row(const float* input, byte* output, const uint32_t width, const RHI_Format format, const bool srgb)
+        {
+            if (format == RHI_Format::R8G8B8A8_Unorm)
+            {
+                uint8_t* values = reinterpret_cast<uint8_t*>(output);
+                for (uint32_t i = 0; i < width * 4; i += 4)
+                {
+                    encode_rgba8(input + i, values + i, srgb);
+                }
+            }
+            else if (format == RHI_Format::R16G16B16A16_Unorm)
+            {
+                for (uint32_t i = 0; i < width * 4; i++)
+                {
+                    float value              = clamp(input[i], 0.0f, 1.0f);
+                    value                    = (srgb && (i & 3) != 3) ? linear_to_srgb(value) : value;
+                    const uint16_t quantized = static_cast<uint16_t>(value * 65535.0f + 0.5f);
+                    memcpy(output + i * sizeof(uint16_t), &quantized, sizeof(quantized));
+                }
+            }
+            else if (format == RHI_Format::R16G16B16A16_Float)
+            {
+                uint32_t i = 0;
+            #ifdef __AVX2__
+                for (; i + 8 <= width * 4; i += 8)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * sizeof(uint16_t)), _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT));
+                }
+            #endif
+                for (; i < width * 4; i++)
+                {
+                    const uint16_t value = float_to_half(input[i]);
+                    memcpy(output + i * sizeof(uint16_t), &value, sizeof(value));
+                }
+            }
+            else
+            {
+                memcpy(output, input, width * 4 * sizeof(float));
+            }
+        }
+
+        // horizontal pass, a decoded row (four floats per texel) is filtered down to width_output texels
+        void filter_row_horizontal(const float* input, float* output, const uint32_t width, const uint32_t width_output, const vector<Tap>& taps)
+        {
+            const int32_t tap_first = taps.front().offset;
+            const int32_t tap_last  = taps.back().offset;
+
+            // only texels near the edges have taps which need clamping
+            const uint32_t x_interior_start = min(width_output, static_cast<uint32_t>(max(0, -tap_first) + 1) / 2);
+            const uint32_t x_interior_end   = static_cast<int32_t>(width) > tap_last ? clamp((width - 1 - tap_last) / 2 + 1, x_interior_start, width_output) : x_interior_start;
+
+            auto filter = [&](uint32_t x_start, uint32_t x_end, bool clamped)
+            {
+                for (uint32_t x = x_start; x < x_end; x++)
+                {
+                    const int32_t center = static_cast<int32_t>(x * 2);
+
+                #ifdef __AVX2__
+                    __m128 sum = _mm_setzero_ps();
+                    for (const Tap& tap : taps)
+                    {
+                        const int32_t index = clamped ? clamp<int32_t>(center + tap.offset, 0, static_cast<int32_t>(width) - 1) : center + tap.offset;
+                        sum                 = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(input + index * 4), _mm_set1_ps(tap.weight)));
+                    }
+                    _mm_storeu_ps(output + x * 4, sum);
+                #else
+                    float sum[4] = {};
+                    for (const Tap& tap : taps)
+                    {
+                        const int32_t index = clamped ? clamp<int32_t>(center + tap.offset, 0, static_cast<int32_t>(width) - 1) : center + tap.offset;
+                        for (uint32_t c = 0; c < 4; c++)
                         {
-                            sum += to_integer<uint32_t>(input[src_idx_bottom_right + c]);
-                            count++;
+                            sum[c] += input[index * 4 + c] * tap.weight;
                         }
-            
-                        // assign the averaged result to the output
-                        output[dst_idx + c] = byte(sum / count);
                     }
+                    memcpy(output + x * 4, sum, sizeof(sum));
+                #endif
+                }
+            };
+
+            filter(0, x_interior_start, true);
+            filter(x_interior_start, x_interior_end, false);
+            filter(x_interior_end, width_output, true);
+        }
+
+        // vertical pass, a weighted sum of horizontally filtered rows, one per tap
+        void filter_row_vertical(const float* const* rows, float* output, const uint32_t float_count, const vector<Tap>& taps)
+        {
+            uint32_t i = 0;
+        #ifdef __AVX2__
+            for (; i + 8 <= float_count; i += 8)
+            {
+                __m256 sum = _mm256_setzero_ps();
+                for (uint32_t tap = 0; tap < taps.size(); tap++)
+                {
+                    sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(rows[tap] + i), _mm256_set1_ps(taps[tap].weight)));
+                }
+                _mm256_storeu_ps(output + i, sum);
+            }
+        #endif
+
+            for (; i < float_count; i++)
+            {
+                float sum = 0.0f;
+                for (uint32_t tap = 0; tap < taps.size(); tap++)
+                {
+                    sum += rows[tap][i] * taps[tap].weight;
+                }
+                output[i] = sum;
+            }
+        }
+
+        // 8-bit rgba box filter, every output texel is the average of a 2x2 block
+        // without srgb that's (a + b + c + d + 2) / 4 on integers, with srgb the average is taken in linear space
+        void downsample_row_rgba8_box(const uint8_t* row_0, const uint8_t* row_1, uint8_t* output, const uint32_t width, const uint32_t width_output, const bool srgb)
+        {
+            uint32_t x = 0;
+        #ifdef __AVX2__
+            if (srgb)
+            {
+                // 2 output texels per iteration, from 4 input texels of each row
+                for (; x + 2 <= width_output && (x * 2 + 4) <= width; x += 2)
+                {
+                    const __m256 sum_01  = _mm256_add_ps(decode_rgba8_x2(row_0 + x * 8,     true), decode_rgba8_x2(row_1 + x * 8,     true));
+                    const __m256 sum_23  = _mm256_add_ps(decode_rgba8_x2(row_0 + x * 8 + 8, true), decode_rgba8_x2(row_1 + x * 8 + 8, true));
+                    alignas(16) float texels[8];
+                    _mm_store_ps(texels,     _mm_mul_ps(_mm_add_ps(_mm256_castps256_ps128(sum_01), _mm256_extractf128_ps(sum_01, 1)), _mm_set1_ps(0.25f)));
+                    _mm_store_ps(texels + 4, _mm_mul_ps(_mm_add_ps(_mm256_castps256_ps128(sum_23), _mm256_extractf128_ps(sum_23, 1)), _mm_set1_ps(0.25f)));
+                    encode_rgba8(texels,     output + x * 4,     true);
+                    encode_rgba8(texels + 4, output + x * 4 + 4, true);
+                }
+            }
+            else
+            {
+                // 4 output texels per iteration, from 8 input texels of each row
+                const __m128i rounding = _mm_set1_epi16(2);
+                for (; x + 4 <= width_output && (x * 2 + 8) <= width; x += 4)
+                {
+                    __m256i sum_01 = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row_0 + x * 8))),      _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row_1 + x * 8))));
+                    __m256i sum_23 = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row_0 + x * 8 + 16))), _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row_1 + x * 8 + 16))));
+
+                    // add horizontal neighbours, each 128-bit lane holds two texels and ends up with their sum in its low half
+                    sum_01 = _mm256_add_epi16(sum_01, _mm256_srli_si256(sum_01, 8));
+                    sum_23 = _mm256_add_epi16(sum_23, _mm256_srli_si256(sum_23, 8));
+                    sum_01 = _mm256_permute4x64_epi64(sum_01, _MM_SHUFFLE(3, 1, 2, 0));
+                    sum_23 = _mm256_permute4x64_epi64(sum_23, _MM_SHUFFLE(3, 1, 2, 0));
+
+                    const __m128i texels_01 = _mm_srli_epi16(_mm_add_epi16(_mm256_castsi256_si128(sum_01), rounding), 2);
+                    const __m128i texels_23 = _mm_srli_epi16(_mm_add_epi16(_mm256_castsi256_si128(sum_23), rounding), 2);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + x * 4), _mm_packus_epi16(texels_01, texels_23));
+                }
+            }
+        #endif
+
+            for (; x < width_output; x++)
+            {
+                const uint32_t x0 = x * 2 * 4;
+                const uint32_t x1 = min(x * 2 + 1, width - 1) * 4;
+                if (srgb)
+                {
+                    float texels[4][4];
+                    decode_rgba8(row_0 + x0, texels[0], true);
+                    decode_rgba8(row_0 + x1, texels[1], true);
+                    decode_rgba8(row_1 + x0, texels[2], true);
+                    decode_rgba8(row_1 + x1, texels[3], true);
+
+                    float average[4];
+                    for (uint32_t c = 0; c < 4; c++)
+                    {
+                        average[c] = (texels[0][c] + texels[1][c] + texels[2][c] + texels[3][c]) * 0.25f;
+                    }
+                    encode_rgba8(average, output + x * 4, true);
+                }
+                else
+                {
+                    for (uint32_t c = 0; c < 4; c++)
+                    {
+                        output[x * 4 + c] = static_cast<uint8_t>((row_0[x0 + c] + row_0[x1 + c] + row_1[x0 + c] + row_1[x1 + c] + 2) >> 2);
+                    }
+                }
+            }
+        }
+
+        void downsample(const vector<byte>& input, vector<byte>& output, const uint32_t width, const uint32_t height, const RHI_Format format, const bool srgb, const Filter filter)
+        {
+            SP_ASSERT(is_supported(format));
+
+            const uint32_t width_output    = max(1u, width  >> 1);
+            const uint32_t height_output   = max(1u, height >> 1);
+            const uint32_t bytes_per_texel = static_cast<uint32_t>(RHI_Texture::CalculateMipSize(1, 1, 1, format, rhi_format_to_bits_per_channel(format), 4));
+            const vector<Tap>& taps        = get_taps(filter);
+            const uint32_t tap_count       = static_cast<uint32_t>(taps.size());
+
+            auto source_row = [&](int32_t y)
+            {
+                return &input[static_cast<size_t>(clamp<int32_t>(y, 0, static_cast<int32_t>(height) - 1)) * width * bytes_per_texel];
+            };
+
+            auto downsample_rows = [&](uint32_t y_start, uint32_t y_end)
+            {
+                if (format == RHI_Format::R8G8B8A8_Unorm && filter == Filter::Box)
+                {
+                    for (uint32_t y = y_start; y < y_end; y++)
+                    {
+                        downsample_row_rgba8_box(
+                            reinterpret_cast<const uint8_t*>(source_row(y * 2)),
+                            reinterpret_cast<const uint8_t*>(source_row(y * 2 + 1)),
+                            reinterpret_cast<uint8_t*>(&output[static_cast<size_t>(y) * width_output * 4]),
+                            width,
+                            width_output,
+                            srgb
+                        );
+                    }
+                    return;
                 }
+
+                // horizontally filtered rows live in a ring with one slot per tap, consecutive output rows share all but two of them
+                vector<float> row_decoded(width * 4);
+                vector<float> ring(static_cast<size_t>(tap_count) * width_output * 4);
+                vector<float> row_output(width_output * 4);
+                vector<const float*> rows(tap_count);
+                auto ring_slot = [&](int32_t y) { return &ring[static_cast<size_t>((y % static_cast<int32_t>(tap_count) + tap_count) % tap_count) * width_output * 4]; };
+
+                int32_t row_next = static_cast<int32_t>(y_start * 2) + taps.front().offset;
+                for (uint32_t y = y_start; y < y_end; y++)
+                {
+                    for (; row_next <= static_cast<int32_t>(y * 2) + taps.back().offset; row_next++)
+                    {
+                        decode_row(source_row(row_next), row_decoded.data(), width, format, srgb);
+                        filter_row_horizontal(row_decoded.data(), ring_slot(row_next), width, width_output, taps);
+                    }
+
+                    for (uint32_t tap = 0; tap < tap_count; tap++)
+                    {
+                        rows[tap] = ring_slot(static_cast<int32_t>(y * 2) + taps[tap].offset);
+                    }
+                    filter_row_vertical(rows.data(), row_output.data(), width_output * 4, taps);
+
+                    encode_row(row_output.data(), &output[static_cast<size_t>(y) * width_output * bytes_per_texel], width_output, format, srgb);
+                }
+            };
+
+            // small levels aren't worth distributing
+            if (height_output >= 64 && static_cast<uint64_t>(width_output) * height_output >= 64 * 64)
+            {
+                ThreadPool::ParallelLoop(downsample_rows, height_output);
+            }
+            else
+            {
+                downsample_rows(0, height_output);
             }
         }
 
@@ -189,6 +688,131 @@ namespace spartan
         }
     }
 
+    namespace cooked_texture
+    {
+        // a plain dds file (with the dx10 extension) so any dds reader can open it, engine metadata lives in the header's reserved words
+        const uint32_t dds_magic = 0x20534444; // "DDS "
+        const uint32_t magic     = 0x58545053; // "SPTX"
+        const uint32_t version   = 1;
+        mutex mutex_save;
+
+        struct Header
+        {
+            uint32_t dds_magic                = cooked_texture::dds_magic;
+
+            // DDS_HEADER
+            uint32_t size                     = 124;
+            uint32_t flags                    = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; // caps, height, width, pixel format, mip count, linear size
+            uint32_t height                   = 0;
+            uint32_t width                    = 0;
+            uint32_t linear_size              = 0;
+            uint32_t depth                    = 0;
+            uint32_t mip_count                = 0;
+            uint32_t engine_magic             = magic; // dwReserved1[11] starts here
+            uint32_t engine_version           = version;
+            uint32_t source_key[2]            = {};
+            uint32_t checksum[2]              = {};
+            uint32_t texture_flags            = 0;
+            uint32_t channel_count            = 0;
+            uint32_t bits_per_channel         = 0;
+            uint32_t reserved[2]              = {};
+
+            // DDS_PIXELFORMAT
+            uint32_t pixel_format_size        = 32;
+            uint32_t pixel_format_flags       = 0x4;        // four cc
+            uint32_t pixel_format_four_cc     = 0x30315844; // "DX10"
+            uint32_t pixel_format_unused[5]   = {};
+
+            uint32_t caps                     = 0x1000;     // texture
+            uint32_t caps_unused[4]           = {};
+
+            // DDS_HEADER_DXT10
+            uint32_t dxgi_format              = 0;
+            uint32_t resource_dimension       = 3;          // texture 2d
+            uint32_t misc_flags               = 0;
+            uint32_t array_size               = 1;
+            uint32_t misc_flags2              = 0;
+        };
+        static_assert(sizeof(Header) == 4 + 124 + 20);
+
+        // only what can come out of loading and processing, everything else isn't cooked
+        const array<pair<RHI_Format, uint32_t>, 19> dxgi_formats =
+        {{
+            { RHI_Format::R8_Unorm,           61 },
+            { RHI_Format::R16_Unorm,          56 },
+            { RHI_Format::R16_Float,          54 },
+            { RHI_Format::R32_Float,          41 },
+            { RHI_Format::R8G8_Unorm,         49 },
+            { RHI_Format::R16G16_Float,       34 },
+            { RHI_Format::R32G32_Float,       16 },
+            { RHI_Format::R11G11B10_Float,    26 },
+            { RHI_Format::R32G32B32_Float,     6 },
+            { RHI_Format::R8G8B8A8_Unorm,     28 },
+            { RHI_Format::R10G10B10A2_Unorm,  24 },
+            { RHI_Format::R16G16B16A16_Unorm, 11 },
+            { RHI_Format::R16G16B16A16_Snorm, 13 },
+            { RHI_Format::R16G16B16A16_Float, 10 },
+            { RHI_Format::R32G32B32A32_Float,  2 },
+            { RHI_Format::BC1_Unorm,          71 },
+            { RHI_Format::BC3_Unorm,          77 },
+            { RHI_Format::BC5_Unorm,          83 },
+            { RHI_Format::BC7_Unorm,          98 }
+        }};
+
+        uint32_t to_dxgi_format(const RHI_Format format)
+        {
+            for (const auto& [rhi_format, dxgi_format] : dxgi_formats)
+            {
+                if (rhi_format == format)
+                    return dxgi_format;
+            }
+
+            return 0;
+        }
+
+        RHI_Format to_rhi_format(const uint32_t format)
+        {
+            for (const auto& [rhi_format, dxgi_format] : dxgi_formats)
+            {
+                if (dxgi_format == format)
+                    return rhi_format;
+            }
+
+            return RHI_Format::Max;
+        }
+
+        // flags that the importer deduces, a cooked texture skips the importer so it has to restore them
+        const uint32_t flags_deduced = RHI_Texture_Greyscale | RHI_Texture_Transparent | RHI_Texture_Srgb;
+
+        // anything that affects the processed data has to be part of the key
+        uint64_t get_key(const uint64_t source_hash, const RHI_Texture* texture)
+        {
+            // the compression settings only shape textures that get compressed (same conditions as PrepareForGpu()),
+            // hdr and uncompressed textures keep their entries when the settings change
+            const bool is_compressed = (texture->GetFlags() & RHI_Texture_Compress) && !RHI_Texture::IsCompressedFormat(texture->GetFormat()) && texture->IsMaterialTexture();
+            const uint64_t settings[] =
+            {
+                source_hash,
+                texture->GetFlags() & (RHI_Texture_Compress | RHI_Texture_Thumbnail | RHI_Texture_MipsHighQuality),
+                texture->GetWidth(),
+                texture->GetHeight(),
+                static_cast<uint64_t>(texture->GetFormat()),
+                is_compressed ? static_cast<uint64_t>(compressonator::destination_format) : 0,
+                is_compressed ? static_cast<uint64_t>(compressonator::quality.load()) : 0,
+                version
+            };
+
+            return FileSystem::HashBytes(settings, sizeof(settings));
+        }
+
+        string get_file_path(const uint64_t key)
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+            return ResourceCache::GetCacheDirectory() + "textures/" + name + ".dds";
+        }
+    }
+
     RHI_Texture::RHI_Texture() : IResource(ResourceType::Texture)
     {
 
@@ -241,7 +865,133 @@ namespace spartan
 
     void RHI_Texture::SaveToFile(const string& file_path)
     {
-        SP_LOG_WARNING("Saving custom textures to file is not supported (or needed) yet.");
+        SaveCooked(file_path);
+    }
+
+    bool RHI_Texture::SaveCooked(const string& file_path, const uint64_t source_key /*= 0*/)
+    {
+        const uint32_t dxgi_format = cooked_texture::to_dxgi_format(m_format);
+        if (!HasData() || dxgi_format == 0 || m_slices.size() != 1 || m_type != RHI_Texture_Type::Type2D)
+            return false;
+
+        // the mips have to be exactly what loading expects
+        const vector<RHI_Texture_Mip>& mips = m_slices[0].mips;
+        uint64_t checksum                   = 0;
+        for (uint32_t mip_index = 0; mip_index < static_cast<uint32_t>(mips.size()); mip_index++)
+        {
+            const size_t size = CalculateMipSize(max(1u, m_width >> mip_index), max(1u, m_height >> mip_index), 1, m_format, m_bits_per_channel, m_channel_count);
+            if (mips[mip_index].bytes.size() != size)
+                return false;
+
+            checksum = FileSystem::HashBytes(mips[mip_index].bytes.data(), size, checksum);
+        }
+
+        cooked_texture::Header header;
+        header.width            = m_width;
+        header.height           = m_height;
+        header.mip_count        = static_cast<uint32_t>(mips.size());
+        header.linear_size      = static_cast<uint32_t>(mips[0].bytes.size());
+        header.source_key[0]    = static_cast<uint32_t>(source_key);
+        header.source_key[1]    = static_cast<uint32_t>(source_key >> 32);
+        header.checksum[0]      = static_cast<uint32_t>(checksum);
+        header.checksum[1]      = static_cast<uint32_t>(checksum >> 32);
+        header.texture_flags    = m_flags & cooked_texture::flags_deduced;
+        header.channel_count    = m_channel_count;
+        header.bits_per_channel = m_bits_per_channel;
+        header.dxgi_format      = dxgi_format;
+        header.caps            |= header.mip_count > 1 ? (0x8 | 0x400000) : 0; // complex, mip map
+
+        // through a temporary file, loading maps the cooked texture and must never see a torn or truncated one
+        FileSystem::CreateDirectory_(FileSystem::GetDirectoryFromFilePath(file_path));
+        const string file_path_temp = file_path + ".tmp";
+        bool is_written             = false;
+        {
+            FileStream file(file_path_temp, FileStream_Write);
+            if (file.IsOpen())
+            {
+                file.WriteBytes(&header, sizeof(header));
+                for (const RHI_Texture_Mip& mip : mips)
+                {
+                    file.WriteBytes(mip.bytes.data(), mip.bytes.size());
+                }
+                file.Close();
+                is_written = true;
+            }
+        }
+
+        if (!is_written || !FileSystem::Rename(file_path_temp, file_path))
+        {
+            FileSystem::Delete(file_path_temp);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool RHI_Texture::LoadCooked(const string& file_path, const uint64_t source_key /*= 0*/)
+    {
+        if (!FileSystem::Exists(file_path))
+            return false;
+
+        // map the whole file, mips are copied straight out of the mapping
+        FileStream file(file_path, FileStream_Read);
+        if (!file.IsOpen() || file.GetSize() < sizeof(cooked_texture::Header))
+            return false;
+
+        span<const byte> buffer = file.ViewBytes(file.GetSize());
+
+        // validate header
+        cooked_texture::Header header;
+        memcpy(&header, buffer.data(), sizeof(header));
+        if (header.dds_magic != cooked_texture::dds_magic || header.engine_magic != cooked_texture::magic || header.engine_version != cooked_texture::version)
+        {
+            SP_LOG_WARNING("\"%s\" is not a cooked texture or was cooked by a different version", file_path.c_str());
+            return false;
+        }
+
+        const uint64_t header_key = static_cast<uint64_t>(header.source_key[0]) | (static_cast<uint64_t>(header.source_key[1]) << 32);
+        if (source_key != 0 && header_key != source_key)
+            return false;
+
+        const RHI_Format format = cooked_texture::to_rhi_format(header.dxgi_format);
+        if (format == RHI_Format::Max || header.width == 0 || header.height == 0 || header.mip_count == 0 || header.mip_count > rhi_max_mip_count)
+            return false;
+
+        // validate data
+        span<const byte> data = buffer.subspan(sizeof(header));
+        uint64_t data_size    = 0;
+        for (uint32_t mip_index = 0; mip_index < header.mip_count; mip_index++)
+        {
+            data_size += CalculateMipSize(max(1u, header.width >> mip_index), max(1u, header.height >> mip_index), 1, format, header.bits_per_channel, header.channel_count);
+        }
+
+        const uint64_t checksum = static_cast<uint64_t>(header.checksum[0]) | (static_cast<uint64_t>(header.checksum[1]) << 32);
+        if (data_size != data.size() || FileSystem::HashBytes(data.data(), data.size()) != checksum)
+        {
+            SP_LOG_ERROR("\"%s\" is corrupted", file_path.c_str());
+            return false;
+        }
+
+        // copy
+        ClearData();
+        m_type              = RHI_Texture_Type::Type2D;
+        m_width             = header.width;
+        m_height            = header.height;
+        m_format            = format;
+        m_channel_count     = header.channel_count;
+        m_bits_per_channel  = header.bits_per_channel;
+        m_flags            |= header.texture_flags & cooked_texture::flags_deduced;
+        uint64_t offset     = 0;
+        for (uint32_t mip_index = 0; mip_index < header.mip_count; mip_index++)
+        {
+            AllocateMip();
+            vector<byte>& bytes = m_slices[0].mips[mip_index].bytes;
+            memcpy(bytes.data(), data.data() + offset, bytes.size());
+            offset += bytes.size();
+        }
+        m_is_cooked = true;
+
+        return true;
     }
 
     void RHI_Texture::LoadFromFile(const string& file_path)
@@ -264,10 +1014,27 @@ namespace spartan
         m_type            = RHI_Texture_Type::Type2D;
         m_depth           = 1;
         m_flags          |= RHI_Texture_Srv;
-        m_object_name     = FileSystem::GetFileNameFromFilePath(file_path);
         m_resource_state  = ResourceState::LoadingFromDrive;
+        m_is_cooked       = false;
+        m_cooked_key      = 0;
+        SetObjectName(FileSystem::GetFileNameFromFilePath(file_path)); // through the resource, so the cache's name lookup follows
 
-        ImageImporter::Load(file_path, 0, this);
+        // textures that are prepared right away can be cooked by the contents of their file, this skips decoding as well
+        // textures that are modified before being prepared (e.g. packed by a material) are cooked by their contents when prepared
+        if (!(m_flags & RHI_Texture_DontPrepareForGpu))
+        {
+            FileStream file(file_path, FileStream_Read);
+            if (file.IsOpen())
+            {
+                span<const byte> bytes = file.ViewBytes(file.GetSize());
+                m_cooked_key           = cooked_texture::get_key(FileSystem::HashBytes(bytes.data(), bytes.size()), this);
+            }
+        }
+
+        if (m_cooked_key == 0 || !LoadCooked(cooked_texture::get_file_path(m_cooked_key), m_cooked_key))
+        {
+            ImageImporter::Load(file_path, 0, this);
+        }
 
         // set resource file path so it can be used by the resource cache.
         SetResourceFilePath(file_path);
@@ -386,25 +1153,45 @@ namespace spartan
         bool is_not_compressed   = !IsCompressedFormat();                      // the bistro world loads pre-compressed textures
         bool is_material_texture = IsMaterialTexture();                        // render targets or textures which are written to in compute passes, don't need mip and compression
         bool can_be_prepared     = !(m_flags & RHI_Texture_DontPrepareForGpu); // some textures delay preperation because the material packs their data in a custom way before preparing them
+        bool is_hdr_texture      = mips::is_supported(m_format) && m_format != RHI_Format::R8G8B8A8_Unorm && m_type == RHI_Texture_Type::Type2D && // hdr images get a mip chain but aren't compressed
+                                   m_channel_count == 4 && m_slices.size() == 1 && !(IsRt() || IsUav());
+        bool is_processed        = is_not_compressed && (is_material_texture || is_hdr_texture);
 
         if (can_be_prepared)
         { 
-            if (is_not_compressed && is_material_texture)
+            // processing is cached, by the source file if there is one or by the data itself
+            bool is_cooked = m_is_cooked;
+            if (!is_cooked && is_processed && HasData())
+            {
+                if (m_cooked_key == 0)
+                {
+                    const vector<byte>& bytes = m_slices[0].mips[0].bytes;
+                    m_cooked_key              = cooked_texture::get_key(FileSystem::HashBytes(bytes.data(), bytes.size()), this);
+                }
+
+                is_cooked = LoadCooked(cooked_texture::get_file_path(m_cooked_key), m_cooked_key);
+            }
+
+            if (!is_cooked && is_processed)
             {
                 SP_ASSERT(!m_slices.empty());
                 SP_ASSERT(!m_slices.front().mips.empty());
 
                 // generate mip chain
-                uint32_t mip_count = mips::compute_count(m_width, m_height);
+                uint32_t mip_count        = mips::compute_count(m_width, m_height);
+                const mips::Filter filter = (m_flags & RHI_Texture_MipsHighQuality) ? mips::Filter::Kaiser : mips::Filter::Box;
                 for (uint32_t mip_index = 1; mip_index < mip_count; mip_index++)
                 {
                     AllocateMip();
 
-                    mips::downsample_bilinear(
+                    mips::downsample(
                         m_slices[0].mips[mip_index - 1].bytes, // larger
                         m_slices[0].mips[mip_index].bytes,     // smaller
                         max(1u, m_width  >> (mip_index - 1)),  // larger width
-                        max(1u, m_height >> (mip_index - 1))   // larger height
+                        max(1u, m_height >> (mip_index - 1)),  // larger height
+                        m_format,
+                        m_flags & RHI_Texture_Srgb,
+                        filter
                     );
                 }
 
@@ -440,10 +1227,21 @@ namespace spartan
                 // compress
                 bool compress       = m_flags & RHI_Texture_Compress;
                 bool not_compressed = !IsCompressedFormat();
-                if (compress && not_compressed)
+                if (compress && not_compressed && is_material_texture)
                 {
                     compressonator::compress(this);
                 }
+
+                // textures with identical data can be prepared concurrently, the first one to finish cooks it
+                if (m_cooked_key != 0)
+                {
+                    lock_guard lock(cooked_texture::mutex_save);
+                    const string file_path = cooked_texture::get_file_path(m_cooked_key);
+                    if (!FileSystem::Exists(file_path))
+                    {
+                        SaveCooked(file_path, m_cooked_key);
+                    }
+                }
             }
             
             // upload to gpu
@@ -474,6 +1272,27 @@ namespace spartan
         SP_LOG_INFO("Screenshot has been saved");
     }
 
+    void RHI_Texture::SetCompressionQuality(const RHI_Texture_Compression_Quality quality)
+    {
+        SP_ASSERT(quality < RHI_Texture_Compression_Quality::Max);
+        compressonator::quality = quality;
+    }
+
+    RHI_Texture_Compression_Quality RHI_Texture::GetCompressionQuality()
+    {
+        return compressonator::quality;
+    }
+
+    void RHI_Texture::SetMipsHighQuality(const bool enabled)
+    {
+        mips::high_quality = enabled;
+    }
+
+    bool RHI_Texture::GetMipsHighQuality()
+    {
+        return mips::high_quality;
+    }
+
     bool RHI_Texture::IsCompressedFormat(const RHI_Format format)
     {
         return
@@ -55,7 +55,17 @@ namespace spartan
         RHI_Texture_Compress          = 1U << 11,
         RHI_Texture_ExternalMemory    = 1U << 12,
         RHI_Texture_DontPrepareForGpu = 1U << 13,
-        RHI_Texture_Thumbnail         = 1U << 14
+        RHI_Texture_Thumbnail         = 1U << 14,
+        RHI_Texture_MipsHighQuality   = 1U << 15  // mips are filtered with a kaiser windowed sinc instead of a box
+    };
+
+    // speed/quality trade-off of block compression
+    enum class RHI_Texture_Compression_Quality : uint32_t
+    {
+        Fast,     // quickest, for iterating on content
+        Balanced, // the default
+        High,     // slowest, for shipping
+        Max
     };
 
     struct RHI_Texture_Mip
@@ -91,6 +101,11 @@ namespace spartan
         void SaveToFile(const std::string& file_path) override;
         void LoadFromFile(const std::string& file_path) override;
 
+        // cooked data is the final mip chain in a dds container, loading it skips decoding, mip generation and compression
+        // the source key identifies what the data was cooked from, loading fails if it doesn't match (0 matches anything)
+        bool SaveCooked(const std::string& file_path, const uint64_t source_key = 0);
+        bool LoadCooked(const std::string& file_path, const uint64_t source_key = 0);
+
         uint32_t GetWidth() const           { return m_width; }
         void SetWidth(const uint32_t width) { m_width = width; }
 
@@ -110,6 +125,14 @@ namespace spartan
         static bool IsCompressedFormat(const RHI_Format format);
         bool IsCompressedFormat()               { return IsCompressedFormat(m_format); }
 
+        // compression quality, applies to every texture that's compressed from then on
+        static void SetCompressionQuality(const RHI_Texture_Compression_Quality quality);
+        static RHI_Texture_Compression_Quality GetCompressionQuality();
+
+        // high quality mips, material textures imported from then on get RHI_Texture_MipsHighQuality
+        static void SetMipsHighQuality(const bool enabled);
+        static bool GetMipsHighQuality();
+
         // external memory
         void* GetExternalMemoryHandle() const      { return m_rhi_external_memory; }
         void SetExternalMemoryHandle(void* handle) { m_rhi_external_memory = handle; }
@@ -198,5 +221,8 @@ namespace spartan
 
     private:
         void ComputeMemoryUsage();
+
+        uint64_t m_cooked_key = 0;     // what the processed data is cooked under, 0 if it hasn't been determined yet
+        bool m_is_cooked      = false; // the data came from the cooked texture cache and needs no processing
     };
 }
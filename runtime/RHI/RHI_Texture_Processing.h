@@ -0,0 +1,61 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ====================
+#include <vector>
+#include "RHI_Definitions.h"
+#include "../Core/ThreadPool.h"
+SP_WARNINGS_OFF
+#include "compressonator.h"
+SP_WARNINGS_ON
+//===============================
+
+// the cpu side processing that textures go through on import (mips and compression), defined in RHI_Texture.cpp
+// and declared here so that the benchmarks can run it on synthetic data
+
+namespace spartan
+{
+    namespace compressonator
+    {
+        extern RHI_Format destination_format;
+
+        CMP_FORMAT to_cmp_format(const RHI_Format format);
+        CMP_CompressOptions get_options();
+        size_t get_level_size(const uint32_t width, const uint32_t height);
+        void add_level_jobs(const std::byte* source, std::byte* destination, const uint32_t width, const uint32_t height, const RHI_Format source_format, const uint32_t bytes_per_texel, const CMP_CompressOptions& options, std::vector<JobHandle>& jobs);
+    }
+
+    namespace mips
+    {
+        // levels are filtered separably in linear space on four floats per texel, formats are decoded and encoded around that
+        // the common case, 8-bit rgba with a box filter, averages 2x2 blocks directly, on integers when it isn't srgb
+        enum class Filter
+        {
+            Box,    // 2x2 average
+            Kaiser, // kaiser windowed sinc, sharper and with less aliasing, it can ring a little
+        };
+
+        void downsample(const std::vector<std::byte>& input, std::vector<std::byte>& output, const uint32_t width, const uint32_t height, const RHI_Format format, const bool srgb, const Filter filter);
+        uint32_t compute_count(uint32_t width, uint32_t height);
+    }
+}
@@ -1029,7 +1029,7 @@ namespace spartan
                 RHI_Device::SetResourceName(static_cast<void*>(*descriptor_set), RHI_Resource_Type::DescriptorSet, name);
             }
 
-            void update(void* data, const uint32_t count, const uint32_t slot, const RHI_Device_Bindless_Resource type, const char* name)
+            void update(void* data, const uint32_t count, const uint32_t slot, const RHI_Device_Bindless_Resource type, const char* name, const uint32_t start = 0)
             {
                 // deduce binding from slot (HLSL register style)
                 uint32_t binding = 0;
@@ -1045,6 +1045,7 @@ namespace spartan
                 // on the first run, create layout and set
                 if (layouts[static_cast<uint32_t>(type)] == nullptr)
                 {
+                    SP_ASSERT_MSG(start == 0, "The first update has to cover the whole array");
                     create_layout(type, count, binding, name);
                     create_set(type, count, name);
                 }
@@ -1060,7 +1061,7 @@ namespace spartan
                         for (uint32_t i = 0; i < count; ++i)
                         {
                             // get texture with fallback to a default texture
-                            RHI_Texture* texture   = (*textures)[i];
+                            RHI_Texture* texture   = (*textures)[start + i];
                             void* resource_default = Renderer::GetStandardTexture(Renderer_StandardTexture::Checkerboard)->GetRhiSrv();
                             void* resource         = (texture && texture->GetRhiSrv()) ? texture->GetRhiSrv() : resource_default;
 
@@ -1082,7 +1083,7 @@ namespace spartan
                     descriptor_write.sType                = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
                     descriptor_write.dstSet               = sets[static_cast<uint32_t>(type)];
                     descriptor_write.dstBinding           = binding;
-                    descriptor_write.dstArrayElement      = 0; // starting element in the array
+                    descriptor_write.dstArrayElement      = start; // starting element in the array
                     descriptor_write.descriptorType       = type == RHI_Device_Bindless_Resource::MaterialTextures ? VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLER;
                     descriptor_write.descriptorCount      = count;
                     descriptor_write.pImageInfo           = image_infos.data();
@@ -1821,7 +1822,9 @@ namespace spartan
         RHI_Buffer* material_parameteres,
         RHI_Buffer* light_parameters,
         const array<shared_ptr<RHI_Sampler>, static_cast<uint32_t>(Renderer_Sampler::Max)>* samplers,
-        RHI_Buffer* bindless_aabbs
+        RHI_Buffer* bindless_aabbs,
+        const uint32_t material_textures_start,
+        const uint32_t material_textures_count
     )
     {
         if (samplers)
@@ -1862,12 +1865,18 @@ namespace spartan
         }
 
         // textures
-        if (material_textures || material_parameteres)
+        if (material_textures)
         {
+            SP_ASSERT(material_textures_start + material_textures_count <= rhi_max_array_size);
+
             uint32_t binding_slot = static_cast<uint32_t>(Renderer_BindingsSrv::bindless_material_textures);
-            descriptors::bindless::update(&material_textures[0], rhi_max_array_size, binding_slot, RHI_Device_Bindless_Resource::MaterialTextures, "material_textures");
+            descriptors::bindless::update(&material_textures[0], material_textures_count, binding_slot, RHI_Device_Bindless_Resource::MaterialTextures, "material_textures", material_textures_start);
+        }
 
-            binding_slot = static_cast<uint32_t>(Renderer_BindingsSrv::bindless_material_parameters);
+        // material parameters
+        if (material_parameteres)
+        {
+            uint32_t binding_slot = static_cast<uint32_t>(Renderer_BindingsSrv::bindless_material_parameters);
             descriptors::bindless::update(material_parameteres, 1, binding_slot, RHI_Device_Bindless_Resource::MaterialParameters, "material_parameters");
         }
 
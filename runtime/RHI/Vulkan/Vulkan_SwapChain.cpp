@@ -288,11 +288,13 @@ namespace spartan
 
         Create();
     
-        SP_SUBSCRIBE_TO_EVENT(EventType::WindowResized, SP_EVENT_HANDLER(ResizeToWindowSize));
+        m_event_handle_window_resized = SP_SUBSCRIBE_TO_EVENT(EventType::WindowResized, SP_EVENT_HANDLER(ResizeToWindowSize));
     }
 
     RHI_SwapChain::~RHI_SwapChain()
     {
+        Event::Unsubscribe(m_event_handle_window_resized);
+
         for (void*& image_view : m_rhi_rtv)
         {
             if (image_view)
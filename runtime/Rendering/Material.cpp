@@ -41,6 +41,18 @@ namespace spartan
 {
     namespace
     {
+        // flags of the textures a material imports or packs, they are compressed and prepared later, once the material is optimized
+        uint32_t get_texture_flags()
+        {
+            uint32_t flags = RHI_Texture_Srv | RHI_Texture_Compress | RHI_Texture_DontPrepareForGpu;
+            if (RHI_Texture::GetMipsHighQuality())
+            {
+                flags |= RHI_Texture_MipsHighQuality;
+            }
+
+            return flags;
+        }
+
         const char* material_property_to_char_ptr(MaterialProperty material_property)
         {
             switch (material_property)
@@ -259,6 +271,12 @@ namespace spartan
         SetProperty(MaterialProperty::CullMode,       static_cast<float>(RHI_CullMode::Back));
     }
 
+    Material::~Material()
+    {
+        // let the renderer recycle this material's bindless slot
+        SP_FIRE_EVENT_DATA(EventType::MaterialOnDestroyed, static_cast<void*>(this));
+    }
+
     void Material::LoadFromFile(const string& file_path)
     {
         pugi::xml_document doc;
@@ -371,7 +389,7 @@ namespace spartan
             SetProperty(MaterialProperty::Height, multiplier);
         }
 
-        SP_FIRE_EVENT(EventType::MaterialOnChanged);
+        SP_FIRE_EVENT_DATA_DEFERRED(EventType::MaterialOnChanged, static_cast<void*>(this));
     }
 
     void Material::SetTexture(const MaterialTextureType texture_type, shared_ptr<RHI_Texture> texture, const uint8_t slot)
@@ -381,7 +399,7 @@ namespace spartan
 
     void Material::SetTexture(const MaterialTextureType texture_type, const string& file_path, const uint8_t slot)
     {
-        SetTexture(texture_type, ResourceCache::Load<RHI_Texture>(file_path, RHI_Texture_Srv | RHI_Texture_Compress | RHI_Texture_DontPrepareForGpu), slot);
+        SetTexture(texture_type, ResourceCache::Load<RHI_Texture>(file_path, get_texture_flags()), slot);
     }
  
     bool Material::HasTextureOfType(const string& path) const
@@ -477,7 +495,7 @@ namespace spartan
                         depth,
                         mip_count,
                         RHI_Format::R8G8B8A8_Unorm,
-                        RHI_Texture_Srv | RHI_Texture_Compress | RHI_Texture_DontPrepareForGpu,
+                        get_texture_flags(),
                         normal_name.c_str()
                     );
 
@@ -555,7 +573,7 @@ namespace spartan
                             reference_depth,
                             reference_mip_count,
                             RHI_Format::R8G8B8A8_Unorm,
-                            RHI_Texture_Srv | RHI_Texture_Compress | RHI_Texture_DontPrepareForGpu,
+                            get_texture_flags(),
                             tex_name.c_str()
                         );
                         texture_packed->SetResourceFilePath(tex_name + ".png"); // that's a hack, need to fix the ResourceCache to rely on a hash, not names and paths
@@ -614,15 +632,27 @@ namespace spartan
         // PrepareForGpu() generates mips, compresses and uploads to GPU, so we offload it to a thread
         ThreadPool::AddTask([this]()
         {
-            // prepare all textures
+            // prepare all textures at once, so that their compression tiles share the thread pool
+            // a texture can occupy more than one slot (e.g. an alpha mask that doubles as color), it's only prepared once
+            vector<RHI_Texture*> textures;
             for (RHI_Texture* texture : m_textures)
             {
-                if (texture && texture->GetResourceState() == ResourceState::Max)
+                if (texture && texture->GetResourceState() == ResourceState::Max && find(textures.begin(), textures.end(), texture) == textures.end())
+                {
+                    textures.push_back(texture);
+                }
+            }
+
+            vector<JobHandle> jobs;
+            for (RHI_Texture* texture : textures)
+            {
+                jobs.emplace_back(ThreadPool::AddJob([texture]()
                 {
                     texture->SetFlag(RHI_Texture_DontPrepareForGpu, false);
                     texture->PrepareForGpu();
-                }
+                }));
             }
+            ThreadPool::Wait(jobs);
 
             // determine if the material is optimized
             bool is_optimized = GetTexture(MaterialTextureType::Packed) != nullptr;
@@ -693,7 +723,7 @@ namespace spartan
         // also the renderer will check all the materials after loading anyway
         if (!ProgressTracker::GetProgress(ProgressType::World).IsProgressing())
         {
-            SP_FIRE_EVENT(EventType::MaterialOnChanged);
+            SP_FIRE_EVENT_DATA_DEFERRED(EventType::MaterialOnChanged, static_cast<void*>(this));
         }
     }
 
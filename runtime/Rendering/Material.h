@@ -95,7 +95,7 @@ namespace spartan
     {
     public:
         Material();
-        ~Material() = default;
+        ~Material();
 
         // iresource
         void LoadFromFile(const std::string& file_path) override;
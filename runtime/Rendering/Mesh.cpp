@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../IO/FileStream.h"
 #include "../Resource/Import/ModelImporter.h"
 #include "../Geometry/GeometryProcessing.h"
+#include "../Geometry/Bvh.h"
 //===========================================
 
 //= NAMESPACES ================
@@ -36,6 +37,63 @@ using namespace spartan::math;
 
 namespace spartan
 {
+    namespace cooked_mesh
+    {
+        // layout: header | chunk table | chunks (each aligned to 16 bytes and checksummed)
+        // everything is stored as flat arrays so that loading is one read and a few memcpys
+
+        const uint32_t magic   = 0x48534D53; // "SMSH"
+        const uint32_t version = 1;
+
+        enum class ChunkId : uint32_t
+        {
+            Path,
+            SubMeshes,
+            Lods,
+            Vertices,
+            Indices,
+            Max
+        };
+
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t source_key;
+            uint32_t flags;
+            uint32_t lod_dropoff;
+            uint32_t chunk_count;
+            uint32_t padding;
+        };
+
+        struct Chunk
+        {
+            ChunkId id;
+            uint32_t padding;
+            uint64_t offset;
+            uint64_t size;
+            uint64_t checksum;
+        };
+
+        struct SubMeshEntry
+        {
+            uint32_t lod_offset; // into the lod chunk
+            uint32_t lod_count;
+            uint32_t is_solid;
+            uint32_t padding;
+        };
+
+        SP_ASSERT_STATIC_IS_TRIVIALLY_COPYABLE(Header);
+        SP_ASSERT_STATIC_IS_TRIVIALLY_COPYABLE(Chunk);
+        SP_ASSERT_STATIC_IS_TRIVIALLY_COPYABLE(MeshLod);
+        SP_ASSERT_STATIC_IS_TRIVIALLY_COPYABLE(RHI_Vertex_PosTexNorTan);
+
+        uint64_t align(const uint64_t value)
+        {
+            return (value + 15) & ~uint64_t(15);
+        }
+    }
+
     namespace
     {
         bool is_solid(Mesh& mesh, uint32_t sub_mesh_index)
@@ -139,6 +197,9 @@ namespace spartan
 
         m_vertices.clear();
         m_vertices.shrink_to_fit();
+
+        m_sub_meshes.clear();
+        m_bvhs.clear();
     }
 
     void Mesh::LoadFromFile(const string& file_path)
@@ -154,15 +215,9 @@ namespace spartan
         // load engine format
         if (FileSystem::GetExtensionFromFilePath(file_path) == EXTENSION_MODEL)
         {
-            // deserialize
-            auto file = make_unique<FileStream>(file_path, FileStream_Read);
-            if (!file->IsOpen())
+            if (!LoadCooked(file_path))
                 return;
 
-            SetResourceFilePath(file->ReadAs<string>());
-            file->Read(&m_indices);
-            file->Read(&m_vertices);
-
             CreateGpuBuffers();
         }
         // load foreign format
@@ -186,15 +241,183 @@ namespace spartan
 
     void Mesh::SaveToFile(const string& file_path)
     {
-        auto file = make_unique<FileStream>(file_path, FileStream_Write);
-        if (!file->IsOpen())
-            return;
+        SaveCooked(file_path);
+    }
+
+    bool Mesh::SaveCooked(const string& file_path, const uint64_t source_key /*= 0*/)
+    {
+        lock_guard lock(m_mutex);
+
+        // flatten the sub-mesh table
+        vector<cooked_mesh::SubMeshEntry> sub_meshes;
+        vector<MeshLod> lods;
+        for (const SubMesh& sub_mesh : m_sub_meshes)
+        {
+            cooked_mesh::SubMeshEntry entry = {};
+            entry.lod_offset                = static_cast<uint32_t>(lods.size());
+            entry.lod_count                 = static_cast<uint32_t>(sub_mesh.lods.size());
+            entry.is_solid                  = sub_mesh.is_solid ? 1 : 0;
+            sub_meshes.push_back(entry);
+            lods.insert(lods.end(), sub_mesh.lods.begin(), sub_mesh.lods.end());
+        }
+
+        const string& path = GetResourceFilePath();
+        const array<pair<const void*, uint64_t>, static_cast<uint32_t>(cooked_mesh::ChunkId::Max)> chunk_data =
+        {{
+            { path.data(),       path.size() },
+            { sub_meshes.data(), sub_meshes.size() * sizeof(cooked_mesh::SubMeshEntry) },
+            { lods.data(),       lods.size()       * sizeof(MeshLod) },
+            { m_vertices.data(), m_vertices.size() * sizeof(RHI_Vertex_PosTexNorTan) },
+            { m_indices.data(),  m_indices.size()  * sizeof(uint32_t) }
+        }};
+
+        // header and chunk table
+        cooked_mesh::Header header = {};
+        header.magic               = cooked_mesh::magic;
+        header.version             = cooked_mesh::version;
+        header.source_key          = source_key;
+        header.flags               = m_flags;
+        header.lod_dropoff         = static_cast<uint32_t>(m_lod_dropoff);
+        header.chunk_count         = static_cast<uint32_t>(chunk_data.size());
+
+        vector<cooked_mesh::Chunk> chunks(chunk_data.size());
+        uint64_t offset = cooked_mesh::align(sizeof(cooked_mesh::Header) + chunks.size() * sizeof(cooked_mesh::Chunk));
+        for (uint32_t i = 0; i < static_cast<uint32_t>(chunks.size()); i++)
+        {
+            chunks[i].id       = static_cast<cooked_mesh::ChunkId>(i);
+            chunks[i].offset   = offset;
+            chunks[i].size     = chunk_data[i].second;
+            chunks[i].checksum = FileSystem::HashBytes(chunk_data[i].first, chunk_data[i].second);
+            offset             = cooked_mesh::align(offset + chunk_data[i].second);
+        }
 
-        file->Write(GetResourceFilePath());
-        file->Write(m_indices);
-        file->Write(m_vertices);
+        // assemble in memory and write with a single call
+        vector<char> buffer(offset, 0);
+        memcpy(buffer.data(), &header, sizeof(header));
+        memcpy(buffer.data() + sizeof(header), chunks.data(), chunks.size() * sizeof(cooked_mesh::Chunk));
+        for (uint32_t i = 0; i < static_cast<uint32_t>(chunks.size()); i++)
+        {
+            if (chunks[i].size != 0)
+            {
+                memcpy(buffer.data() + chunks[i].offset, chunk_data[i].first, chunks[i].size);
+            }
+        }
+
+        // through a temporary file, so that an interrupted write never leaves a truncated cooked mesh behind
+        const string file_path_temp = file_path + ".tmp";
+        bool is_written             = false;
+        {
+            ofstream file(file_path_temp, ios::binary | ios::trunc);
+            if (!file.is_open())
+            {
+                SP_LOG_ERROR("Failed to open \"%s\" for writing", file_path_temp.c_str());
+                return false;
+            }
+            file.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+            file.close();
+            is_written = file.good();
+        }
 
-        file->Close();
+        if (!is_written || !FileSystem::Rename(file_path_temp, file_path))
+        {
+            FileSystem::Delete(file_path_temp);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Mesh::LoadCooked(const string& file_path, const uint64_t source_key /*= 0*/)
+    {
+        if (!FileSystem::Exists(file_path))
+            return false;
+
+        // map the whole file, chunks are copied straight out of the mapping
+        FileStream file(file_path, FileStream_Read);
+        if (!file.IsOpen())
+            return false;
+
+        span<const byte> buffer = file.ViewBytes(file.GetSize());
+
+        // validate header
+        if (buffer.size() < sizeof(cooked_mesh::Header))
+            return false;
+
+        cooked_mesh::Header header;
+        memcpy(&header, buffer.data(), sizeof(header));
+        if (header.magic != cooked_mesh::magic || header.version != cooked_mesh::version)
+        {
+            SP_LOG_WARNING("\"%s\" is not a cooked mesh or was cooked by a different version", file_path.c_str());
+            return false;
+        }
+
+        if (source_key != 0 && header.source_key != source_key)
+            return false;
+
+        // validate chunks
+        if (header.chunk_count != static_cast<uint32_t>(cooked_mesh::ChunkId::Max) || sizeof(header) + header.chunk_count * sizeof(cooked_mesh::Chunk) > buffer.size())
+            return false;
+
+        vector<cooked_mesh::Chunk> chunks(header.chunk_count);
+        memcpy(chunks.data(), buffer.data() + sizeof(header), chunks.size() * sizeof(cooked_mesh::Chunk));
+        for (uint32_t i = 0; i < header.chunk_count; i++)
+        {
+            const cooked_mesh::Chunk& chunk = chunks[i];
+            if (chunk.id != static_cast<cooked_mesh::ChunkId>(i) || chunk.offset > buffer.size() || chunk.size > buffer.size() - chunk.offset || FileSystem::HashBytes(buffer.data() + chunk.offset, chunk.size) != chunk.checksum)
+            {
+                SP_LOG_ERROR("\"%s\" is corrupted", file_path.c_str());
+                return false;
+            }
+        }
+
+        auto copy_chunk = [&](const cooked_mesh::ChunkId id, auto& destination)
+        {
+            using element_type              = typename remove_reference_t<decltype(destination)>::value_type;
+            const cooked_mesh::Chunk& chunk = chunks[static_cast<uint32_t>(id)];
+            destination.resize(chunk.size / sizeof(element_type));
+            if (chunk.size != 0)
+            {
+                memcpy(destination.data(), buffer.data() + chunk.offset, destination.size() * sizeof(element_type));
+            }
+        };
+
+        vector<cooked_mesh::SubMeshEntry> sub_meshes;
+        vector<MeshLod> lods;
+        string path;
+        copy_chunk(cooked_mesh::ChunkId::SubMeshes, sub_meshes);
+        copy_chunk(cooked_mesh::ChunkId::Lods,      lods);
+        copy_chunk(cooked_mesh::ChunkId::Path,      path);
+
+        {
+            lock_guard lock(m_mutex);
+
+            copy_chunk(cooked_mesh::ChunkId::Vertices, m_vertices);
+            copy_chunk(cooked_mesh::ChunkId::Indices,  m_indices);
+
+            m_bvhs.clear();
+            m_sub_meshes.clear();
+            m_sub_meshes.reserve(sub_meshes.size());
+            for (const cooked_mesh::SubMeshEntry& entry : sub_meshes)
+            {
+                SubMesh& sub_mesh = m_sub_meshes.emplace_back();
+                sub_mesh.is_solid = entry.is_solid != 0;
+                if (entry.lod_offset + entry.lod_count <= lods.size())
+                {
+                    sub_mesh.lods.assign(lods.begin() + entry.lod_offset, lods.begin() + entry.lod_offset + entry.lod_count);
+                }
+            }
+
+            m_flags       = header.flags;
+            m_lod_dropoff = static_cast<MeshLodDropoff>(header.lod_dropoff);
+        }
+
+        // outside of the mesh lock, setting the path takes the resource cache lock
+        if (!path.empty())
+        {
+            SetResourceFilePath(path);
+        }
+
+        return true;
     }
 
     uint32_t Mesh::GetMemoryUsage() const
@@ -231,6 +454,32 @@ namespace spartan
         }
     }
 
+    const Bvh* Mesh::GetBvh(const uint32_t sub_mesh_index)
+    {
+        lock_guard lock(m_mutex);
+
+        if (sub_mesh_index >= m_sub_meshes.size() || m_sub_meshes[sub_mesh_index].lods.empty())
+            return nullptr;
+
+        if (m_bvhs.size() < m_sub_meshes.size())
+        {
+            m_bvhs.resize(m_sub_meshes.size());
+        }
+
+        unique_ptr<Bvh>& bvh = m_bvhs[sub_mesh_index];
+        if (!bvh)
+        {
+            const MeshLod& lod = m_sub_meshes[sub_mesh_index].lods[0];
+            if (lod.index_count == 0 || lod.vertex_offset + lod.vertex_count > m_vertices.size() || lod.index_offset + lod.index_count > m_indices.size())
+                return nullptr;
+
+            bvh = make_unique<Bvh>();
+            bvh->Build(&m_vertices[lod.vertex_offset], &m_indices[lod.index_offset], lod.index_count);
+        }
+
+        return bvh.get();
+    }
+
     void Mesh::AddLod(vector<RHI_Vertex_PosTexNorTan>& vertices, vector<uint32_t>& indices, const uint32_t sub_mesh_index)
     {
         // build lod
@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace spartan
 {
     class RHI_Buffer;
+    class Bvh;
 
     enum class MeshFlags : uint32_t
     {
@@ -87,6 +88,11 @@ namespace spartan
         void LoadFromFile(const std::string& file_path) override;
         void SaveToFile(const std::string& file_path) override;
 
+        // cooked geometry, sub-meshes, lods, bounds and solidity are stored as is so loading skips all processing
+        // the source key identifies what the geometry was cooked from, loading fails if it doesn't match (0 matches anything)
+        bool SaveCooked(const std::string& file_path, const uint64_t source_key = 0);
+        bool LoadCooked(const std::string& file_path, const uint64_t source_key = 0);
+
         // geometry
         void Clear();
         void GetGeometry(uint32_t sub_mesh_index, std::vector<uint32_t>* indices, std::vector<RHI_Vertex_PosTexNorTan>* vertices);
@@ -96,8 +102,12 @@ namespace spartan
         std::vector<RHI_Vertex_PosTexNorTan>& GetVertices()   { return m_vertices; }
         std::vector<uint32_t>& GetIndices()                   { return m_indices; }
         const SubMesh& GetSubMesh(const uint32_t index) const { return m_sub_meshes[index]; }
+        uint32_t GetSubMeshCount() const                      { return static_cast<uint32_t>(m_sub_meshes.size()); }
         bool IsSolid(const uint32_t sub_mesh_index) const     { return m_sub_meshes[sub_mesh_index].is_solid; }
 
+        // ray queries, the bvh of a sub-mesh's lod 0 is built on first use and kept until the geometry changes
+        const Bvh* GetBvh(const uint32_t sub_mesh_index);
+
         // lod dropoff
         MeshLodDropoff GetLodDropoff() const                  { return m_lod_dropoff; }
         void SetLodDropoff(const MeshLodDropoff dropoff)      { m_lod_dropoff = dropoff; }
@@ -128,6 +138,7 @@ namespace spartan
         std::vector<RHI_Vertex_PosTexNorTan> m_vertices; // all vertices of a model file
         std::vector<uint32_t> m_indices;                 // all indices of a model file
         std::vector<SubMesh> m_sub_meshes;               // tracks sub-meshes and lods within the above vectors
+        std::vector<std::unique_ptr<Bvh>> m_bvhs;        // one per sub-mesh, null until requested
 
         // gpu buffers
         std::shared_ptr<RHI_Buffer> m_vertex_buffer;
@@ -72,6 +72,99 @@ namespace spartan
     array<Sb_Light, rhi_max_array_size> Renderer::m_bindless_lights;
     array<Sb_Aabb, rhi_max_array_size> Renderer::m_bindless_aabbs;
 
+    namespace draw_call_sorting
+    {
+        namespace
+        {
+            struct Entry
+            {
+                uint64_t key;
+                uint32_t index;
+            };
+
+            vector<Entry> entries;
+            vector<Entry> scratch;
+            vector<Renderer_DrawCall> draw_calls_sorted;
+
+            // lsd radix sort, 8 bits per pass, passes where every key has the same digit are skipped
+            void radix_sort(vector<Entry>& keys, vector<Entry>& temp)
+            {
+                const size_t count = keys.size();
+                temp.resize(count);
+
+                array<array<uint32_t, 256>, 8> histograms = {};
+                for (const Entry& entry : keys)
+                {
+                    for (uint32_t pass = 0; pass < 8; pass++)
+                    {
+                        histograms[pass][(entry.key >> (pass * 8)) & 0xFF]++;
+                    }
+                }
+
+                for (uint32_t pass = 0; pass < 8; pass++)
+                {
+                    array<uint32_t, 256>& histogram = histograms[pass];
+                    if (histogram[(keys[0].key >> (pass * 8)) & 0xFF] == count)
+                        continue;
+
+                    // exclusive prefix sum
+                    uint32_t offset = 0;
+                    for (uint32_t& bucket : histogram)
+                    {
+                        uint32_t bucket_count = bucket;
+                        bucket                = offset;
+                        offset               += bucket_count;
+                    }
+
+                    for (const Entry& entry : keys)
+                    {
+                        temp[histogram[(entry.key >> (pass * 8)) & 0xFF]++] = entry;
+                    }
+
+                    keys.swap(temp);
+                }
+            }
+        }
+
+        // 64-bit key, sorting it in ascending order gives: opaque before transparent, grouped by material,
+        // front-to-back for opaque and back-to-front for transparent
+        // [63] transparent | [62:32] bindless material slot | [31:0] depth
+        uint64_t compute_key(const bool transparent, const uint32_t material_index, const float distance_squared)
+        {
+            // the bits of a non-negative float are ordered the same way as its value
+            uint32_t depth = 0;
+            float distance = max(distance_squared, 0.0f);
+            memcpy(&depth, &distance, sizeof(depth));
+            if (transparent)
+            {
+                depth = ~depth; // back-to-front
+            }
+
+            return (static_cast<uint64_t>(transparent) << 63) | (static_cast<uint64_t>(material_index & 0x7FFFFFFF) << 32) | depth;
+        }
+
+        void sort(Renderer_DrawCall* draw_calls, const uint32_t count)
+        {
+            if (count < 2)
+                return;
+
+            entries.resize(count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                entries[i] = { draw_calls[i].sort_key, i };
+            }
+
+            radix_sort(entries, scratch);
+
+            draw_calls_sorted.resize(count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                draw_calls_sorted[i] = draw_calls[entries[i].index];
+            }
+            copy(draw_calls_sorted.begin(), draw_calls_sorted.end(), draw_calls);
+        }
+    }
+
     namespace
     {
         // resolution & viewport
@@ -92,6 +185,241 @@ namespace spartan
         float far_plane                      = 1.0f;
         bool dirty_orthographic_projection   = true;
 
+        namespace bindless_materials
+        {
+            // a material gets a slot the first time it's drawn and keeps it until it's destroyed, so only
+            // changed slots are rewritten and uploaded, slot i owns properties[i * stride] and textures [i * stride, (i + 1) * stride)
+            const uint32_t stride   = static_cast<uint32_t>(MaterialTextureType::Max) * Material::slots_per_texture_type;
+            const uint32_t capacity = rhi_max_array_size / stride;
+
+            array<Sb_Material, rhi_max_array_size> properties; // mapped to the gpu as a structured buffer
+            unordered_map<const Material*, uint32_t> slots;
+            array<Material*, capacity> owners = {};
+            array<bool, capacity> is_dirty    = {};
+            vector<uint32_t> slots_free;
+            vector<uint32_t> slots_dirty;
+            uint32_t slot_count = 0; // slots handed out so far, freed ones included
+            mutex mutex_slots;       // materials can change or be destroyed on any thread
+
+            void mark_dirty(const uint32_t slot)
+            {
+                if (!is_dirty[slot])
+                {
+                    is_dirty[slot] = true;
+                    slots_dirty.push_back(slot);
+                }
+            }
+
+            bool has_dirty()
+            {
+                lock_guard<mutex> lock(mutex_slots);
+                return !slots_dirty.empty();
+            }
+
+            uint32_t acquire(Material* material)
+            {
+                if (!material)
+                    return 0;
+
+                lock_guard<mutex> lock(mutex_slots);
+
+                auto it = slots.find(material);
+                if (it != slots.end())
+                    return it->second;
+
+                uint32_t slot = 0;
+                if (!slots_free.empty())
+                {
+                    slot = slots_free.back();
+                    slots_free.pop_back();
+                }
+                else
+                {
+                    SP_ASSERT_MSG(slot_count < capacity, "Out of bindless material slots");
+                    slot = slot_count++;
+                }
+
+                slots[material] = slot;
+                owners[slot]    = material;
+                material->SetIndex(slot * stride);
+                mark_dirty(slot);
+
+                return slot;
+            }
+
+            void on_changed(const sp_variant& data)
+            {
+                lock_guard<mutex> lock(mutex_slots);
+
+                // without a material, assume they all changed
+                void* const* material = get_if<void*>(&data);
+                if (!material || !*material)
+                {
+                    for (uint32_t slot = 0; slot < slot_count; slot++)
+                    {
+                        mark_dirty(slot);
+                    }
+                    return;
+                }
+
+                auto it = slots.find(static_cast<const Material*>(*material));
+                if (it != slots.end())
+                {
+                    mark_dirty(it->second);
+                }
+            }
+
+            void on_destroyed(const sp_variant& data)
+            {
+                lock_guard<mutex> lock(mutex_slots);
+
+                auto it = slots.find(static_cast<const Material*>(get<void*>(data)));
+                if (it == slots.end())
+                    return;
+
+                // the slot is cleared on the next update, and can be handed out again right away
+                const uint32_t slot = it->second;
+                owners[slot]        = nullptr;
+                slots.erase(it);
+                slots_free.push_back(slot);
+                mark_dirty(slot);
+            }
+
+            // returns false if a texture has no srv yet, the descriptor then points to the default texture until the slot is written again
+            bool write(const uint32_t slot, array<RHI_Texture*, rhi_max_array_size>& textures)
+            {
+                const uint32_t index = slot * stride;
+                Material* material   = owners[slot];
+                Sb_Material& record  = properties[index];
+
+                if (!material)
+                {
+                    record = Sb_Material{};
+                    fill(textures.begin() + index, textures.begin() + index + stride, nullptr);
+                    return true;
+                }
+
+                // properties
+                {
+                    record.local_width           = material->GetProperty(MaterialProperty::WorldWidth);
+                    record.local_height          = material->GetProperty(MaterialProperty::WorldHeight);
+                    record.color.x               = material->GetProperty(MaterialProperty::ColorR);
+                    record.color.y               = material->GetProperty(MaterialProperty::ColorG);
+                    record.color.z               = material->GetProperty(MaterialProperty::ColorB);
+                    record.color.w               = material->GetProperty(MaterialProperty::ColorA);
+                    record.tiling_uv.x           = material->GetProperty(MaterialProperty::TextureTilingX);
+                    record.tiling_uv.y           = material->GetProperty(MaterialProperty::TextureTilingY);
+                    record.offset_uv.x           = material->GetProperty(MaterialProperty::TextureOffsetX);
+                    record.offset_uv.y           = material->GetProperty(MaterialProperty::TextureOffsetY);
+                    record.roughness_mul         = material->GetProperty(MaterialProperty::Roughness);
+                    record.metallic_mul          = material->GetProperty(MaterialProperty::Metalness);
+                    record.normal_mul            = material->GetProperty(MaterialProperty::Normal);
+                    record.height_mul            = material->GetProperty(MaterialProperty::Height);
+                    record.anisotropic           = material->GetProperty(MaterialProperty::Anisotropic);
+                    record.anisotropic_rotation  = material->GetProperty(MaterialProperty::AnisotropicRotation);
+                    record.clearcoat             = material->GetProperty(MaterialProperty::Clearcoat);
+                    record.clearcoat_roughness   = material->GetProperty(MaterialProperty::Clearcoat_Roughness);
+                    record.sheen                 = material->GetProperty(MaterialProperty::Sheen);
+                    record.subsurface_scattering = material->GetProperty(MaterialProperty::SubsurfaceScattering);
+                    record.world_space_uv        = material->GetProperty(MaterialProperty::WorldSpaceUv);
+
+                    // flags
+                    record.flags  = material->HasTextureOfType(MaterialTextureType::Height)             ? (1U << 0)  : 0;
+                    record.flags |= material->HasTextureOfType(MaterialTextureType::Normal)             ? (1U << 1)  : 0;
+                    record.flags |= material->HasTextureOfType(MaterialTextureType::Color)              ? (1U << 2)  : 0;
+                    record.flags |= material->HasTextureOfType(MaterialTextureType::Roughness)          ? (1U << 3)  : 0;
+                    record.flags |= material->HasTextureOfType(MaterialTextureType::Metalness)          ? (1U << 4)  : 0;
+                    record.flags |= material->HasTextureOfType(MaterialTextureType::AlphaMask)          ? (1U << 5)  : 0;
+                    record.flags |= material->HasTextureOfType(MaterialTextureType::Emission)           ? (1U << 6)  : 0;
+                    record.flags |= material->HasTextureOfType(MaterialTextureType::Occlusion)          ? (1U << 7)  : 0;
+                    record.flags |= material->GetProperty(MaterialProperty::IsTerrain)                  ? (1U << 8)  : 0;
+                    record.flags |= material->GetProperty(MaterialProperty::WindAnimation)              ? (1U << 9)  : 0;
+                    record.flags |= material->GetProperty(MaterialProperty::ColorVariationFromInstance) ? (1U << 10) : 0;
+                    record.flags |= material->GetProperty(MaterialProperty::IsGrassBlade)               ? (1U << 11) : 0;
+                    record.flags |= material->GetProperty(MaterialProperty::IsWater)                    ? (1U << 12) : 0;
+                    record.flags |= material->GetProperty(MaterialProperty::Tessellation)               ? (1U << 13) : 0;
+                    // when changing the bit flags, ensure that you also update the Surface struct in common_structs.hlsl, so that it reads those flags as expected
+                }
+
+                // textures
+                bool is_complete = true;
+                for (uint32_t type = 0; type < static_cast<uint32_t>(MaterialTextureType::Max); type++)
+                {
+                    for (uint32_t texture_slot = 0; texture_slot < Material::slots_per_texture_type; texture_slot++)
+                    {
+                        RHI_Texture* texture = material->GetTexture(static_cast<MaterialTextureType>(type), texture_slot);
+                        textures[index + (type * Material::slots_per_texture_type) + texture_slot] = texture;
+                        is_complete = is_complete && (!texture || texture->GetRhiSrv());
+                    }
+                }
+
+                return is_complete;
+            }
+        }
+
+        namespace culling
+        {
+            // bounding boxes of all renderables (or their instance groups), as a structure of arrays
+            // so the frustum can test several of them per instruction
+            vector<float> center_x;
+            vector<float> center_y;
+            vector<float> center_z;
+            vector<float> extent_x;
+            vector<float> extent_y;
+            vector<float> extent_z;
+            vector<uint8_t> in_frustum;
+
+            struct Owner
+            {
+                Renderable* renderable;
+                uint32_t instance_group_index;
+                const BoundingBox* bounding_box;
+            };
+            vector<Owner> owners;
+            vector<Renderable*> renderables;
+
+            // below this, dispatching jobs costs more than testing everything on the calling thread
+            const uint32_t parallel_threshold = 256;
+
+            void clear()
+            {
+                center_x.clear();
+                center_y.clear();
+                center_z.clear();
+                extent_x.clear();
+                extent_y.clear();
+                extent_z.clear();
+                owners.clear();
+                renderables.clear();
+            }
+
+            void add(Renderable* renderable, const uint32_t instance_group_index, const BoundingBox& bounding_box)
+            {
+                const Vector3 center  = bounding_box.GetCenter();
+                const Vector3 extents = bounding_box.GetExtents();
+
+                center_x.push_back(center.x);
+                center_y.push_back(center.y);
+                center_z.push_back(center.z);
+                extent_x.push_back(extents.x);
+                extent_y.push_back(extents.y);
+                extent_z.push_back(extents.z);
+                owners.push_back({ renderable, instance_group_index, &bounding_box });
+            }
+
+            void parallel_for(function<void(uint32_t, uint32_t)>&& work, const uint32_t count)
+            {
+                if (count < parallel_threshold)
+                {
+                    work(0, count);
+                }
+                else
+                {
+                    ThreadPool::ParallelLoop(std::move(work), count);
+                }
+            }
+        }
+
         void dynamic_resolution()
         {
             if (Renderer::GetOption<float>(Renderer_Option::DynamicResolution) != 0.0f)
@@ -252,7 +580,8 @@ namespace spartan
         {
             // subscribe
             SP_SUBSCRIBE_TO_EVENT(EventType::WindowFullScreenToggled, SP_EVENT_HANDLER_STATIC(OnFullScreenToggled));
-            SP_SUBSCRIBE_TO_EVENT(EventType::MaterialOnChanged,       SP_EVENT_HANDLER_EXPRESSION_STATIC( m_bindless_materials_dirty = true; ));
+            SP_SUBSCRIBE_TO_EVENT(EventType::MaterialOnChanged,       SP_EVENT_HANDLER_VARIANT_STATIC(bindless_materials::on_changed));
+            SP_SUBSCRIBE_TO_EVENT(EventType::MaterialOnDestroyed,     SP_EVENT_HANDLER_VARIANT_STATIC(bindless_materials::on_destroyed));
             SP_SUBSCRIBE_TO_EVENT(EventType::LightOnChanged,          SP_EVENT_HANDLER_EXPRESSION_STATIC( m_bindless_lights_dirty    = true; ));
 
             // fire
@@ -298,6 +627,9 @@ namespace spartan
         //RHI_CommandList* cmd_list_compute = queue_compute->NextCommandList();
         //cmd_list_compute->Begin();
 
+        // frustum and distance culling, then lod selection
+        UpdateVisibility();
+
         // build draw calls and determine occluders
         BuildDrawCallsAndOccluders(m_cmd_list_present);
 
@@ -824,10 +1156,9 @@ namespace spartan
         bool initialize = GetFrameNumber() == 0;
         if (initialize || !ProgressTracker::IsLoading())
         { 
-            if (m_bindless_materials_dirty)
+            if (m_bindless_materials_dirty || bindless_materials::has_dirty())
             {
                 BindlessUpdateMaterialsParameters(cmd_list);
-                RHI_Device::UpdateBindlessResources(&m_bindless_textures, GetBuffer(Renderer_Buffer::MaterialParameters), nullptr, nullptr, nullptr);
                 m_bindless_materials_dirty = false;
             }
             
@@ -855,120 +1186,72 @@ namespace spartan
 
     void Renderer::BindlessUpdateMaterialsParameters(RHI_CommandList* cmd_list)
     {
-        static array<Sb_Material, rhi_max_array_size> properties; // mapped to the gpu as a structured properties buffer
-        static unordered_set<uint64_t> unique_material_ids;
-        static uint32_t count = 0;
-    
-        auto update_material = [](Material* material)
+        RHI_Buffer* buffer = GetBuffer(Renderer_Buffer::MaterialParameters);
+
+        // the first update writes everything, as it also creates the descriptors
+        if (m_bindless_materials_dirty)
         {
-            // check if the material's ID is already processed
-            if (unique_material_ids.find(material->GetObjectId()) != unique_material_ids.end())
-                return;
-    
-            // if not, add it to the list
-            unique_material_ids.insert(material->GetObjectId());
-    
-            // properties
+            lock_guard<mutex> lock(bindless_materials::mutex_slots);
+
+            for (uint32_t slot : bindless_materials::slots_dirty)
             {
-                SP_ASSERT(count < rhi_max_array_size);
-
-                properties[count].local_width           = material->GetProperty(MaterialProperty::WorldWidth);
-                properties[count].local_height          = material->GetProperty(MaterialProperty::WorldHeight);
-                properties[count].color.x               = material->GetProperty(MaterialProperty::ColorR);
-                properties[count].color.y               = material->GetProperty(MaterialProperty::ColorG);
-                properties[count].color.z               = material->GetProperty(MaterialProperty::ColorB);
-                properties[count].color.w               = material->GetProperty(MaterialProperty::ColorA);
-                properties[count].tiling_uv.x           = material->GetProperty(MaterialProperty::TextureTilingX);
-                properties[count].tiling_uv.y           = material->GetProperty(MaterialProperty::TextureTilingY);
-                properties[count].offset_uv.x           = material->GetProperty(MaterialProperty::TextureOffsetX);
-                properties[count].offset_uv.y           = material->GetProperty(MaterialProperty::TextureOffsetY);
-                properties[count].roughness_mul         = material->GetProperty(MaterialProperty::Roughness);
-                properties[count].metallic_mul          = material->GetProperty(MaterialProperty::Metalness);
-                properties[count].normal_mul            = material->GetProperty(MaterialProperty::Normal);
-                properties[count].height_mul            = material->GetProperty(MaterialProperty::Height);
-                properties[count].anisotropic           = material->GetProperty(MaterialProperty::Anisotropic);
-                properties[count].anisotropic_rotation  = material->GetProperty(MaterialProperty::AnisotropicRotation);
-                properties[count].clearcoat             = material->GetProperty(MaterialProperty::Clearcoat);
-                properties[count].clearcoat_roughness   = material->GetProperty(MaterialProperty::Clearcoat_Roughness);
-                properties[count].sheen                 = material->GetProperty(MaterialProperty::Sheen);
-                properties[count].subsurface_scattering = material->GetProperty(MaterialProperty::SubsurfaceScattering);
-                properties[count].world_space_uv        = material->GetProperty(MaterialProperty::WorldSpaceUv);
-
-                // flags
-                properties[count].flags  = material->HasTextureOfType(MaterialTextureType::Height)             ? (1U << 0)  : 0;
-                properties[count].flags |= material->HasTextureOfType(MaterialTextureType::Normal)             ? (1U << 1)  : 0;
-                properties[count].flags |= material->HasTextureOfType(MaterialTextureType::Color)              ? (1U << 2)  : 0;
-                properties[count].flags |= material->HasTextureOfType(MaterialTextureType::Roughness)          ? (1U << 3)  : 0;
-                properties[count].flags |= material->HasTextureOfType(MaterialTextureType::Metalness)          ? (1U << 4)  : 0;
-                properties[count].flags |= material->HasTextureOfType(MaterialTextureType::AlphaMask)          ? (1U << 5)  : 0;
-                properties[count].flags |= material->HasTextureOfType(MaterialTextureType::Emission)           ? (1U << 6)  : 0;
-                properties[count].flags |= material->HasTextureOfType(MaterialTextureType::Occlusion)          ? (1U << 7)  : 0;
-                properties[count].flags |= material->GetProperty(MaterialProperty::IsTerrain)                  ? (1U << 8)  : 0;
-                properties[count].flags |= material->GetProperty(MaterialProperty::WindAnimation)              ? (1U << 9)  : 0;
-                properties[count].flags |= material->GetProperty(MaterialProperty::ColorVariationFromInstance) ? (1U << 10) : 0;
-                properties[count].flags |= material->GetProperty(MaterialProperty::IsGrassBlade)               ? (1U << 11) : 0;
-                properties[count].flags |= material->GetProperty(MaterialProperty::IsWater)                    ? (1U << 12) : 0;
-                properties[count].flags |= material->GetProperty(MaterialProperty::Tessellation)               ? (1U << 13) : 0;
-                // when changing the bit flags, ensure that you also update the Surface struct in common_structs.hlsl, so that it reads those flags as expected
+                bindless_materials::is_dirty[slot] = false;
             }
-    
-            // textures
+            bindless_materials::slots_dirty.clear();
+
+            for (uint32_t slot = 0; slot < bindless_materials::capacity; slot++)
             {
-                // iterate through all texture types and their slots
-                for (uint32_t type = 0; type < static_cast<uint32_t>(MaterialTextureType::Max); type++)
+                if (!bindless_materials::write(slot, m_bindless_textures))
                 {
-                    for (uint32_t slot = 0; slot < Material::slots_per_texture_type; slot++)
-                    {
-                        // calculate the final index in the bindless array
-                        uint32_t bindless_index = count + (type * Material::slots_per_texture_type) + slot;
-                        
-                        // get the texture from the material using type and slot
-                        m_bindless_textures[bindless_index] = material->GetTexture(static_cast<MaterialTextureType>(type), slot);
-                    }
+                    bindless_materials::mark_dirty(slot);
                 }
             }
-    
-            material->SetIndex(count);
 
-            // update index increment to account for all texture slots
-            count += static_cast<uint32_t>(MaterialTextureType::Max) * Material::slots_per_texture_type;
-        };
-    
-        auto update_entities = [update_material]()
+            buffer->ResetOffset();
+            buffer->Update(cmd_list, &bindless_materials::properties[0], buffer->GetStride() * bindless_materials::slot_count * bindless_materials::stride);
+            RHI_Device::UpdateBindlessResources(&m_bindless_textures, buffer, nullptr, nullptr, nullptr);
+
+            return;
+        }
+
+        // cpu
+        vector<uint32_t> slots;
         {
-            for (const shared_ptr<Entity>& entity : World::GetEntities())
+            lock_guard<mutex> lock(bindless_materials::mutex_slots);
+
+            // slots with textures that are still loading stay dirty, so they are written again once the textures have srvs
+            slots.swap(bindless_materials::slots_dirty);
+            for (uint32_t slot : slots)
             {
-                if (entity->GetActive())
+                bindless_materials::is_dirty[slot] = false;
+                if (!bindless_materials::write(slot, m_bindless_textures))
                 {
-                    if (Renderable* renderable = entity->GetComponent<Renderable>())
-                    {
-                        if (Material* material = renderable->GetMaterial())
-                        {
-                            update_material(material);
-                        }
-                    }
+                    bindless_materials::mark_dirty(slot);
                 }
             }
-        };
-    
-        // cpu
-        {
-            // clear
-            properties.fill(Sb_Material{});
-            m_bindless_textures.fill(nullptr);
-            unique_material_ids.clear();
-            update_entities();
         }
-    
-        // gpu
+
+        // gpu, one upload and one descriptor write per run of consecutive slots
+        sort(slots.begin(), slots.end());
+        const uint32_t slot_size      = buffer->GetStride() * bindless_materials::stride;
+        const uint32_t slots_per_copy = max(rhi_max_buffer_update_size / slot_size, 1u);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(slots.size());)
         {
-            // material properties
-            RHI_Buffer* buffer = Renderer::GetBuffer(Renderer_Buffer::MaterialParameters);
-            buffer->ResetOffset();
-            buffer->Update(cmd_list, &properties[0], buffer->GetStride() * count);
-        }
+            const uint32_t slot_first = slots[i];
+            uint32_t count            = 1;
+            while (i + count < slots.size() && slots[i + count] == slot_first + count && count < slots_per_copy)
+            {
+                count++;
+            }
+
+            // a slot's texture slots are unused in the properties buffer, so the last slot only needs its record
+            const uint32_t index = slot_first * bindless_materials::stride;
+            const uint32_t size  = ((count - 1) * bindless_materials::stride + 1) * buffer->GetStride();
+            cmd_list->UpdateBuffer(buffer, index * buffer->GetStride(), size, &bindless_materials::properties[index]);
+            RHI_Device::UpdateBindlessResources(&m_bindless_textures, nullptr, nullptr, nullptr, nullptr, index, count * bindless_materials::stride);
 
-        count = 0;
+            i += count;
+        }
     }
 
     void Renderer::BindlessUpdateLights(RHI_CommandList* cmd_list)
@@ -1059,6 +1342,92 @@ namespace spartan
         GetRenderTarget(Renderer_RenderTarget::frame_output)->SaveAsImage(file_path);
     }
 
+    void Renderer::UpdateVisibility()
+    {
+        if (ProgressTracker::IsLoading())
+            return;
+
+        // gather the bounding boxes of all active renderables
+        culling::clear();
+        for (const shared_ptr<Entity>& entity : World::GetEntities())
+        {
+            if (!entity->GetActive())
+                continue;
+
+            if (Renderable* renderable = entity->GetComponent<Renderable>())
+            {
+                culling::renderables.push_back(renderable);
+
+                if (renderable->HasInstancing())
+                {
+                    for (uint32_t group_index = 0; group_index < renderable->GetInstanceGroupCount(); group_index++)
+                    {
+                        culling::add(renderable, group_index, renderable->GetBoundingBoxInstanceGroup(group_index));
+                    }
+                }
+                else
+                {
+                    culling::add(renderable, 0, renderable->GetBoundingBox());
+                }
+            }
+        }
+
+        const uint32_t box_count = static_cast<uint32_t>(culling::owners.size());
+        culling::in_frustum.resize(box_count);
+
+        // frustum and distance culling
+        Camera* camera = World::GetCamera();
+        if (camera)
+        {
+            const Frustum& frustum        = camera->GetFrustum();
+            const Vector3 camera_position = camera->GetEntity()->GetPosition();
+
+            culling::parallel_for([&frustum, camera_position](uint32_t start, uint32_t end)
+            {
+                frustum.IsVisible(
+                    culling::center_x.data() + start, culling::center_y.data() + start, culling::center_z.data() + start,
+                    culling::extent_x.data() + start, culling::extent_y.data() + start, culling::extent_z.data() + start,
+                    end - start, culling::in_frustum.data() + start
+                );
+
+                for (uint32_t i = start; i < end; i++)
+                {
+                    const culling::Owner& owner = culling::owners[i];
+
+                    // only if in frustum, calculate distance
+                    if (culling::in_frustum[i])
+                    {
+                        const float distance_squared = Vector3::DistanceSquared(camera_position, owner.bounding_box->GetClosestPoint(camera_position));
+                        const float distance_max     = owner.renderable->GetMaxRenderDistance();
+                        owner.renderable->SetDistanceSquared(distance_squared, owner.instance_group_index);
+                        owner.renderable->SetVisible(distance_squared <= distance_max * distance_max, owner.instance_group_index);
+                    }
+                    else
+                    {
+                        owner.renderable->SetVisible(false, owner.instance_group_index);
+                    }
+                }
+            }, box_count);
+        }
+        else
+        {
+            for (const culling::Owner& owner : culling::owners)
+            {
+                owner.renderable->SetDistanceSquared(0.0f, owner.instance_group_index);
+                owner.renderable->SetVisible(true, owner.instance_group_index);
+            }
+        }
+
+        // lod selection depends on visibility, so it runs once all of it is known
+        culling::parallel_for([](uint32_t start, uint32_t end)
+        {
+            for (uint32_t i = start; i < end; i++)
+            {
+                culling::renderables[i]->UpdateLodIndices();
+            }
+        }, static_cast<uint32_t>(culling::renderables.size()));
+    }
+
     void Renderer::BuildDrawCallsAndOccluders(RHI_CommandList* cmd_list)
     {
         m_draw_call_count = 0;
@@ -1069,7 +1438,7 @@ namespace spartan
         cmd_list->BeginTimeblock("build_draw_calls_and_occluders", false, false);
         {
             // build draw calls and sort them
-            {  
+            {
                 for (const shared_ptr<Entity>& entity : World::GetEntities())
                 {
                     if (!entity->GetActive())
@@ -1077,7 +1446,10 @@ namespace spartan
 
                     if (Renderable* renderable = entity->GetComponent<Renderable>())
                     {
-                        if (renderable->GetMaterial() && renderable->GetMaterial()->IsTransparent())
+                        Material* material            = renderable->GetMaterial();
+                        const bool is_transparent     = material && material->IsTransparent();
+                        const uint32_t material_index = bindless_materials::acquire(material);
+                        if (is_transparent)
                         {
                             m_transparents_present = true;
                         }
@@ -1095,6 +1467,7 @@ namespace spartan
                                 draw_call.instance_group_index = group_index;
                                 draw_call.instance_index       = renderable->GetInstanceGroupStartIndex(group_index);
                                 draw_call.instance_count       = renderable->GetInstanceGroupCount(group_index);
+                                draw_call.sort_key             = draw_call_sorting::compute_key(is_transparent, material_index, draw_call.distance_squared);
                             }
                         }
                         else
@@ -1108,39 +1481,13 @@ namespace spartan
                             draw_call.instance_group_index = 0;
                             draw_call.instance_index       = 0;
                             draw_call.instance_count       = 1;
+                            draw_call.sort_key             = draw_call_sorting::compute_key(is_transparent, material_index, draw_call.distance_squared);
                         }
                     }
                 }
 
-                // sort by transparency, material id, and distance (front-to-back for opaque, back-to-front for transparent)
-                sort(m_draw_calls.begin(), m_draw_calls.begin() + m_draw_call_count, [](const Renderer_DrawCall& a, const Renderer_DrawCall& b)
-                {
-                    // step 1: sort by transparency (opaque before transparent)
-                    bool a_transparent = a.renderable->GetMaterial()->IsTransparent();
-                    bool b_transparent = b.renderable->GetMaterial()->IsTransparent();
-                    if (a_transparent != b_transparent)
-                    {
-                        return !a_transparent; // false (opaque) before true (transparent)
-                    }
-                    
-                    // step 2: sort by material id within each transparency group
-                    uint64_t a_material_id = a.renderable->GetMaterial()->GetObjectId();
-                    uint64_t b_material_id = b.renderable->GetMaterial()->GetObjectId();
-                    if (a_material_id != b_material_id)
-                    {
-                        return a_material_id < b_material_id; // lower material ids first
-                    }
-                    
-                    // step 3: sort by distance within each material group
-                    if (!a_transparent) // both are opaque
-                    {
-                        return a.distance_squared < b.distance_squared; // front-to-back
-                    }
-                    else // both are transparent
-                    {
-                        return a.distance_squared > b.distance_squared; // back-to-front
-                    }
-                });
+                // sort by transparency, material, and distance (front-to-back for opaque, back-to-front for transparent)
+                draw_call_sorting::sort(m_draw_calls.data(), m_draw_call_count);
             }
 
             // select occluders by finding the top n largest screen-space bounding boxes
@@ -138,6 +138,7 @@ namespace spartan
         static void ProduceFrame(RHI_CommandList* cmd_list_graphics_present, RHI_CommandList* cmd_list_compute);
         static void Pass_VariableRateShading(RHI_CommandList* cmd_list);
         static void Pass_ShadowMaps(RHI_CommandList* cmd_list);
+        static void UpdateVisibility();
         static void BuildDrawCallsAndOccluders(RHI_CommandList* cmd_list);
         static void Pass_Occlusion(RHI_CommandList* cmd_list);
         static void Pass_Depth_Prepass(RHI_CommandList* cmd_list);
@@ -321,5 +321,12 @@ namespace spartan
         float distance_squared;        // distance for sorting or other purposes
         bool is_occluder;              // is this draw call an occluder
         bool camera_visible;           // is this draw call visible to the camera
+        uint64_t sort_key;             // transparency | material index | depth, see Renderer::BuildDrawCallsAndOccluders()
     };
+
+    namespace draw_call_sorting
+    {
+        uint64_t compute_key(const bool transparent, const uint32_t material_index, const float distance_squared);
+        void sort(Renderer_DrawCall* draw_calls, const uint32_t count);
+    }
 }
@@ -36,9 +36,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_DepthStencilState.h"
 #include "../RHI/RHI_Buffer.h"
 #include "../RHI/RHI_Device.h"
-#ifdef _MSC_VER
 #include "../RHI/RHI_VendorTechnology.h"
-#endif
 //========================================
 
 //= NAMESPACES ===============
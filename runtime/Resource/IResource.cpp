@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ======================
 #include "pch.h"
 #include "IResource.h"
+#include "ResourceCache.h"
 #include "../RHI/RHI_Texture.h"
 #include "../Font/Font.h"
 #include "../Rendering/Animation.h"
@@ -39,6 +40,22 @@ IResource::IResource(const ResourceType type)
     m_resource_type = type;
 }
 
+void IResource::SetObjectName(const string& name)
+{
+    const string name_previous = m_object_name;
+    m_object_name              = name;
+    ResourceCache::OnResourceRenamed(this, m_resource_file_path, name_previous);
+}
+
+void IResource::SetResourceFilePath(const string& path)
+{
+    const string path_previous = m_resource_file_path;
+    const string name_previous = m_object_name;
+    m_resource_file_path       = FileSystem::GetRelativePath(path);
+    m_object_name              = FileSystem::GetFileNameWithoutExtensionFromFilePath(m_resource_file_path);
+    ResourceCache::OnResourceRenamed(this, path_previous, name_previous);
+}
+
 template <typename T>
 ResourceType IResource::TypeToEnum() { return ResourceType::Unknown; }
 
@@ -57,11 +57,10 @@ namespace spartan
         IResource(ResourceType type);
         virtual ~IResource() = default;
 
-        void SetResourceFilePath(const std::string& path)
-        {
-            m_resource_file_path = FileSystem::GetRelativePath(path);
-            m_object_name        = FileSystem::GetFileNameWithoutExtensionFromFilePath(m_resource_file_path);
-        }
+        // both are forwarded to the resource cache, so that lookups by name and path stay current
+        void SetObjectName(const std::string& name);
+        void SetResourceFilePath(const std::string& path);
+
         
         ResourceType GetResourceType()           const { return m_resource_type; }
         const char* GetResourceTypeCstr()        const { return typeid(*this).name(); }
@@ -57,6 +57,10 @@ namespace spartan
         const aiScene* scene     = nullptr;
         mutex mutex_assimp;
 
+        // cooked geometry, when valid the mesh processing (optimization, lods, solidity) is skipped
+        bool use_cooked_geometry       = false;
+        uint32_t cooked_sub_mesh_index = 0;
+
         Matrix to_matrix(const aiMatrix4x4& transform)
         {
             return Matrix
@@ -104,6 +108,35 @@ namespace spartan
             entity->SetScaleLocal(matrix_engine.GetScale());
         }
 
+        void compute_node_mesh_count(const aiNode* node, uint32_t* count)
+        {
+            if (!node)
+                return;
+
+            (*count) += node->mNumMeshes;
+
+            for (uint32_t i = 0; i < node->mNumChildren; i++)
+            {
+                compute_node_mesh_count(node->mChildren[i], count);
+            }
+        }
+
+        uint64_t get_cooked_source_key(const string& file_path, const Mesh* mesh)
+        {
+            // anything that affects the processed geometry has to be part of the key, the path keeps
+            // sources with the same size and write time apart
+            const uint64_t settings[] = { FileSystem::GetFileStamp(file_path), mesh->GetFlags(), static_cast<uint64_t>(mesh->GetLodDropoff()) };
+            return FileSystem::HashBytes(settings, sizeof(settings), FileSystem::HashBytes(file_path.data(), file_path.size()));
+        }
+
+        // cooked geometry lives in the cache directory, never next to the source assets
+        string get_cooked_file_path(const uint64_t key)
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+            return ResourceCache::GetCacheDirectory() + "models/" + name + EXTENSION_MODEL;
+        }
+
         void compute_node_count(const aiNode* node, uint32_t* count)
         {
             if (!node)
@@ -492,9 +525,34 @@ namespace spartan
 
             model_has_animation = scene->mNumAnimations != 0;
 
+            // use cooked geometry if it was cooked from this exact file with the same settings
+            const uint64_t cooked_key     = get_cooked_source_key(file_path, mesh);
+            const string cooked_file_path = get_cooked_file_path(cooked_key);
+            use_cooked_geometry           = false;
+            cooked_sub_mesh_index         = 0;
+            if (FileSystem::IsFile(cooked_file_path) && mesh->LoadCooked(cooked_file_path, cooked_key))
+            {
+                // sub-meshes are added in node traversal order, so the counts must line up
+                uint32_t node_mesh_count = 0;
+                compute_node_mesh_count(scene->mRootNode, &node_mesh_count);
+                use_cooked_geometry = node_mesh_count == mesh->GetSubMeshCount();
+
+                if (!use_cooked_geometry)
+                {
+                    mesh->Clear();
+                }
+            }
+
             // recursively parse nodes
             ParseNode(scene->mRootNode);
 
+            // cook the processed geometry so the next load can skip processing
+            if (!use_cooked_geometry)
+            {
+                FileSystem::CreateDirectory_(FileSystem::GetDirectoryFromFilePath(cooked_file_path));
+                mesh->SaveCooked(cooked_file_path, cooked_key);
+            }
+
             // update model geometry
             {
                 while (ProgressTracker::GetProgress(ProgressType::ModelImporter).GetFraction() != 1.0f)
@@ -653,6 +711,16 @@ namespace spartan
         SP_ASSERT(assimp_mesh != nullptr);
         SP_ASSERT(entity_parent != nullptr);
 
+        // geometry was already loaded from the cooked file
+        if (use_cooked_geometry)
+        {
+            uint32_t sub_mesh_index = cooked_sub_mesh_index++;
+            entity_parent->AddComponent<Renderable>()->SetMesh(mesh, sub_mesh_index);
+            ParseMeshMaterial(assimp_mesh, entity_parent);
+            ParseNodes(assimp_mesh);
+            return;
+        }
+
         const uint32_t vertex_count = assimp_mesh->mNumVertices;
         const uint32_t index_count  = assimp_mesh->mNumFaces * 3;
 
@@ -720,7 +788,14 @@ namespace spartan
         // set the geometry
         entity_parent->AddComponent<Renderable>()->SetMesh(mesh, sub_mesh_index);
 
-        // material
+        ParseMeshMaterial(assimp_mesh, entity_parent);
+
+        // Bones
+        ParseNodes(assimp_mesh);
+    }
+
+    void ModelImporter::ParseMeshMaterial(aiMesh* assimp_mesh, shared_ptr<Entity> entity_parent)
+    {
         if (scene->HasMaterials())
         {
             // get aiMaterial
@@ -742,9 +817,6 @@ namespace spartan
             // add a renderable and set the material to it
             entity_parent->AddComponent<Renderable>()->SetMaterial(material);
         }
-
-        // Bones
-        ParseNodes(assimp_mesh);
     }
 
     void ModelImporter::ParseAnimations()
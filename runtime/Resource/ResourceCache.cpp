@@ -19,7 +19,7 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ==================
+//= INCLUDES ====================
 #include "pch.h"
 #include "ResourceCache.h"
 #include "../Rendering/Mesh.h"
@@ -27,7 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 SP_WARNINGS_OFF
 #include "../IO/pugixml.hpp"
 SP_WARNINGS_ON
-//=============================
+//===============================
 
 //= NAMESPACES ================
 using namespace std;
@@ -44,6 +44,93 @@ namespace spartan
         mutex m_mutex;
         bool use_root_shader_directory = false;
 
+        // indices, so that lookups don't have to scan all resources
+        constexpr uint32_t resource_type_count = static_cast<uint32_t>(ResourceType::Max);
+        struct ResourcePosition
+        {
+            size_t all  = 0; // index into m_resources
+            size_t type = 0; // index into m_resources_by_type
+        };
+        unordered_map<uint64_t, ResourcePosition> m_resource_positions;                         // object id -> positions, so removal doesn't have to search
+        unordered_map<string, shared_ptr<IResource>> m_resources_by_path;
+        array<unordered_map<string, shared_ptr<IResource>>, resource_type_count> m_resources_by_name;
+        array<vector<shared_ptr<IResource>>, resource_type_count> m_resources_by_type;
+
+        uint32_t type_index(const ResourceType type)
+        {
+            return min(static_cast<uint32_t>(type), resource_type_count - 1);
+        }
+
+        // renames are forwarded by the resources, index hits are still validated in case a name was set through a base class
+        template<typename Getter>
+        shared_ptr<IResource>* find_in_index(unordered_map<string, shared_ptr<IResource>>& index, const string& key, Getter get_key)
+        {
+            auto it = index.find(key);
+            if (it == index.end())
+                return nullptr;
+
+            if (get_key(it->second.get()) != key)
+            {
+                index.erase(it);
+                return nullptr;
+            }
+
+            return &it->second;
+        }
+
+        void add_to_indices(const shared_ptr<IResource>& resource)
+        {
+            const uint32_t type = type_index(resource->GetResourceType());
+            m_resource_positions[resource->GetObjectId()] = { m_resources.size(), m_resources_by_type[type].size() };
+            m_resources.emplace_back(resource);
+            m_resources_by_type[type].emplace_back(resource);
+
+            // first come, first served, like a linear scan would
+            const string& path = resource->GetResourceFilePath();
+            if (!path.empty())
+            {
+                m_resources_by_path.emplace(path, resource);
+            }
+
+            if (!resource->GetObjectName().empty())
+            {
+                m_resources_by_name[type].emplace(resource->GetObjectName(), resource);
+            }
+        }
+
+        // only removes the entry if it belongs to the resource, another resource may have claimed the key first
+        void remove_from_index(unordered_map<string, shared_ptr<IResource>>& index, const string& key, const IResource* resource)
+        {
+            auto it = index.find(key);
+            if (it != index.end() && it->second.get() == resource)
+            {
+                index.erase(it);
+            }
+        }
+
+        // swaps with the last resource and pops, then points the moved resource's position at its new slot
+        void remove_at(vector<shared_ptr<IResource>>& resources, const size_t position, size_t ResourcePosition::* member)
+        {
+            if (position != resources.size() - 1)
+            {
+                resources[position] = move(resources.back());
+                m_resource_positions[resources[position]->GetObjectId()].*member = position;
+            }
+            resources.pop_back();
+        }
+
+        void clear_indices()
+        {
+            m_resources.clear();
+            m_resource_positions.clear();
+            m_resources_by_path.clear();
+            for (uint32_t i = 0; i < resource_type_count; i++)
+            {
+                m_resources_by_name[i].clear();
+                m_resources_by_type[i].clear();
+            }
+        }
+
         const char* resource_type_to_string(const ResourceType type)
         {
             switch (type)
@@ -92,50 +179,145 @@ namespace spartan
         SP_SUBSCRIBE_TO_EVENT(EventType::WorldClear, SP_EVENT_HANDLER_STATIC(Shutdown));
     }
     
-	shared_ptr<IResource>& ResourceCache::GetByName(const string& name, const ResourceType type)
+    shared_ptr<IResource> ResourceCache::GetByName(const string& name, const ResourceType type)
     {
         lock_guard<mutex> guard(m_mutex);
 
-        for (shared_ptr<IResource>& resource : m_resources)
+        const uint32_t type_slot = type_index(type);
+        auto get_name            = [](const IResource* resource) -> const string& { return resource->GetObjectName(); };
+        if (shared_ptr<IResource>* resource = find_in_index(m_resources_by_name[type_slot], name, get_name))
+            return *resource;
+
+        // a name that was set without going through IResource::SetObjectName() isn't in the index, so a miss falls back to a scan of the type
+        for (const shared_ptr<IResource>& resource : m_resources_by_type[type_slot])
         {
-            if (name == resource->GetObjectName())
+            if (resource->GetObjectName() == name)
+            {
+                m_resources_by_name[type_slot].emplace(name, resource);
                 return resource;
+            }
+        }
+
+        return nullptr;
+    }
+
+    shared_ptr<IResource> ResourceCache::GetByPath(const string& path)
+    {
+        lock_guard<mutex> guard(m_mutex);
+
+        auto get_path = [](const IResource* resource) -> const string& { return resource->GetResourceFilePath(); };
+        if (shared_ptr<IResource>* resource = find_in_index(m_resources_by_path, path, get_path))
+            return *resource;
+
+        return nullptr;
+    }
+
+    vector<shared_ptr<IResource>> ResourceCache::GetByType(const ResourceType type /*= ResourceType::Max*/)
+    {
+        lock_guard<mutex> guard(m_mutex);
+
+        if (type == ResourceType::Max)
+            return m_resources;
+
+        return m_resources_by_type[type_index(type)];
+    }
+
+    shared_ptr<IResource> ResourceCache::Cache(const shared_ptr<IResource>& resource)
+    {
+        if (!resource)
+            return nullptr;
+
+        // lookup and insertion happen under the same lock, so concurrent loaders of the same file end up sharing one resource
+        lock_guard<mutex> guard(m_mutex);
+
+        // return cached resource if it already exists
+        const string& path = resource->GetResourceFilePath();
+        if (!path.empty())
+        {
+            auto get_path = [](const IResource* resource) -> const string& { return resource->GetResourceFilePath(); };
+            if (shared_ptr<IResource>* existing = find_in_index(m_resources_by_path, path, get_path))
+                return *existing;
         }
 
-        static shared_ptr<IResource> empty;
-        return empty;
+        // the same object can't be cached twice
+        auto it = m_resource_positions.find(resource->GetObjectId());
+        if (it != m_resource_positions.end())
+            return m_resources[it->second.all];
+
+        // if not, cache it and return the cached resource
+        add_to_indices(resource);
+        return resource;
+    }
+
+    void ResourceCache::Remove(const IResource* resource)
+    {
+        if (!resource)
+            return;
+
+        lock_guard<mutex> guard(m_mutex);
+
+        auto it = m_resource_positions.find(resource->GetObjectId());
+        if (it == m_resource_positions.end())
+            return;
+
+        // keep a reference until all indices have let go of it
+        const ResourcePosition position = it->second;
+        shared_ptr<IResource> removed   = m_resources[position.all];
+        m_resource_positions.erase(it);
+
+        // indices
+        const uint32_t type = type_index(removed->GetResourceType());
+        remove_at(m_resources, position.all, &ResourcePosition::all);
+        remove_at(m_resources_by_type[type], position.type, &ResourcePosition::type);
+        remove_from_index(m_resources_by_path, removed->GetResourceFilePath(), removed.get());
+        remove_from_index(m_resources_by_name[type], removed->GetObjectName(), removed.get());
     }
 
-    vector<shared_ptr<IResource>> ResourceCache::GetByType(const ResourceType type /*= ResourceType::Unknown*/)
+    void ResourceCache::OnResourceRenamed(const IResource* resource, const string& path_previous, const string& name_previous)
     {
         lock_guard<mutex> guard(m_mutex);
 
-        vector<shared_ptr<IResource>> resources;
-        for (shared_ptr<IResource>& resource : m_resources)
+        auto it = m_resource_positions.find(resource->GetObjectId());
+        if (it == m_resource_positions.end())
+            return;
+
+        const shared_ptr<IResource>& cached = m_resources[it->second.all];
+        if (cached.get() != resource)
+            return;
+
+        const string& path = resource->GetResourceFilePath();
+        if (path != path_previous)
         {
-            if (resource->GetResourceType() == type || type == ResourceType::Max)
+            remove_from_index(m_resources_by_path, path_previous, resource);
+            if (!path.empty())
             {
-                resources.emplace_back(resource);
+                m_resources_by_path.emplace(path, cached);
             }
         }
 
-        return resources;
+        const string& name = resource->GetObjectName();
+        if (name != name_previous)
+        {
+            unordered_map<string, shared_ptr<IResource>>& index = m_resources_by_name[type_index(resource->GetResourceType())];
+            remove_from_index(index, name_previous, resource);
+            if (!name.empty())
+            {
+                index.emplace(name, cached);
+            }
+        }
     }
 
-    uint64_t ResourceCache::GetMemoryUsage(ResourceType type /*= Resource_Unknown*/)
+    uint64_t ResourceCache::GetMemoryUsage(ResourceType type /*= ResourceType::Max*/)
     {
         lock_guard<mutex> guard(m_mutex);
 
+        // sizes can change after caching (e.g. once a texture is prepared for the gpu), so they are summed on demand
+        const vector<shared_ptr<IResource>>& resources = type == ResourceType::Max ? m_resources : m_resources_by_type[type_index(type)];
+
         uint64_t size = 0;
-        for (shared_ptr<IResource>& resource : m_resources)
+        for (const shared_ptr<IResource>& resource : resources)
         {
-            if (resource->GetResourceType() == type || type == ResourceType::Max)
-            {
-                if (SpartanObject* object = dynamic_cast<SpartanObject*>(resource.get()))
-                {
-                    size += object->GetObjectSize();
-                }
-            }
+            size += resource->GetObjectSize();
         }
 
         return size;
@@ -143,7 +325,7 @@ namespace spartan
 
     void ResourceCache::Save(pugi::xml_node& node)
     {
-        for (const auto& resource : GetResources())
+        for (const auto& resource : GetByType())
         {
             // skip resources without a file path (e.g., procedural/in-memory only)
             if (resource->GetResourceFilePath().empty())
@@ -184,8 +366,10 @@ namespace spartan
     
     void ResourceCache::Shutdown()
     {
+        unique_lock<mutex> lock(m_mutex);
         uint32_t resource_count = static_cast<uint32_t>(m_resources.size());
-        m_resources.clear();
+        clear_indices();
+        lock.unlock();
 
         if (resource_count != 0)
         { 
@@ -195,7 +379,12 @@ namespace spartan
 
     uint32_t ResourceCache::GetResourceCount(const ResourceType type)
     {
-        return static_cast<uint32_t>(GetByType(type).size());
+        lock_guard<mutex> guard(m_mutex);
+
+        if (type == ResourceType::Max)
+            return static_cast<uint32_t>(m_resources.size());
+
+        return static_cast<uint32_t>(m_resources_by_type[type_index(type)].size());
     }
 
     void ResourceCache::AddResourceDirectory(const ResourceDirectory type, const string& directory)
@@ -243,8 +432,20 @@ namespace spartan
         return "Data";
     }
 
-    vector<shared_ptr<IResource>>& ResourceCache::GetResources()
+    string ResourceCache::GetCacheDirectory()
     {
+        const string directory = m_project_directory + "cache/";
+        if (!FileSystem::Exists(directory))
+        {
+            FileSystem::CreateDirectory_(directory);
+        }
+
+        return directory;
+    }
+
+    vector<shared_ptr<IResource>> ResourceCache::GetResources()
+    {
+        lock_guard<mutex> guard(m_mutex);
         return m_resources;
     }
 
@@ -52,7 +52,7 @@ namespace spartan
         static void Shutdown();
 
         // get by name
-        static std::shared_ptr<IResource>& GetByName(const std::string& name, ResourceType type);
+        static std::shared_ptr<IResource> GetByName(const std::string& name, ResourceType type);
         template <class T> 
         static std::shared_ptr<T> GetByName(const std::string& name) 
         { 
@@ -63,32 +63,19 @@ namespace spartan
         static std::vector<std::shared_ptr<IResource>> GetByType(ResourceType type = ResourceType::Max);
 
         // get by path
+        static std::shared_ptr<IResource> GetByPath(const std::string& path);
         template <class T>
         static std::shared_ptr<T> GetByPath(const std::string& path)
         {
-            for (std::shared_ptr<IResource>& resource : GetResources())
-            {
-                if (path == resource->GetResourceFilePath())
-                    return std::static_pointer_cast<T>(resource);
-            }
-
-            return nullptr;
+            return std::static_pointer_cast<T>(GetByPath(path));
         }
 
         // caches resource, or replaces with existing cached resource
+        static std::shared_ptr<IResource> Cache(const std::shared_ptr<IResource>& resource);
         template <class T>
         static std::shared_ptr<T> Cache(const std::shared_ptr<T> resource)
         {
-            if (!resource)
-                return nullptr;
-
-            // return cached resource if it already exists
-            if (std::shared_ptr<T> existing = GetByPath<T>(resource->GetResourceFilePath()))
-                return existing;
-
-            // if not, cache it and return the cached resource
-            std::lock_guard<std::mutex> guard(GetMutex());
-            return std::static_pointer_cast<T>(GetResources().emplace_back(resource));
+            return std::static_pointer_cast<T>(Cache(std::static_pointer_cast<IResource>(resource)));
         }
 
         // loads a resource and adds it to the resource cache
@@ -102,7 +89,6 @@ namespace spartan
             }
 
             // return cached resource if it already exists
-            const std::string name = FileSystem::GetFileNameWithoutExtensionFromFilePath(file_path);
             if (std::shared_ptr<T> existing = GetByPath<T>(file_path))
                 return existing;
 
@@ -114,25 +100,15 @@ namespace spartan
             }
             resource->SetResourceFilePath(file_path);
             resource->LoadFromFile(file_path);
-            return Cache<T>(resource); // cache and return
+            return Cache<T>(resource); // cache and return, if another thread loaded it first, theirs is returned
         }
 
+        static void Remove(const IResource* resource);
+        static void OnResourceRenamed(const IResource* resource, const std::string& path_previous, const std::string& name_previous); // keeps the lookups current
         template <class T>
         static void Remove(std::shared_ptr<T>& resource)
         {
-            if (!resource)
-                return;
-
-            GetResources().erase
-            (
-                std::remove_if
-                (
-                    GetResources().begin(),
-                    GetResources().end(),
-                    [](std::shared_ptr<IResource> resource) { return dynamic_cast<SpartanObject*>(resource.get())->GetObjectId() == resource->GetObjectId(); }
-                ),
-                GetResources().end()
-            );
+            Remove(static_cast<const IResource*>(resource.get()));
         }
 
         // memory
@@ -146,9 +122,10 @@ namespace spartan
         static std::string GetProjectDirectoryAbsolute();
         static const std::string& GetProjectDirectory();
         static std::string GetDataDirectory();
+        static std::string GetCacheDirectory(); // derived data (cooked collision etc), safe to delete
 
         // misc
-        static std::vector<std::shared_ptr<IResource>>& GetResources();
+        static std::vector<std::shared_ptr<IResource>> GetResources(); // a snapshot, the cache can change as soon as the lock is released
         static std::mutex& GetMutex();
         static bool GetUseRootShaderDirectory();
         static void SetUseRootShaderDirectory(const bool use_root_shader_directory);
@@ -153,85 +153,15 @@ namespace spartan
             return;
         }
 
-        // traces ray against all AABBs in the world
-        Ray ray = ComputePickingRay();
-        vector<RayHit> hits;
+        // hits hold raw pointers, the selection is tracked through the world's shared pointer
+        RayHit hit;
+        if (World::RayCast(ComputePickingRay(), hit))
         {
-            const vector<shared_ptr<Entity>>& entities = World::GetEntities();
-            for (shared_ptr<Entity>entity : entities)
-            {
-                // make sure there entity has a renderable
-                if (!entity->GetComponent<Renderable>())
-                    continue;
-
-                // get object oriented bounding box
-                const BoundingBox& aabb = entity->GetComponent<Renderable>()->GetBoundingBox();
-
-                // compute hit distance
-                float distance = ray.HitDistance(aabb);
-
-                // don't store hit data if there was no hit
-                if (distance == std::numeric_limits<float>::infinity())
-                    continue;
-
-                hits.emplace_back(
-                    entity,                                         // entity
-                    ray.GetStart() + ray.GetDirection() * distance, // position
-                    distance,                                       // distance
-                    distance == 0.0f                                // inside
-                );
-            }
-
-            // sort by distance (ascending)
-            sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b) { return a.m_distance < b.m_distance; });
+            m_selected_entity = World::GetEntityById(hit.m_entity->GetObjectId());
         }
-
-        // check if there are any hits
-        if (hits.empty())
+        else
         {
             m_selected_entity.reset();
-            return;
-        }
-
-        // if there is a single hit, return that
-        if (hits.size() == 1)
-        {
-            m_selected_entity = hits.front().m_entity;
-            return;
-        }
-
-        // if there are more hits, perform triangle intersection
-        float distance_min = numeric_limits<float>::max();
-        for (RayHit& hit : hits)
-        {
-            // Get entity geometry
-            Renderable* renderable = hit.m_entity->GetComponent<Renderable>();
-            vector<uint32_t> indicies;
-            vector<RHI_Vertex_PosTexNorTan> vertices;
-            renderable->GetGeometry(&indicies, &vertices);
-            if (indicies.empty()|| vertices.empty())
-            {
-                SP_LOG_ERROR("Failed to get geometry of entity %s, skipping intersection test.");
-                continue;
-            }
-
-            // Compute matrix which can transform vertices to view space
-            Matrix vertex_transform = hit.m_entity->GetMatrix();
-
-            // Go through each face
-            for (uint32_t i = 0; i < indicies.size(); i += 3)
-            {
-                Vector3 p1_world = Vector3(vertices[indicies[i]].pos) * vertex_transform;
-                Vector3 p2_world = Vector3(vertices[indicies[i + 1]].pos) * vertex_transform;
-                Vector3 p3_world = Vector3(vertices[indicies[i + 2]].pos) * vertex_transform;
-
-                float distance = ray.HitDistance(p1_world, p2_world, p3_world);
-                if (distance < distance_min)
-                {
-                    m_selected_entity = hit.m_entity;
-                    distance_min      = distance;
-                }
-            }
         }
     }
 
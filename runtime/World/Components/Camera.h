@@ -132,6 +132,7 @@ namespace spartan
         float GetAspectRatio() const;
   
         // frustum
+        const math::Frustum& GetFrustum() const { return m_frustum; }
         bool IsInViewFrustum(const math::BoundingBox& bounding_box) const;
         bool IsInViewFrustum(std::shared_ptr<Renderable> renderable) const;
 
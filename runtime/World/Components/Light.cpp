@@ -210,7 +210,7 @@ namespace spartan
                 }
             }
 
-            SP_FIRE_EVENT(EventType::LightOnChanged);
+            SP_FIRE_EVENT_DEFERRED(EventType::LightOnChanged);
         }
     }
 
@@ -233,7 +233,7 @@ namespace spartan
         m_temperature_kelvin = temperature_kelvin;
         m_color_rgb          = Color(temperature_kelvin);
 
-        SP_FIRE_EVENT(EventType::LightOnChanged);
+        SP_FIRE_EVENT_DEFERRED(EventType::LightOnChanged);
     }
 
     void Light::SetColor(const Color& rgb)
@@ -263,7 +263,7 @@ namespace spartan
         else if (rgb == Color::light_photo_flash)
             m_temperature_kelvin = 5500.0f;
 
-        SP_FIRE_EVENT(EventType::LightOnChanged);
+        SP_FIRE_EVENT_DEFERRED(EventType::LightOnChanged);
     }
 
     void Light::SetIntensity(const LightIntensity intensity)
@@ -303,14 +303,14 @@ namespace spartan
             m_intensity_lumens_lux = 0.0f;
         }
 
-        SP_FIRE_EVENT(EventType::LightOnChanged);
+        SP_FIRE_EVENT_DEFERRED(EventType::LightOnChanged);
     }
 
     void Light::SetIntensity(const float lumens_lux)
     {
         m_intensity_lumens_lux = lumens_lux;
         m_intensity            = LightIntensity::custom;
-        SP_FIRE_EVENT(EventType::LightOnChanged);
+        SP_FIRE_EVENT_DEFERRED(EventType::LightOnChanged);
     }
 
     float Light::GetIntensityWatt() const
@@ -340,6 +340,7 @@ namespace spartan
 
         m_range = range;
         UpdateMatrices();
+        GetEntity()->MarkBoundsDirty(); // the range is the light's extent in the spatial index
     }
 
     void Light::SetAngle(float angle)
@@ -384,7 +385,7 @@ namespace spartan
         ComputeProjectionMatrix();
         SetFlag(LightFlags::ShadowDirty);
 
-        SP_FIRE_EVENT(EventType::LightOnChanged);
+        SP_FIRE_EVENT_DEFERRED(EventType::LightOnChanged);
     }
 
     void Light::ComputeViewMatrix()
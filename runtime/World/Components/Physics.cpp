@@ -23,7 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "pch.h"
 #include "Physics.h"
 #include "Renderable.h"
-#include "Camera.h"
+#include "Terrain.h"
 #include "../Entity.h"
 #include "../../RHI/RHI_Vertex.h"
 #include "../../IO/FileStream.h"
@@ -52,12 +52,219 @@ namespace spartan
 {
     namespace
     {
-        const float distance_deactivate = 80.0f;
-        const float distance_activate   = 40.0f;
-        const float standing_height     = 1.8f;
-        const float crouch_height       = 0.7f;
+        const float standing_height = 1.8f;
+        const float crouch_height   = 0.7f;
 
         void* controller_manager = nullptr;
+
+        PxShape* create_height_field_shape(Entity* entity, PxPhysics* physics, PxMaterial* material, PxHeightField** height_field_out)
+        {
+            // the terrain itself gets one field, a tile gets the part of the parent's field under its bounds
+            Terrain* terrain = entity->GetComponent<Terrain>();
+            bool is_tile     = false;
+            if (!terrain)
+            {
+                if (shared_ptr<Entity> parent = entity->GetParent())
+                {
+                    terrain = parent->GetComponent<Terrain>();
+                    is_tile = terrain != nullptr;
+                }
+            }
+
+            if (!terrain || !terrain->GetHeightData() || terrain->GetHeightFieldWidth() < 2 || terrain->GetHeightFieldLength() < 2)
+            {
+                SP_LOG_ERROR("No terrain height samples found for the height field");
+                return nullptr;
+            }
+
+            const float* heights  = terrain->GetHeightData();
+            const uint32_t width  = terrain->GetHeightFieldWidth();
+            const uint32_t length = terrain->GetHeightFieldLength();
+            const float spacing   = terrain->GetHeightFieldSpacing();
+            const Vector3 origin  = terrain->GetHeightFieldOrigin();
+
+            // sample range, in the terrain's local space
+            uint32_t x_start = 0, x_end = width - 1;
+            uint32_t z_start = 0, z_end = length - 1;
+            Vector3 position = Vector3::Zero;
+            if (is_tile)
+            {
+                Renderable* renderable = entity->GetComponent<Renderable>();
+                if (!renderable)
+                {
+                    SP_LOG_ERROR("Terrain tiles need a Renderable to determine their bounds");
+                    return nullptr;
+                }
+
+                position                = entity->GetPositionLocal();
+                const BoundingBox& box  = renderable->GetBoundingBox();
+                const Vector3 to_local  = position - entity->GetPosition();
+                const Vector3 index_min = (box.GetMin() + to_local - origin) / spacing;
+                const Vector3 index_max = (box.GetMax() + to_local - origin) / spacing;
+                auto to_index = [](float value, uint32_t count) { return static_cast<uint32_t>(clamp(value, 0.0f, static_cast<float>(count - 1))); };
+                x_start = to_index(floor(index_min.x), width);
+                x_end   = to_index(ceil(index_max.x), width);
+                z_start = to_index(floor(index_min.z), length);
+                z_end   = to_index(ceil(index_max.z), length);
+                if (x_end <= x_start || z_end <= z_start)
+                    return nullptr;
+            }
+
+            // quantize to 16 bits relative to the lowest sample, physx rows run along x and columns along z
+            const uint32_t rows    = x_end - x_start + 1;
+            const uint32_t columns = z_end - z_start + 1;
+            float height_min       = FLT_MAX;
+            float height_max       = -FLT_MAX;
+            for (uint32_t z = z_start; z <= z_end; z++)
+            {
+                for (uint32_t x = x_start; x <= x_end; x++)
+                {
+                    height_min = min(height_min, heights[z * width + x]);
+                    height_max = max(height_max, heights[z * width + x]);
+                }
+            }
+            const float height_scale = max((height_max - height_min) / 32767.0f, 0.0001f);
+
+            // the default tessellation splits cells along the same diagonal as the terrain's triangles
+            vector<PxHeightFieldSample> samples(static_cast<size_t>(rows) * columns);
+            for (uint32_t row = 0; row < rows; row++)
+            {
+                for (uint32_t column = 0; column < columns; column++)
+                {
+                    const float height          = heights[(z_start + column) * width + (x_start + row)];
+                    PxHeightFieldSample& sample = samples[static_cast<size_t>(row) * columns + column];
+                    sample.height               = static_cast<PxI16>(lroundf((height - height_min) / height_scale));
+                    sample.materialIndex0       = 0;
+                    sample.materialIndex1       = 0;
+                }
+            }
+
+            PxHeightFieldDesc desc;
+            desc.format                 = PxHeightFieldFormat::eS16_TM;
+            desc.nbRows                 = rows;
+            desc.nbColumns              = columns;
+            desc.samples.data           = samples.data();
+            desc.samples.stride         = sizeof(PxHeightFieldSample);
+            PxHeightField* height_field = PxCreateHeightField(desc);
+            if (!height_field)
+            {
+                SP_LOG_ERROR("Failed to create height field");
+                return nullptr;
+            }
+            *height_field_out = height_field;
+
+            // the field starts at its first sample, while the body sits at the entity
+            PxHeightFieldGeometry geometry(height_field, PxMeshGeometryFlags(), height_scale, spacing, spacing);
+            PxShape* shape = physics->createShape(geometry, *material);
+            shape->setLocalPose(PxTransform(PxVec3(
+                origin.x + static_cast<float>(x_start) * spacing - position.x,
+                height_min - position.y,
+                origin.z + static_cast<float>(z_start) * spacing - position.z
+            )));
+
+            return shape;
+        }
+    }
+
+    namespace cooking
+    {
+        const float simplification_ratio      = 0.1f; // keep 10% of the original indices
+        const size_t simplification_index_min = 512;  // prevent over-simplification
+        const uint32_t version                = 1;    // bump when the cooking code changes in a way that the key can't see
+
+        PxCookingParams get_params()
+        {
+            PxTolerancesScale scale;
+            scale.length                          = 1.0f;                         // 1 unit = 1 meter
+            scale.speed                           = PhysicsWorld::GetGravity().y; // gravity is in meters per second
+            PxCookingParams params(scale);
+            params.areaTestEpsilon                = 0.06f * scale.length * scale.length;
+            params.planeTolerance                 = 0.0007f;
+            params.convexMeshCookingType          = PxConvexMeshCookingType::eQUICKHULL;
+            params.suppressTriangleMeshRemapTable = false;
+            params.buildTriangleAdjacencies       = true;
+            params.buildGPUData                   = false;
+            params.meshPreprocessParams          |= PxMeshPreprocessingFlag::eWELD_VERTICES;
+            params.meshWeldTolerance              = 0.01f;
+            params.meshAreaMinLimit               = 0.0f;
+            params.meshEdgeLengthMaxLimit         = 500.0f;
+            params.gaussMapLimit                  = 32;
+            params.maxWeightRatioInTet            = FLT_MAX;
+
+            return params;
+        }
+
+        uint64_t get_key(const vector<uint32_t>& indices, const vector<RHI_Vertex_PosTexNorTan>& vertices, const Vector3& scale, const PxCookingParams& params, const bool is_convex)
+        {
+            // the geometry itself identifies the mesh and sub-mesh, so procedural meshes are cached too
+            uint64_t key = FileSystem::HashBytes(vertices.data(), vertices.size() * sizeof(RHI_Vertex_PosTexNorTan));
+            key          = FileSystem::HashBytes(indices.data(), indices.size() * sizeof(uint32_t), key);
+
+            // hashed field by field, the struct has padding
+            const float settings[] =
+            {
+                scale.x, scale.y, scale.z,
+                params.scale.length, params.scale.speed,
+                params.areaTestEpsilon, params.planeTolerance, params.meshWeldTolerance, params.meshAreaMinLimit, params.meshEdgeLengthMaxLimit, params.maxWeightRatioInTet,
+                static_cast<float>(params.convexMeshCookingType), static_cast<float>(params.suppressTriangleMeshRemapTable), static_cast<float>(params.buildTriangleAdjacencies),
+                static_cast<float>(params.buildGPUData), static_cast<float>(static_cast<PxU32>(params.meshPreprocessParams)), static_cast<float>(params.gaussMapLimit),
+                simplification_ratio, static_cast<float>(simplification_index_min),
+                static_cast<float>(is_convex), static_cast<float>(version), static_cast<float>(PX_PHYSICS_VERSION)
+            };
+
+            return FileSystem::HashBytes(settings, sizeof(settings), key);
+        }
+
+        bool cook(vector<uint32_t> indices, vector<RHI_Vertex_PosTexNorTan> vertices, const Vector3& scale, const PxCookingParams& params, const bool is_convex, PxOutputStream& stream)
+        {
+            // simplify geometry
+            size_t target_index_count = static_cast<size_t>(indices.size() * simplification_ratio);
+            target_index_count        = max<size_t>(target_index_count, simplification_index_min);
+            geometry_processing::simplify(indices, vertices, target_index_count, false);
+
+            // convert vertices to physx format
+            vector<PxVec3> px_vertices;
+            px_vertices.reserve(vertices.size());
+            for (const auto& vertex : vertices)
+            {
+                px_vertices.emplace_back(vertex.pos[0] * scale.x, vertex.pos[1] * scale.y, vertex.pos[2] * scale.z);
+            }
+
+            if (!is_convex)
+            {
+                PxTriangleMeshDesc mesh_desc;
+                mesh_desc.points.count     = static_cast<PxU32>(px_vertices.size());
+                mesh_desc.points.stride    = sizeof(PxVec3);
+                mesh_desc.points.data      = px_vertices.data();
+                mesh_desc.triangles.count  = static_cast<PxU32>(indices.size() / 3);
+                mesh_desc.triangles.stride = 3 * sizeof(PxU32);
+                mesh_desc.triangles.data   = indices.data();
+
+                PxTriangleMeshCookingResult::Enum condition;
+                if (!PxCookTriangleMesh(params, mesh_desc, stream, &condition) || condition != PxTriangleMeshCookingResult::eSUCCESS)
+                {
+                    SP_LOG_ERROR("Failed to cook triangle mesh: %d", condition);
+                    return false;
+                }
+            }
+            else
+            {
+                PxConvexMeshDesc mesh_desc;
+                mesh_desc.points.count  = static_cast<PxU32>(px_vertices.size());
+                mesh_desc.points.stride = sizeof(PxVec3);
+                mesh_desc.points.data   = px_vertices.data();
+                mesh_desc.flags         = PxConvexFlag::eCOMPUTE_CONVEX;
+
+                PxConvexMeshCookingResult::Enum condition;
+                if (!PxCookConvexMesh(params, mesh_desc, stream, &condition) || condition != PxConvexMeshCookingResult::eSUCCESS)
+                {
+                    SP_LOG_ERROR("Failed to cook convex mesh: %d", condition);
+                    return false;
+                }
+            }
+
+            return true;
+        }
     }
 
     Physics::Physics(Entity* entity) : Component(entity)
@@ -85,6 +292,9 @@ namespace spartan
 
     void Physics::OnRemove()
     {
+        // bodies, shapes and materials can't change while a step is running
+        PhysicsWorld::WaitForSimulation();
+
         if (m_controller)
         {
             static_cast<PxController*>(m_controller)->release();
@@ -98,7 +308,8 @@ namespace spartan
             {
                 PxRigidActor* actor = static_cast<PxRigidActor*>(body);
                 PxScene* scene      = static_cast<PxScene*>(PhysicsWorld::GetScene());
-        
+
+                PhysicsWorld::RemoveStaticBody(actor);
                 if (actor->getScene())
                 {
                     scene->removeActor(*actor);
@@ -109,6 +320,13 @@ namespace spartan
         }
         m_bodies.clear();
 
+        // height fields are owned per body, cooked meshes are owned by the physics world
+        if (m_mesh && static_cast<PxBase*>(m_mesh)->is<PxHeightField>())
+        {
+            static_cast<PxHeightField*>(m_mesh)->release();
+        }
+        m_mesh = nullptr;
+
         if (PxMaterial* material = static_cast<PxMaterial*>(m_material))
         {
             material->release();
@@ -143,28 +361,38 @@ namespace spartan
                 m_velocity = Vector3::Zero;
             }
         }
-        else if (!m_is_static)
+        else if (!m_is_static && m_body_type != BodyType::Terrain)
         {
             Renderable* renderable                = GetEntity()->GetComponent<Renderable>();
             const vector<math::Matrix>& instances = renderable ? renderable->GetInstances() : vector<math::Matrix>();
             bool has_instances                    = !instances.empty();
 
+            bool is_playing = Engine::IsFlagSet(EngineMode::Playing);
+
             for (size_t i = 0; i < m_bodies.size(); i++)
             {
                 PxRigidActor* actor = static_cast<PxRigidActor*>(m_bodies[i]);
 
-                if (Engine::IsFlagSet(EngineMode::Playing))
+                if (is_playing)
                 {
-                    PxTransform pose       = actor->getGlobalPose();
-                    math::Matrix transform = math::Matrix::CreateTranslation(Vector3(pose.p.x, pose.p.y, pose.p.z)) * math::Matrix::CreateRotation(Quaternion(pose.q.x, pose.q.y, pose.q.z, pose.q.w));
+                    // rendered between the poses the physics world keeps, a body it hasn't stepped yet is shown where it is
+                    Vector3 position;
+                    Quaternion rotation;
+                    if (!PhysicsWorld::GetPoseInterpolated(actor, position, rotation))
+                    {
+                        PxTransform pose = actor->getGlobalPose();
+                        position         = Vector3(pose.p.x, pose.p.y, pose.p.z);
+                        rotation         = Quaternion(pose.q.x, pose.q.y, pose.q.z, pose.q.w);
+                    }
+
                     if (has_instances && renderable && i < instances.size())
                     {
-                        renderable->SetInstance(static_cast<uint32_t>(i), transform);
+                        renderable->SetInstance(static_cast<uint32_t>(i), math::Matrix::CreateTranslation(position) * math::Matrix::CreateRotation(rotation));
                     }
                     else if (i == 0)
                     {
-                        GetEntity()->SetPosition(Vector3(pose.p.x, pose.p.y, pose.p.z));
-                        GetEntity()->SetRotation(Quaternion(pose.q.x, pose.q.y, pose.q.z, pose.q.w));
+                        GetEntity()->SetPosition(position);
+                        GetEntity()->SetRotation(rotation);
                     }
                 }
                 else
@@ -195,34 +423,37 @@ namespace spartan
                 }
             }
         }
-
-        // distance-based activation/deactivation
-        if (m_body_type != BodyType::Controller && m_is_static)
+        else if (!Engine::IsFlagSet(EngineMode::Playing) && m_bounds_revision != GetEntity()->GetBoundsRevision())
         {
-            if (Camera* camera = World::GetCamera())
+            // static bodies follow their entity while editing, and are streamed by their new bounds, but only once it changed
+            // the renderable refits its bounds after this tick, that changes the revision again and the next tick pushes them
+            m_bounds_revision = GetEntity()->GetBoundsRevision();
+
+            Renderable* renderable                = GetEntity()->GetComponent<Renderable>();
+            const vector<math::Matrix>& instances = renderable ? renderable->GetInstances() : vector<math::Matrix>();
+
+            for (size_t i = 0; i < m_bodies.size(); i++)
             {
-                const Vector3 camera_pos = camera->GetEntity()->GetPosition();
-                PxScene* scene           = static_cast<PxScene*>(PhysicsWorld::GetScene());
+                if (!instances.empty() && i >= instances.size())
+                    break;
+
+                PxRigidActor* actor    = static_cast<PxRigidActor*>(m_bodies[i]);
+                math::Matrix transform = instances.empty() ? GetEntity()->GetMatrix() : instances[i];
+                PxTransform pose(
+                    PxVec3(transform.GetTranslation().x, transform.GetTranslation().y, transform.GetTranslation().z),
+                    PxQuat(transform.GetRotation().x, transform.GetRotation().y, transform.GetRotation().z, transform.GetRotation().w)
+                );
 
-                if (Renderable* renderable = GetEntity()->GetComponent<Renderable>())
+                PxTransform pose_current = actor->getGlobalPose();
+                if (!(pose_current.p == pose.p && pose_current.q == pose.q))
                 {
-                    for (uint32_t i = 0; i < static_cast<uint32_t>(m_bodies.size()); i++)
-                    {
-                        if (PxRigidActor* actor = static_cast<PxRigidActor*>(m_bodies[i]))
-                        { 
-                            const BoundingBox& bounding_box = renderable->HasInstancing() ? renderable->GetBoundingBoxInstance(static_cast<uint32_t>(i)) : renderable->GetBoundingBox();
-                            const Vector3 closest_point     = bounding_box.GetClosestPoint(camera_pos);
-                            const float distance_to_camera  = Vector3::Distance(camera_pos, closest_point);
-                            if (distance_to_camera > distance_deactivate && actor->getScene())
-                            {
-                                scene->removeActor(*actor);
-                            }
-                            else if (distance_to_camera <= distance_activate && !actor->getScene())
-                            {
-                                scene->addActor(*actor);
-                            }
-                        }
-                    }
+                    actor->setGlobalPose(pose);
+                }
+
+                // the bounds can trail the transform by a frame, so they are compared on their own, unchanged bounds return early
+                if (renderable)
+                {
+                    PhysicsWorld::UpdateStaticBody(actor, instances.empty() ? renderable->GetBoundingBox() : renderable->GetBoundingBoxInstance(static_cast<uint32_t>(i)));
                 }
             }
         }
@@ -318,6 +549,8 @@ namespace spartan
 
     void Physics::SetMass(float mass)
     {
+        PhysicsWorld::WaitForSimulation();
+
         // approximate mass from volume
         if (mass == mass_from_volume)
         {
@@ -386,6 +619,12 @@ namespace spartan
                     volume = 0.0f;  // skip volume-based calculation
                     break;
                 }
+                case BodyType::Terrain:
+                {
+                    // height fields are always static, they have no mass
+                    volume = 0.0f; // skip volume-based calculation
+                    break;
+                }
             }
     
             // calculate mass from volume if applicable
@@ -419,6 +658,8 @@ namespace spartan
 
     void Physics::SetFriction(float friction)
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_friction == friction)
             return;
     
@@ -431,6 +672,8 @@ namespace spartan
 
     void Physics::SetFrictionRolling(float friction_rolling)
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_friction_rolling == friction_rolling)
             return;
 
@@ -443,6 +686,8 @@ namespace spartan
 
     void Physics::SetRestitution(float restitution)
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_restitution == restitution)
             return;
 
@@ -455,6 +700,8 @@ namespace spartan
 
     void Physics::SetLinearVelocity(const Vector3& velocity) const
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_body_type == BodyType::Controller)
             return;
 
@@ -470,6 +717,8 @@ namespace spartan
 
     Vector3 Physics::GetLinearVelocity() const
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_bodies.empty())
             return Vector3::Zero;
 
@@ -484,6 +733,8 @@ namespace spartan
 
     void Physics::SetAngularVelocity(const Vector3& velocity) const
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_body_type == BodyType::Controller)
             return;
 
@@ -499,6 +750,8 @@ namespace spartan
 
     void Physics::ApplyForce(const Vector3& force, PhysicsForce mode) const
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_body_type == BodyType::Controller)
         {
             SP_LOG_WARNING("Don't call ApplyForce on a controller, call Move() instead");
@@ -523,6 +776,8 @@ namespace spartan
 
     void Physics::SetPositionLock(const Vector3& lock)
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_body_type == BodyType::Controller)
             return;
     
@@ -550,6 +805,8 @@ namespace spartan
 
     void Physics::SetRotationLock(const Vector3& lock)
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_body_type == BodyType::Controller)
             return;
     
@@ -572,6 +829,8 @@ namespace spartan
 
     void Physics::SetCenterOfMass(const Vector3& center_of_mass)
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_body_type == BodyType::Controller)
             return;
     
@@ -605,6 +864,8 @@ namespace spartan
 
     Entity* Physics::GetGroundEntity() const
     {
+        PhysicsWorld::WaitForSimulation();
+
         // check if body is a controller
         if (m_body_type != BodyType::Controller)
         {
@@ -694,6 +955,8 @@ namespace spartan
 
     void Physics::Move(const math::Vector3& offset)
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_body_type == BodyType::Controller && Engine::IsFlagSet(EngineMode::Playing))
         {
             if (!m_controller)
@@ -713,6 +976,8 @@ namespace spartan
 
     void Physics::Crouch(const bool crouch)
     {
+        PhysicsWorld::WaitForSimulation();
+
         if (m_body_type != BodyType::Controller || !m_controller || !Engine::IsFlagSet(EngineMode::Playing))
             return;
 
@@ -809,86 +1074,18 @@ namespace spartan
                     return;
                 }
 
-                // simplify geometry
-                float simplification_ratio = 0.1f; // keep 10% of the original indices
-                size_t target_index_count  = static_cast<size_t>(indices.size() * simplification_ratio);
-                target_index_count         = max<size_t>(target_index_count, 512); // prevent over-simplification
-                geometry_processing::simplify(indices, vertices, target_index_count, false);
-
-                // convert vertices to physx format
-                vector<PxVec3> px_vertices;
-                px_vertices.reserve(vertices.size());
-                Vector3 scale = GetEntity()->GetScale();
-                for (const auto& vertex : vertices)
+                // get or cook the collision mesh, entities with the same geometry and scale share it
+                const bool is_convex   = !IsStatic(); // static: triangle mesh, dynamic: convex mesh
+                const Vector3 scale    = GetEntity()->GetScale();
+                PxCookingParams params = cooking::get_params();
+                const uint64_t key     = cooking::get_key(indices, vertices, scale, params, is_convex);
+                m_mesh = PhysicsWorld::GetCookedMesh(key, is_convex, [&](void* stream)
                 {
-                    px_vertices.emplace_back(vertex.pos[0] * scale.x, vertex.pos[1] * scale.y, vertex.pos[2] * scale.z);
-                }
+                    return cooking::cook(move(indices), move(vertices), scale, params, is_convex, *static_cast<PxOutputStream*>(stream));
+                });
 
-                // cooking parameters
-                PxTolerancesScale _scale;
-                _scale.length                          = 1.0f;                         // 1 unit = 1 meter
-                _scale.speed                           = PhysicsWorld::GetGravity().y; // gravity is in meters per second
-                PxCookingParams params(_scale);         
-                params.areaTestEpsilon                 = 0.06f * _scale.length * _scale.length;
-                params.planeTolerance                  = 0.0007f;
-                params.convexMeshCookingType           = PxConvexMeshCookingType::eQUICKHULL;
-                params.suppressTriangleMeshRemapTable  = false;
-                params.buildTriangleAdjacencies        = true;
-                params.buildGPUData                    = false;
-                params.meshPreprocessParams           |= PxMeshPreprocessingFlag::eWELD_VERTICES;
-                params.meshWeldTolerance               = 0.01f;
-                params.meshAreaMinLimit                = 0.0f;
-                params.meshEdgeLengthMaxLimit          = 500.0f;
-                params.gaussMapLimit                   = 32;
-                params.maxWeightRatioInTet             = FLT_MAX;
-
-                PxInsertionCallback* insertion_callback = PxGetStandaloneInsertionCallback();
-                if (IsStatic()) // static: triangle mesh
-                {
-                    PxTriangleMeshDesc mesh_desc;
-                    mesh_desc.points.count     = static_cast<PxU32>(px_vertices.size());
-                    mesh_desc.points.stride    = sizeof(PxVec3);
-                    mesh_desc.points.data      = px_vertices.data();
-                    mesh_desc.triangles.count  = static_cast<PxU32>(indices.size() / 3);
-                    mesh_desc.triangles.stride = 3 * sizeof(PxU32);
-                    mesh_desc.triangles.data   = indices.data();
-
-                    // create
-                    PxTriangleMeshCookingResult::Enum condition;
-                    m_mesh = PxCreateTriangleMesh(params, mesh_desc, *insertion_callback, &condition);
-                    if (condition != PxTriangleMeshCookingResult::eSUCCESS)
-                    {
-                        SP_LOG_ERROR("Failed to create triangle mesh: %d", condition);
-                        if (m_mesh)
-                        {
-                            static_cast<PxTriangleMesh*>(m_mesh)->release();
-                            m_mesh = nullptr;
-                        }
-                        return;
-                    }
-                }
-                else // dynamic: convex mesh
-                {
-                    PxConvexMeshDesc mesh_desc;
-                    mesh_desc.points.count  = static_cast<PxU32>(px_vertices.size());
-                    mesh_desc.points.stride = sizeof(PxVec3);
-                    mesh_desc.points.data   = px_vertices.data();
-                    mesh_desc.flags         = PxConvexFlag::eCOMPUTE_CONVEX;
-
-                    // create
-                    PxConvexMeshCookingResult::Enum condition;
-                    m_mesh = PxCreateConvexMesh(params, mesh_desc, *insertion_callback, &condition);
-                    if (!m_mesh || condition != PxConvexMeshCookingResult::eSUCCESS)
-                    {
-                        SP_LOG_ERROR("Failed to create convex mesh: %d", condition);
-                        if (m_mesh)
-                        {
-                            static_cast<PxConvexMesh*>(m_mesh)->release();
-                            m_mesh = nullptr;
-                        }
-                        return;
-                    }
-                }
+                if (!m_mesh)
+                    return;
             }
 
             CreateBodies();
@@ -903,6 +1100,15 @@ namespace spartan
         const vector<math::Matrix>& instances = renderable ? renderable->GetInstances() : vector<math::Matrix>();
         size_t instance_count                 = instances.empty() ? 1 : instances.size();
 
+        // the height field only depends on the entity, so it's created once and its shape is shared by all bodies
+        PxShape* height_field_shape = nullptr;
+        if (m_body_type == BodyType::Terrain)
+        {
+            PxHeightField* height_field = nullptr;
+            height_field_shape          = create_height_field_shape(GetEntity(), physics, static_cast<PxMaterial*>(m_material), &height_field);
+            m_mesh                      = height_field;
+        }
+
         // create bodies and shapes
         m_bodies.resize(instance_count, nullptr);
         for (size_t i = 0; i < instance_count; i++)
@@ -913,7 +1119,7 @@ namespace spartan
                 PxQuat(transform.GetRotation().x, transform.GetRotation().y, transform.GetRotation().z, transform.GetRotation().w)
             );
             PxRigidActor* actor = nullptr;
-            if (IsStatic())
+            if (IsStatic() || m_body_type == BodyType::Terrain) // height fields can't be simulated
             {
                 actor = physics->createRigidStatic(pose);
             }
@@ -996,6 +1202,11 @@ namespace spartan
                     }
                     break;
                 }
+                case BodyType::Terrain:
+                {
+                    shape = height_field_shape;
+                    break;
+                }
                 case BodyType::Water:
                     {
                         Vector3 extents = renderable->GetBoundingBox().GetExtents();
@@ -1023,7 +1234,16 @@ namespace spartan
                 actor->attachShape(*shape);
             }
             actor->userData = reinterpret_cast<void*>(GetEntity());
-            scene->addActor(*actor);
+
+            // static bodies with bounds are streamed in by the physics world once the camera is close enough
+            if (actor->is<PxRigidStatic>() && renderable)
+            {
+                PhysicsWorld::AddStaticBody(actor, renderable->HasInstancing() ? renderable->GetBoundingBoxInstance(static_cast<uint32_t>(i)) : renderable->GetBoundingBox());
+            }
+            else
+            {
+                scene->addActor(*actor);
+            }
         
             m_bodies[i] = actor;
         }
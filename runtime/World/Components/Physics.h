@@ -48,6 +48,7 @@ namespace spartan
         Mesh,
         Controller,
         Water,
+        Terrain, // height field built from the terrain's samples, on the terrain entity (one field) or on its tiles (one field each)
         Max
     };
 
@@ -148,5 +149,6 @@ namespace spartan
         void* m_mesh                   = nullptr;
         std::vector<void*> m_bodies    = { nullptr };
         std::vector<PhysicsBodyMeshData> m_mesh_data;
+        uint32_t m_bounds_revision     = 0; // of the entity, when static bodies were last moved to it
     };
 }
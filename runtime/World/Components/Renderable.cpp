@@ -29,6 +29,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Resource/ResourceCache.h"
 #include "../../Rendering/Renderer.h"
 #include "../../Rendering/Material.h"
+#include "../../Geometry/Bvh.h"
 //=======================================
 
 //= NAMESPACES ===============
@@ -213,6 +214,8 @@ namespace spartan
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_bounding_box,      BoundingBox);
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_bounding_box_mesh, BoundingBox);
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_sub_mesh_index,    uint32_t);
+
+        ResizeVisibilityState();
     }
 
     Renderable::~Renderable()
@@ -325,12 +328,12 @@ namespace spartan
 
                     m_transform_previous = transform;
                     m_bounding_box_dirty = false;
+                    entity->MarkBoundsDirty();
                 }
             }
         }
 
-        UpdateFrustumAndDistanceCulling();
-        UpdateLodIndices();
+        // frustum/distance culling and lod selection happen in the renderer, over all renderables at once
     }
 
     void Renderable::SetMesh(Mesh* mesh, const uint32_t sub_mesh_index)
@@ -351,7 +354,7 @@ namespace spartan
             m_bounding_box_mesh = BoundingBox(vertices.data(), static_cast<uint32_t>(vertices.size()));
         }
 
-        OnTick(); // update bounding boxes, frustum and distance culling
+        OnTick(); // update bounding boxes
     }
 
     void Renderable::SetMesh(const MeshType type)
@@ -359,6 +362,53 @@ namespace spartan
         SetMesh(Renderer::GetStandardMesh(type).get());
     }
 
+    float Renderable::RayCast(const Ray& ray, const float distance_max, uint32_t* instance_index, Vector3* normal) const
+    {
+        float distance_closest = numeric_limits<float>::infinity();
+        const Bvh* bvh         = m_mesh ? m_mesh->GetBvh(m_sub_mesh_index) : nullptr;
+        if (!bvh)
+            return distance_closest;
+
+        // the ray is brought into the space of the geometry, its direction isn't renormalized so distances stay in world units
+        const Matrix& transform = GetEntity()->GetMatrix();
+        const uint32_t count    = HasInstancing() ? GetInstanceCount() : 1;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const float distance_limit = min(distance_closest, distance_max);
+            const BoundingBox& box     = HasInstancing() && i < m_bounding_box_instances.size() ? m_bounding_box_instances[i] : m_bounding_box;
+            if (ray.HitDistance(box) >= distance_limit)
+                continue;
+
+            const Matrix to_object  = (HasInstancing() ? transform * m_instances[i] : transform).Inverted();
+            const Vector3 origin    = ray.GetStart() * to_object;
+            const Vector3 direction = (ray.GetStart() + ray.GetDirection()) * to_object - origin;
+
+            Vector3 normal_object;
+            const float distance = bvh->Intersect(origin, direction, distance_limit, nullptr, normal ? &normal_object : nullptr);
+            if (distance < distance_closest)
+            {
+                distance_closest = distance;
+
+                if (instance_index)
+                {
+                    *instance_index = i;
+                }
+
+                // normals transform with the inverse transpose
+                if (normal)
+                {
+                    *normal = Vector3(
+                        normal_object.x * to_object.m00 + normal_object.y * to_object.m01 + normal_object.z * to_object.m02,
+                        normal_object.x * to_object.m10 + normal_object.y * to_object.m11 + normal_object.z * to_object.m12,
+                        normal_object.x * to_object.m20 + normal_object.y * to_object.m21 + normal_object.z * to_object.m22
+                    ).Normalized();
+                }
+            }
+        }
+
+        return distance_closest;
+    }
+
     void Renderable::GetGeometry(vector<uint32_t>* indices, vector<RHI_Vertex_PosTexNorTan>* vertices) const
     {
         m_mesh->GetGeometry(m_sub_mesh_index, indices, vertices);
@@ -496,6 +546,8 @@ namespace spartan
         m_instance_group_end_indices                       = instance_data->group_end_indices;
         m_instance_buffer                                  = instance_data->buffer;
         m_bounding_box_dirty                               = true;
+
+        ResizeVisibilityState();
     }
 
     void Renderable::SetInstance(const uint32_t index, const math::Matrix& transform)
@@ -527,57 +579,38 @@ namespace spartan
         }
     }
 
-    void Renderable::UpdateFrustumAndDistanceCulling()
+    void Renderable::SetVisible(const bool visible, const uint32_t instance_group_index /*= 0*/)
     {
-        if (Camera* camera = World::GetCamera())
+        // occlusion results can arrive for a group layout that has since changed
+        if (instance_group_index < m_is_visible.size())
         {
-            Vector3 camera_position = camera->GetEntity()->GetPosition();
-    
-            if (HasInstancing())
-            {
-                for (uint32_t group_index = 0; group_index < GetInstanceGroupCount(); group_index++)
-                {
-                    const BoundingBox& bounding_box = GetBoundingBoxInstanceGroup(group_index);
-
-                    // first, check if the bounding box is in the frustum
-                    if (camera->IsInViewFrustum(bounding_box))
-                    {
-                        // only if in frustum, calculate distance
-                        m_distance_squared[group_index] = Vector3::DistanceSquared(camera_position, bounding_box.GetClosestPoint(camera_position));
-                        m_is_visible[group_index]       = m_distance_squared[group_index] <= m_max_distance_render * m_max_distance_render;
-                    }
-                    else
-                    {
-                        // outside frustum, no need for distance check
-                        m_is_visible[group_index] = false;
-                    }
-                }
-            }
-            else
-            {
-                const BoundingBox& bounding_box = GetBoundingBox();
-
-                // first, check if the bounding box is in the frustum
-                if (camera->IsInViewFrustum(bounding_box))
-                {
-                    // only if in frustum, calculate distance
-                    m_distance_squared[0] = Vector3::DistanceSquared(camera_position, bounding_box.GetClosestPoint(camera_position));
-                    m_is_visible[0]       = m_distance_squared[0]  <= m_max_distance_render * m_max_distance_render;
-                }
-                else
-                {
-                    // outside frustum, no need for distance check
-                    m_is_visible[0] = false;
-                }
-            }
+            m_is_visible[instance_group_index] = visible;
         }
-        else
+    }
+
+    void Renderable::SetDistanceSquared(const float distance_squared, const uint32_t instance_group_index /*= 0*/)
+    {
+        if (instance_group_index < m_distance_squared.size())
         {
-            m_distance_squared.fill(0.0f);
-            m_is_visible.fill(true);
+            m_distance_squared[instance_group_index] = distance_squared;
         }
     }
 
+    void Renderable::ResizeVisibilityState()
+    {
+        const size_t count = max<size_t>(m_instance_group_end_indices.size(), 1);
+
+        m_distance_squared.assign(count, 0.0f);
+        m_is_visible.assign(count, 0);
+        m_lod_indices.assign(count, 0);
+    }
+
+    uint64_t Renderable::GetVisibilityStateSize() const
+    {
+        return sizeof(m_distance_squared) + sizeof(m_is_visible) + sizeof(m_lod_indices) +
+               m_distance_squared.capacity() * sizeof(float) + m_is_visible.capacity() * sizeof(uint8_t) + m_lod_indices.capacity() * sizeof(uint32_t);
+    }
+
     void Renderable::UpdateLodIndices()
     {
         // note: using projected angle for LOD selection, which is more perceptually accurate
@@ -598,7 +631,7 @@ namespace spartan
         // if no camera, use lowest detail lod for all
         if (!camera)
         {
-            m_lod_indices.fill(max_lod);
+            fill(m_lod_indices.begin(), m_lod_indices.end(), max_lod);
             return;
         }
     
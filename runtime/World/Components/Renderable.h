@@ -66,6 +66,9 @@ namespace spartan
         bool HasMesh() const { return m_mesh != nullptr; }
         bool IsSolid() const;
 
+        // closest hit against the triangles of the mesh (every instance if instanced), infinity if there is none
+        float RayCast(const math::Ray& ray, const float distance_max, uint32_t* instance_index = nullptr, math::Vector3* normal = nullptr) const;
+
         // bounding box
         const std::vector<uint32_t>& GetBoundingBoxGroupEndIndices() const               { return m_instance_group_end_indices; }
         uint32_t GetInstanceGroupCount() const                                           { return static_cast<uint32_t>(m_instance_group_end_indices.size()); }
@@ -101,8 +104,11 @@ namespace spartan
 
         // distance & visibility
         float GetDistanceSquared(const uint32_t instance_group_index = 0) const      { return m_distance_squared[instance_group_index]; }
-        bool IsVisible(const uint32_t instance_group_index = 0) const                { return m_is_visible[instance_group_index]; }
-        void SetVisible(const bool visible, const uint32_t instance_group_index = 0) { m_is_visible[instance_group_index] = visible; }
+        bool IsVisible(const uint32_t instance_group_index = 0) const                { return m_is_visible[instance_group_index] != 0; }
+        void SetVisible(const bool visible, const uint32_t instance_group_index = 0);
+        void SetDistanceSquared(const float distance_squared, const uint32_t instance_group_index = 0);
+        void UpdateLodIndices(); // call after visibility is known, the renderer does this for all renderables each frame
+        uint64_t GetVisibilityStateSize() const; // bytes held by the distance, visibility and lod state
 
         // flags
         bool HasFlag(const RenderableFlags flag) const { return m_flags & flag; }
@@ -113,8 +119,7 @@ namespace spartan
         void SetPreviousLights(uint64_t lights) { m_previous_lights = lights; }
 
     private:
-        void UpdateFrustumAndDistanceCulling();
-        void UpdateLodIndices();
+        void ResizeVisibilityState();
 
         // geometry/mesh
         Mesh* m_mesh                          = nullptr;
@@ -138,12 +143,12 @@ namespace spartan
         math::Matrix m_transform_previous = math::Matrix::Identity;
         uint32_t m_flags                  = RenderableFlags::CastsShadows;
 
-        // visibility & lods
-        float m_max_distance_render                                 = FLT_MAX;
-        float m_max_distance_shadow                                 = FLT_MAX;
-        std::array<float, renderer_max_entities> m_distance_squared = { 0.0f };
-        std::array<bool, renderer_max_entities> m_is_visible        = { false };
-        std::array<uint32_t, renderer_max_entities> m_lod_indices   = { 0 };
-        uint64_t m_previous_lights                                  = 0; // lights whose frustums this renderable was in last frame
+        // visibility & lods, one element per instance group (or a single one when not instanced)
+        float m_max_distance_render = FLT_MAX;
+        float m_max_distance_shadow = FLT_MAX;
+        std::vector<float> m_distance_squared;
+        std::vector<uint8_t> m_is_visible; // uint8_t instead of bool, std::vector<bool> is bit packed
+        std::vector<uint32_t> m_lod_indices;
+        uint64_t m_previous_lights  = 0; // lights whose frustums this renderable was in last frame
     };
 }
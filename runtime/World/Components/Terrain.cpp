@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Geometry/GeometryProcessing.h"
 #include "../../Core/ThreadPool.h"
 #include "../../Core/ProgressTracker.h"
+#include "../../IO/FileStream.h"
 //============================================
 
 //= NAMESPACES ===============
@@ -49,6 +50,9 @@ namespace spartan
         const uint32_t density              = 3;      // determines the number of positions extracted out of the height map (that means more triangles later down the line)
         const uint32_t scale                = 6;      // the scale of the mesh, this determines the physical size of the terrain, it doesn't affect density
         const bool create_border            = true;   // if true, the terrain will have a natural border around it, useful for creating mountains or walls, prevents the player from falling off the terrain
+        const uint32_t erosion_seed         = 1337;   // the same seed always erodes the same height map into the same terrain
+        const uint32_t tile_count           = 16;     // tiles per side, each tile is a sub-mesh with its own entity
+        const bool cache_compression        = true;   // encode cached tile geometry with meshoptimizer's lossless codecs, smaller files for a bit of decoding
     }
 
     namespace
@@ -268,40 +272,45 @@ namespace spartan
                 {
                     vector<float> smoothed_height_data = height_data_out; // create a copy to store the smoothed data
         
-                    for (uint32_t y = 0; y < height; y++)
+                    // rows only read the previous iteration, so they can be smoothed in parallel
+                    auto smooth_rows = [&height_data_out, &smoothed_height_data, width, height](uint32_t row_start, uint32_t row_end)
                     {
-                        for (uint32_t x = 0; x < width; x++)
+                        for (uint32_t y = row_start; y < row_end; y++)
                         {
-                            float sum      = height_data_out[y * width + x];
-                            uint32_t count = 1;
-        
-                            // iterate over neighboring pixels
-                            for (int ny = -1; ny <= 1; ++ny)
+                            for (uint32_t x = 0; x < width; x++)
                             {
-                                for (int nx = -1; nx <= 1; ++nx)
-                                {
-                                    // skip self/center pixel
-                                    if (nx == 0 && ny == 0)
-                                        continue;
+                                float sum      = height_data_out[y * width + x];
+                                uint32_t count = 1;
         
-                                    uint32_t neighbor_x = x + nx;
-                                    uint32_t neighbor_y = y + ny;
-        
-                                    // check boundaries
-                                    if (neighbor_x >= 0 && neighbor_x < width && neighbor_y >= 0 && neighbor_y < height)
+                                // iterate over neighboring pixels
+                                for (int ny = -1; ny <= 1; ++ny)
+                                {
+                                    for (int nx = -1; nx <= 1; ++nx)
                                     {
-                                        sum += height_data_out[neighbor_y * width + neighbor_x];
-                                        count++;
+                                        // skip self/center pixel
+                                        if (nx == 0 && ny == 0)
+                                            continue;
+        
+                                        uint32_t neighbor_x = x + nx;
+                                        uint32_t neighbor_y = y + ny;
+        
+                                        // check boundaries
+                                        if (neighbor_x >= 0 && neighbor_x < width && neighbor_y >= 0 && neighbor_y < height)
+                                        {
+                                            sum += height_data_out[neighbor_y * width + neighbor_x];
+                                            count++;
+                                        }
                                     }
                                 }
-                            }
         
-                            // average the sum
-                            smoothed_height_data[y * width + x] = sum / static_cast<float>(count);
+                                // average the sum
+                                smoothed_height_data[y * width + x] = sum / static_cast<float>(count);
+                            }
                         }
-                    }
+                    };
+                    ThreadPool::ParallelLoop(smooth_rows, height);
         
-                    height_data_out = smoothed_height_data;
+                    height_data_out.swap(smoothed_height_data);
                 }
             }
         
@@ -463,7 +472,7 @@ namespace spartan
             ThreadPool::ParallelLoop(generate_position_range, total_positions);
         }
 
-        void apply_wind_erosion(vector<Vector3>& positions, uint32_t width, uint32_t height, float wind_strength = 0.3f)
+        void apply_wind_erosion(vector<Vector3>& positions, uint32_t width, uint32_t height, float wind_strength = 0.3f, bool parallel = true)
         {
             // 3x3 gaussian kernel
             const float kernel[3][3] =
@@ -472,49 +481,51 @@ namespace spartan
                 {0.125f,  0.25f,  0.125f},
                 {0.0625f, 0.125f, 0.0625f}
             };
-            const int kernel_size = 3;
-            const int kernel_half = kernel_size / 2;
-        
-            // store original positions for reference
-           vector<Vector3> temp_positions = positions;
-           mutex positions_mutex;
+            const int kernel_half = 1;
         
-            // sequential wind erosion
-            for (uint32_t z = 0; z < height; ++z)
+            // the convolution reads the heights from before this pass, so rows can be processed in parallel
+            vector<float> heights(positions.size());
+            for (size_t i = 0; i < positions.size(); i++)
             {
-                for (uint32_t x = 0; x < width; ++x)
+                heights[i] = positions[i].y;
+            }
+
+            auto erode_rows = [&positions, &heights, &kernel, width, height, wind_strength](uint32_t row_start, uint32_t row_end)
+            {
+                for (uint32_t z = max(row_start, static_cast<uint32_t>(kernel_half)); z < min(row_end, height - kernel_half); ++z)
                 {
-                    // skip borders to avoid out-of-bounds access
-                    if (x < kernel_half || x >= width - kernel_half || z < kernel_half || z >= height - kernel_half)
-                        continue;
-        
-                    // apply gaussian convolution
-                    float new_height = 0.0f;
-                    for (int kz = -kernel_half; kz <= kernel_half; ++kz)
+                    for (uint32_t x = kernel_half; x < width - kernel_half; ++x)
                     {
-                        for (int kx = -kernel_half; kx <= kernel_half; ++kx)
+                        // apply gaussian convolution
+                        float new_height = 0.0f;
+                        for (int kz = -kernel_half; kz <= kernel_half; ++kz)
                         {
-                            uint32_t idx = (x + kx) + (z + kz) * width;
-                            new_height += temp_positions[idx].y * kernel[kz + kernel_half][kx + kernel_half];
+                            for (int kx = -kernel_half; kx <= kernel_half; ++kx)
+                            {
+                                new_height += heights[(x + kx) + (z + kz) * width] * kernel[kz + kernel_half][kx + kernel_half];
+                            }
                         }
-                    }
         
-                    // update height with wind strength (interpolate between original and convolved height)
-                    uint32_t idx = x + z * width;
-                    float original_height = positions[idx].y;
-                    float smoothed_height = new_height;
-                    float final_height = original_height + wind_strength * (smoothed_height - original_height);
-        
-                    // update
-                    {
-                        lock_guard<mutex> lock(positions_mutex);
-                        positions[idx].y = final_height;
+                        // interpolate between original and convolved height
+                        const uint32_t idx   = x + z * width;
+                        const float original = heights[idx];
+                        positions[idx].y     = original + wind_strength * (new_height - original);
                     }
                 }
+            };
+
+            if (parallel)
+            {
+                ThreadPool::ParallelLoop(erode_rows, height);
+            }
+            else
+            {
+                erode_rows(0, height);
             }
         }
         
-        void apply_erosion(vector<Vector3>& positions, uint32_t width, uint32_t height, uint32_t iterations = 1'000'000, uint32_t wind_interval = 50'000)
+        // parallel can be turned off to run everything on the calling thread, which gives the same result (used by the benchmark to check that)
+        void apply_erosion(vector<Vector3>& positions, uint32_t width, uint32_t height, uint32_t seed, uint32_t iterations = 1'000'000, uint32_t wind_interval = 50'000, bool parallel = true)
         {
             auto get_height = [&positions, width, height](float x, float z) -> float
             {
@@ -573,20 +584,40 @@ namespace spartan
             const uint32_t max_steps     = 30;   
             const float wind_strength    = 0.3f; 
         
-            // random number generation (unchanged)
-            mt19937 gen(random_device{}());
-            uniform_real_distribution<float> dist_x(1.0f, static_cast<float>(width) - 2.0f);
-            uniform_real_distribution<float> dist_z(1.0f, static_cast<float>(height) - 2.0f);
-        
-            for (uint32_t i = 0; i < iterations; ++i)
+            // droplets are simulated per tile, and a droplet can't get further than its reach from the tile it started in
+            // so tiles two apart never touch the same heights, and all tiles of one of the four checkerboard colors run in parallel
+            // every tile draws from its own random sequence, which makes the result independent of thread count and scheduling
+            const uint32_t reach        = max_steps + 3; // a cell per step, plus the footprint of the gradient and bilinear samples
+            const uint32_t tile_size    = 2 * reach + 2;
+            const uint32_t tile_count_x = (width + tile_size - 1) / tile_size;
+            const uint32_t tile_count_z = (height + tile_size - 1) / tile_size;
+
+            // droplets start in [1, size - 2], each tile gets a share proportional to its part of that area
+            auto get_span = [tile_size](uint32_t tile, uint32_t size, float* start, float* end)
+            {
+                *start = max(static_cast<float>(tile * tile_size), 1.0f);
+                *end   = min(static_cast<float>((tile + 1) * tile_size), static_cast<float>(size) - 2.0f);
+                return max(*end - *start, 0.0f);
+            };
+
+            vector<double> area_prefix(tile_count_x * tile_count_z + 1, 0.0);
+            for (uint32_t tz = 0; tz < tile_count_z; tz++)
             {
-                // apply wind erosion periodically
-                if (i % wind_interval == 0 && i != 0)
+                for (uint32_t tx = 0; tx < tile_count_x; tx++)
                 {
-                    apply_wind_erosion(positions, width, height, wind_strength);
+                    float start, end;
+                    const float span_x = get_span(tx, width, &start, &end);
+                    const float span_z = get_span(tz, height, &start, &end);
+                    const uint32_t tile = tz * tile_count_x + tx;
+                    area_prefix[tile + 1] = area_prefix[tile] + static_cast<double>(span_x) * span_z;
                 }
-        
-                // hydraulic erosion: simulate a single droplet
+            }
+            const double area_total = area_prefix.back();
+            if (area_total <= 0.0)
+                return;
+
+            auto simulate_droplet = [&](mt19937& gen, uniform_real_distribution<float>& dist_x, uniform_real_distribution<float>& dist_z)
+            {
                 float pos_x = dist_x(gen);
                 float pos_z = dist_z(gen);
                 Vector2 dir = Vector2::Zero;
@@ -651,10 +682,64 @@ namespace spartan
                     // evaporate water
                     water *= (1.0f - evaporation_rate);
                 }
+            };
+
+            // droplets run in batches, with wind erosion in between
+            const uint32_t batch_count = (iterations + wind_interval - 1) / wind_interval;
+            for (uint32_t batch = 0; batch < batch_count; batch++)
+            {
+                const uint64_t droplet_count = min(wind_interval, iterations - batch * wind_interval);
+
+                for (uint32_t color = 0; color < 4; color++)
+                {
+                    vector<uint32_t> tiles;
+                    for (uint32_t tz = color / 2; tz < tile_count_z; tz += 2)
+                    {
+                        for (uint32_t tx = color % 2; tx < tile_count_x; tx += 2)
+                        {
+                            tiles.push_back(tz * tile_count_x + tx);
+                        }
+                    }
+
+                    auto simulate_tiles = [&](uint32_t start_index, uint32_t end_index)
+                    {
+                        for (uint32_t i = start_index; i < end_index; i++)
+                        {
+                            const uint32_t tile = tiles[i];
+
+                            // the prefix sums split the batch's droplets exactly, whatever the rounding
+                            const uint64_t droplet_start = static_cast<uint64_t>(droplet_count * (area_prefix[tile] / area_total));
+                            const uint64_t droplet_end   = static_cast<uint64_t>(droplet_count * (area_prefix[tile + 1] / area_total));
+                            if (droplet_end <= droplet_start)
+                                continue;
+
+                            float x_start, x_end, z_start, z_end;
+                            get_span(tile % tile_count_x, width, &x_start, &x_end);
+                            get_span(tile / tile_count_x, height, &z_start, &z_end);
+                            uniform_real_distribution<float> dist_x(x_start, x_end);
+                            uniform_real_distribution<float> dist_z(z_start, z_end);
+                            seed_seq sequence = { seed, batch, tile };
+                            mt19937 gen(sequence);
+
+                            for (uint64_t droplet = droplet_start; droplet < droplet_end; droplet++)
+                            {
+                                simulate_droplet(gen, dist_x, dist_z);
+                            }
+                        }
+                    };
+
+                    if (parallel)
+                    {
+                        ThreadPool::ParallelLoop(simulate_tiles, static_cast<uint32_t>(tiles.size()));
+                    }
+                    else
+                    {
+                        simulate_tiles(0, static_cast<uint32_t>(tiles.size()));
+                    }
+                }
+
+                apply_wind_erosion(positions, width, height, wind_strength, parallel);
             }
-        
-            // final wind erosion pass
-            apply_wind_erosion(positions, width, height, wind_strength);
         }
 
         void generate_vertices_and_indices(vector<RHI_Vertex_PosTexNorTan>& terrain_vertices, vector<uint32_t>& terrain_indices, const vector<Vector3>& positions, const uint32_t width, const uint32_t height)
@@ -887,6 +972,318 @@ namespace spartan
         }
     }
 
+    // generated terrains are cached under a key derived from every input, so a changed height map or parameter never reuses stale data
+    // the file is a header with a table of sections, each section is 16 byte aligned and checksummed, tiles are decoded straight from the mapped file
+    namespace cache
+    {
+        const uint32_t magic   = 0x52545053; // "SPTR"
+        const uint32_t version = 1;          // bump when the format or the generator changes in a way that the key can't see
+        const uint64_t align   = 16;
+
+        enum Section : uint32_t
+        {
+            Section_Meta,
+            Section_Heights,
+            Section_Triangles,
+            Section_TileOffsets,
+            Section_TileTable,
+            Section_TileData,
+            Section_Count
+        };
+
+        enum Flags : uint32_t
+        {
+            Flag_Compressed = 1 << 0,
+        };
+
+        struct SectionEntry
+        {
+            uint64_t offset   = 0;
+            uint64_t size     = 0;
+            uint64_t checksum = 0;
+        };
+
+        struct Header
+        {
+            uint32_t magic         = 0;
+            uint32_t version       = 0;
+            uint64_t key           = 0;
+            uint32_t flags         = 0;
+            uint32_t section_count = 0;
+            SectionEntry sections[Section_Count];
+        };
+
+        struct Meta
+        {
+            uint32_t width         = 0; // height map
+            uint32_t height        = 0;
+            uint32_t dense_width   = 0; // height field
+            uint32_t dense_height  = 0;
+            uint32_t vertex_count  = 0; // whole terrain
+            uint32_t index_count   = 0;
+            float area_km2         = 0.0f;
+            float spacing          = 0.0f;
+            float origin_x         = 0.0f;
+            float origin_z         = 0.0f;
+        };
+
+        struct TileEntry
+        {
+            uint64_t vertex_offset = 0; // within the tile data section
+            uint64_t vertex_size   = 0;
+            uint64_t index_offset  = 0;
+            uint64_t index_size    = 0;
+            uint32_t vertex_count  = 0;
+            uint32_t index_count   = 0;
+        };
+
+        uint64_t compute_key(RHI_Texture* height_texture, const float min_y, const float max_y)
+        {
+            const vector<byte>& bytes = height_texture->GetMip(0, 0).bytes;
+            uint64_t key              = FileSystem::HashBytes(bytes.data(), bytes.size());
+
+            const float settings[] =
+            {
+                static_cast<float>(height_texture->GetWidth()), static_cast<float>(height_texture->GetHeight()),
+                static_cast<float>(height_texture->GetChannelCount()), static_cast<float>(height_texture->GetBitsPerChannel()),
+                min_y, max_y,
+                static_cast<float>(parameters::smoothing_iterations), static_cast<float>(parameters::density), static_cast<float>(parameters::scale),
+                static_cast<float>(parameters::create_border), static_cast<float>(parameters::erosion_seed), static_cast<float>(parameters::tile_count),
+                static_cast<float>(parameters::cache_compression), static_cast<float>(version)
+            };
+
+            return FileSystem::HashBytes(settings, sizeof(settings), key);
+        }
+
+        string get_file_path(const uint64_t key)
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+            return ResourceCache::GetCacheDirectory() + "terrain/" + name + ".terrain";
+        }
+
+        void write(
+            const string& file_path,
+            const uint64_t key,
+            const Meta& meta,
+            const vector<float>& heights,
+            const vector<TriangleData>& triangles,
+            const vector<Vector3>& tile_offsets,
+            const vector<vector<RHI_Vertex_PosTexNorTan>>& tile_vertices,
+            const vector<vector<uint32_t>>& tile_indices
+        )
+        {
+            // encode the tiles first, the layout depends on their size
+            const uint32_t tile_count = static_cast<uint32_t>(tile_vertices.size());
+            vector<vector<uint8_t>> tile_blobs(tile_count * 2);
+            auto encode_tiles = [&](uint32_t start_index, uint32_t end_index)
+            {
+                for (uint32_t i = start_index; i < end_index; i++)
+                {
+                    const vector<RHI_Vertex_PosTexNorTan>& vertices = tile_vertices[i];
+                    const vector<uint32_t>& indices                 = tile_indices[i];
+                    vector<uint8_t>& vertex_blob                    = tile_blobs[i * 2];
+                    vector<uint8_t>& index_blob                     = tile_blobs[i * 2 + 1];
+
+                    if (parameters::cache_compression)
+                    {
+                        vertex_blob.resize(meshopt_encodeVertexBufferBound(vertices.size(), sizeof(RHI_Vertex_PosTexNorTan)));
+                        vertex_blob.resize(meshopt_encodeVertexBuffer(vertex_blob.data(), vertex_blob.size(), vertices.data(), vertices.size(), sizeof(RHI_Vertex_PosTexNorTan)));
+                        index_blob.resize(meshopt_encodeIndexBufferBound(indices.size(), vertices.size()));
+                        index_blob.resize(meshopt_encodeIndexBuffer(index_blob.data(), index_blob.size(), indices.data(), indices.size()));
+                    }
+                    else
+                    {
+                        vertex_blob.assign(reinterpret_cast<const uint8_t*>(vertices.data()), reinterpret_cast<const uint8_t*>(vertices.data() + vertices.size()));
+                        index_blob.assign(reinterpret_cast<const uint8_t*>(indices.data()), reinterpret_cast<const uint8_t*>(indices.data() + indices.size()));
+                    }
+                }
+            };
+            ThreadPool::ParallelLoop(encode_tiles, tile_count);
+
+            vector<TileEntry> tile_table(tile_count);
+            uint64_t tile_data_size = 0;
+            for (uint32_t i = 0; i < tile_count; i++)
+            {
+                TileEntry& entry    = tile_table[i];
+                entry.vertex_count  = static_cast<uint32_t>(tile_vertices[i].size());
+                entry.index_count   = static_cast<uint32_t>(tile_indices[i].size());
+                entry.vertex_offset = tile_data_size;
+                entry.vertex_size   = tile_blobs[i * 2].size();
+                tile_data_size     += entry.vertex_size;
+                entry.index_offset  = tile_data_size;
+                entry.index_size    = tile_blobs[i * 2 + 1].size();
+                tile_data_size     += entry.index_size;
+            }
+
+            // layout
+            struct Source { const void* data; uint64_t size; };
+            const Source sources[Section_Count] =
+            {
+                { &meta,               sizeof(Meta) },
+                { heights.data(),      heights.size() * sizeof(float) },
+                { triangles.data(),    triangles.size() * sizeof(TriangleData) },
+                { tile_offsets.data(), tile_offsets.size() * sizeof(Vector3) },
+                { tile_table.data(),   tile_table.size() * sizeof(TileEntry) },
+                { nullptr,             tile_data_size }
+            };
+
+            Header header;
+            header.magic         = magic;
+            header.version       = version;
+            header.key           = key;
+            header.flags         = parameters::cache_compression ? static_cast<uint32_t>(Flag_Compressed) : 0;
+            header.section_count = Section_Count;
+            uint64_t offset      = (sizeof(Header) + align - 1) & ~(align - 1);
+            for (uint32_t i = 0; i < Section_Count; i++)
+            {
+                header.sections[i].offset = offset;
+                header.sections[i].size   = sources[i].size;
+                offset                    = (offset + sources[i].size + align - 1) & ~(align - 1);
+
+                if (i != Section_TileData)
+                {
+                    header.sections[i].checksum = FileSystem::HashBytes(sources[i].data, sources[i].size);
+                }
+                else
+                {
+                    uint64_t checksum = 0;
+                    for (const vector<uint8_t>& blob : tile_blobs)
+                    {
+                        checksum = FileSystem::HashBytes(blob.data(), blob.size(), checksum);
+                    }
+                    header.sections[i].checksum = checksum;
+                }
+            }
+
+            // write, through a temporary file so that readers, which map the cache, never see a torn or truncated one
+            FileSystem::CreateDirectory_(FileSystem::GetDirectoryFromFilePath(file_path));
+            const string file_path_temp = file_path + ".tmp";
+            bool is_written             = false;
+            uint64_t file_size          = 0;
+            {
+                FileStream file(file_path_temp, FileStream_Write);
+                if (file.IsOpen())
+                {
+                    auto pad_to = [&file](uint64_t position)
+                    {
+                        if (file.GetPosition() < position)
+                        {
+                            file.Skip(position - file.GetPosition());
+                        }
+                    };
+
+                    file.WriteBytes(&header, sizeof(Header));
+                    for (uint32_t i = 0; i < Section_Count; i++)
+                    {
+                        pad_to(header.sections[i].offset);
+                        if (i != Section_TileData)
+                        {
+                            file.WriteBytes(sources[i].data, sources[i].size);
+                        }
+                        else
+                        {
+                            for (const vector<uint8_t>& blob : tile_blobs)
+                            {
+                                file.WriteBytes(blob.data(), blob.size());
+                            }
+                        }
+                    }
+
+                    file_size = file.GetPosition();
+                    file.Close();
+                    is_written = true;
+                }
+            }
+
+            if (!is_written || !FileSystem::Rename(file_path_temp, file_path))
+            {
+                FileSystem::Delete(file_path_temp);
+                return;
+            }
+
+            SP_LOG_INFO("saved terrain cache %s: %.1f MB, %u tiles%s", file_path.c_str(), static_cast<double>(file_size) / (1024.0 * 1024.0), tile_count, parameters::cache_compression ? ", compressed" : "");
+        }
+
+        // validates the whole file up front, the sections are then zero-copy views into the mapping
+        class Reader
+        {
+        public:
+            Reader(const string& file_path, const uint64_t key) : m_file(file_path, FileStream_Read)
+            {
+                if (!m_file.IsOpen() || m_file.GetSize() < sizeof(Header))
+                    return;
+
+                m_data = m_file.ViewBytes(m_file.GetSize());
+                memcpy(&m_header, m_data.data(), sizeof(Header));
+                if (m_header.magic != magic || m_header.version != version || m_header.key != key || m_header.section_count != Section_Count)
+                {
+                    SP_LOG_WARNING("terrain cache %s is outdated, the terrain will be generated again", file_path.c_str());
+                    return;
+                }
+
+                for (const SectionEntry& section : m_header.sections)
+                {
+                    if (section.offset % align != 0 || section.offset + section.size > m_data.size() ||
+                        FileSystem::HashBytes(m_data.data() + section.offset, section.size) != section.checksum)
+                    {
+                        SP_LOG_WARNING("terrain cache %s is corrupt, the terrain will be generated again", file_path.c_str());
+                        return;
+                    }
+                }
+
+                // the section sizes have to agree with each other
+                const Meta& meta = GetMeta();
+                m_is_valid       = m_header.sections[Section_Meta].size == sizeof(Meta) &&
+                                   GetSection<float>(Section_Heights).size() == static_cast<size_t>(meta.dense_width) * meta.dense_height &&
+                                   GetSection<Vector3>(Section_TileOffsets).size() == GetSection<TileEntry>(Section_TileTable).size();
+                for (const TileEntry& entry : GetSection<TileEntry>(Section_TileTable))
+                {
+                    m_is_valid = m_is_valid &&
+                                 entry.vertex_offset + entry.vertex_size <= m_header.sections[Section_TileData].size &&
+                                 entry.index_offset + entry.index_size <= m_header.sections[Section_TileData].size;
+                }
+            }
+
+            bool IsValid() const { return m_is_valid; }
+            const Meta& GetMeta() const { return *reinterpret_cast<const Meta*>(m_data.data() + m_header.sections[Section_Meta].offset); }
+
+            template<typename T>
+            span<const T> GetSection(const Section section) const
+            {
+                const SectionEntry& entry = m_header.sections[section];
+                return span<const T>(reinterpret_cast<const T*>(m_data.data() + entry.offset), entry.size / sizeof(T));
+            }
+
+            bool ReadTile(const uint32_t index, vector<RHI_Vertex_PosTexNorTan>& vertices, vector<uint32_t>& indices) const
+            {
+                const TileEntry& entry = GetSection<TileEntry>(Section_TileTable)[index];
+                const uint8_t* data    = reinterpret_cast<const uint8_t*>(m_data.data() + m_header.sections[Section_TileData].offset);
+                vertices.resize(entry.vertex_count);
+                indices.resize(entry.index_count);
+
+                if (m_header.flags & Flag_Compressed)
+                {
+                    return meshopt_decodeVertexBuffer(vertices.data(), vertices.size(), sizeof(RHI_Vertex_PosTexNorTan), data + entry.vertex_offset, entry.vertex_size) == 0 &&
+                           meshopt_decodeIndexBuffer(indices.data(), indices.size(), sizeof(uint32_t), data + entry.index_offset, entry.index_size) == 0;
+                }
+
+                if (entry.vertex_size != vertices.size() * sizeof(RHI_Vertex_PosTexNorTan) || entry.index_size != indices.size() * sizeof(uint32_t))
+                    return false;
+
+                memcpy(vertices.data(), data + entry.vertex_offset, entry.vertex_size);
+                memcpy(indices.data(), data + entry.index_offset, entry.index_size);
+                return true;
+            }
+
+        private:
+            FileStream m_file;
+            span<const byte> m_data;
+            Header m_header;
+            bool m_is_valid = false;
+        };
+    }
+
     Terrain::Terrain(Entity* entity) : Component(entity)
     {
         m_material = make_shared<Material>();
@@ -898,6 +1295,11 @@ namespace spartan
         m_height_texture = nullptr;
     }
 
+    void Terrain::Erode(vector<Vector3>& positions, const uint32_t width, const uint32_t height, const uint32_t iterations, const uint32_t wind_interval, const bool parallel)
+    {
+        apply_erosion(positions, width, height, parameters::erosion_seed, iterations, wind_interval, parallel);
+    }
+
     void Terrain::GenerateTransforms(vector<Matrix>* transforms, const uint32_t count, const TerrainProp terrain_prop, float offset_y)
     {
         bool rotate_match_surface_normal = false;                        // don't rotate to match the surface normal
@@ -946,117 +1348,6 @@ namespace spartan
         *transforms = find_transforms(count, max_slope, rotate_match_surface_normal, terrain_offset, height_min, height_max, scale_min, scale_max, scale_by_slope, height_variation);
     }
 
-    void Terrain::SaveToFile(const char* file_path)
-    {
-        ofstream file(file_path, ios::binary);
-        if (!file.is_open())
-        {
-            SP_LOG_ERROR("failed to open file for writing: %s", file_path);
-            return;
-        }
-    
-        uint32_t width            = GetWidth();
-        uint32_t height           = GetHeight();
-        uint32_t height_data_size = static_cast<uint32_t>(m_height_data.size());
-        uint32_t vertex_count     = static_cast<uint32_t>(m_vertices.size());
-        uint32_t index_count      = static_cast<uint32_t>(m_indices.size());
-        uint32_t tile_count       = static_cast<uint32_t>(m_tile_vertices.size());
-        uint32_t placement_count  = static_cast<uint32_t>(triangle_data.size());
-        uint32_t offset_count     = static_cast<uint32_t>(m_tile_offsets.size());
-    
-        file.write(reinterpret_cast<const char*>(&width), sizeof(uint32_t));
-        file.write(reinterpret_cast<const char*>(&height), sizeof(uint32_t));
-        file.write(reinterpret_cast<const char*>(&height_data_size), sizeof(uint32_t));
-        file.write(reinterpret_cast<const char*>(&vertex_count), sizeof(uint32_t));
-        file.write(reinterpret_cast<const char*>(&index_count), sizeof(uint32_t));
-        file.write(reinterpret_cast<const char*>(&tile_count), sizeof(uint32_t));
-        file.write(reinterpret_cast<const char*>(&placement_count), sizeof(uint32_t));
-        file.write(reinterpret_cast<const char*>(&offset_count), sizeof(uint32_t));
-
-        file.write(reinterpret_cast<const char*>(m_height_data.data()), height_data_size * sizeof(float));
-        file.write(reinterpret_cast<const char*>(m_vertices.data()), vertex_count * sizeof(RHI_Vertex_PosTexNorTan));
-        file.write(reinterpret_cast<const char*>(m_indices.data()), index_count * sizeof(uint32_t));
-        file.write(reinterpret_cast<const char*>(triangle_data.data()), placement_count * sizeof(TriangleData));
-        file.write(reinterpret_cast<const char*>(m_tile_offsets.data()), offset_count * sizeof(Vector3));
-    
-        for (uint32_t i = 0; i < tile_count; i++)
-        {
-            uint32_t vertex_size = static_cast<uint32_t>(m_tile_vertices[i].size());
-            uint32_t index_size = static_cast<uint32_t>(m_tile_indices[i].size());
-            file.write(reinterpret_cast<const char*>(&vertex_size), sizeof(uint32_t));
-            file.write(reinterpret_cast<const char*>(&index_size), sizeof(uint32_t));
-            file.write(reinterpret_cast<const char*>(m_tile_vertices[i].data()), vertex_size * sizeof(RHI_Vertex_PosTexNorTan));
-            file.write(reinterpret_cast<const char*>(m_tile_indices[i].data()), index_size * sizeof(uint32_t));
-        }
-    
-        file.close();
-    
-        SP_LOG_INFO("saved terrain to %s: width=%u, height=%u, height_data_size=%u, vertex_count=%u, index_count=%u, tile_count=%u, offset_count=%u",
-                    file_path, width, height, height_data_size, vertex_count, index_count, tile_count, offset_count);
-    }
-    
-    void Terrain::LoadFromFile(const char* file_path)
-    {
-        ifstream file(file_path, ios::binary);
-        if (!file.is_open())
-            return;
-    
-        uint32_t height_data_size = 0;
-        uint32_t vertex_count     = 0;
-        uint32_t index_count      = 0;
-        uint32_t tile_count       = 0;
-        uint32_t placement_count  = 0;
-        uint32_t offset_count     = 0;
-    
-        file.read(reinterpret_cast<char*>(&m_width), sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(&m_height), sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(&height_data_size), sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(&vertex_count), sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(&index_count), sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(&tile_count), sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(&placement_count), sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(&offset_count), sizeof(uint32_t));
-
-        if (tile_count > 10000 || offset_count > 10000)
-        {
-            SP_LOG_ERROR("invalid tile_count (%u) or offset_count (%u) read from file, aborting load", tile_count, offset_count);
-            file.close();
-            return;
-        }
-    
-        m_height_data.resize(height_data_size);
-        m_vertices.resize(vertex_count);
-        m_indices.resize(index_count);
-        m_tile_vertices.resize(tile_count);
-        m_tile_indices.resize(tile_count);
-        m_tile_offsets.resize(offset_count);
-        triangle_data.resize(placement_count);
-    
-        file.read(reinterpret_cast<char*>(m_height_data.data()), height_data_size * sizeof(float));
-        file.read(reinterpret_cast<char*>(m_vertices.data()), vertex_count * sizeof(RHI_Vertex_PosTexNorTan));
-        file.read(reinterpret_cast<char*>(m_indices.data()), index_count * sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(triangle_data.data()), placement_count * sizeof(TriangleData));
-        file.read(reinterpret_cast<char*>(m_tile_offsets.data()), offset_count * sizeof(Vector3));
-    
-        for (uint32_t i = 0; i < tile_count; i++)
-        {
-            uint32_t vertex_size, index_size;
-            file.read(reinterpret_cast<char*>(&vertex_size), sizeof(uint32_t));
-            file.read(reinterpret_cast<char*>(&index_size), sizeof(uint32_t));
-    
-            m_tile_vertices[i].resize(vertex_size);
-            m_tile_indices[i].resize(index_size);
-    
-            file.read(reinterpret_cast<char*>(m_tile_vertices[i].data()), vertex_size * sizeof(RHI_Vertex_PosTexNorTan));
-            file.read(reinterpret_cast<char*>(m_tile_indices[i].data()), index_size * sizeof(uint32_t));
-        }
-    
-        file.close();
-    
-        SP_LOG_INFO("loaded terrain from %s: width=%u, height=%u, height_data_size=%u, vertex_count=%u, index_count=%u, tile_count=%u, offset_count=%u",
-                    file_path, m_width, m_height, height_data_size, vertex_count, index_count, tile_count, offset_count);
-    }
-
     uint32_t Terrain::GetDensity() const
     {
         return parameters::density;
@@ -1089,37 +1380,81 @@ namespace spartan
         uint32_t job_count = 9;
         ProgressTracker::GetProgress(ProgressType::Terrain).Start(job_count, "generating terrain...");
     
-        // define cache file path
-        const string cache_file = "terrain_cache.bin";
-        bool loaded_from_cache  = false;
-    
-        // try to load from cache
+        // the cache is keyed by the height map and every generation parameter
+        m_width                          = m_height_texture->GetWidth();
+        m_height                         = m_height_texture->GetHeight();
+        const uint64_t cache_key         = cache::compute_key(m_height_texture, m_min_y, m_max_y);
+        const string cache_file          = cache::get_file_path(cache_key);
+        unique_ptr<cache::Reader> reader = FileSystem::Exists(cache_file) ? make_unique<cache::Reader>(cache_file, cache_key) : nullptr;
+        bool loaded_from_cache           = reader && reader->IsValid();
+
+        // try to load from cache, the tiles are decoded in parallel, straight from the mapped file
+        uint32_t dense_width  = 0;
+        uint32_t dense_height = 0;
+        if (loaded_from_cache)
         {
-            LoadFromFile(cache_file.c_str());
-            if (!m_vertices.empty())
+            const uint32_t tile_count = static_cast<uint32_t>(reader->GetSection<Vector3>(cache::Section_TileOffsets).size());
+            m_tile_vertices.resize(tile_count);
+            m_tile_indices.resize(tile_count);
+
+            atomic<bool> tiles_valid = true;
+            auto decode_tiles = [this, &reader, &tiles_valid](uint32_t start, uint32_t end)
             {
-                loaded_from_cache = true;
-                ProgressTracker::GetProgress(ProgressType::Terrain).SetText("loaded from cache, skipping to mesh creation...");
-                for (uint32_t i = 0; i < job_count - 1; i++)
+                for (uint32_t tile_index = start; tile_index < end; tile_index++)
                 {
-                    ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
+                    if (!reader->ReadTile(tile_index, m_tile_vertices[tile_index], m_tile_indices[tile_index]))
+                    {
+                        SP_LOG_ERROR("failed to decode tile %u from the terrain cache", tile_index);
+                        tiles_valid = false;
+                    }
                 }
+            };
+            ThreadPool::ParallelLoop(decode_tiles, tile_count);
+
+            // a tile that doesn't decode would leave a hole in the terrain, so drop the whole entry and regenerate
+            if (!tiles_valid)
+            {
+                m_tile_vertices.clear();
+                m_tile_indices.clear();
+                reader            = nullptr; // unmap before deleting
+                loaded_from_cache = false;
+                FileSystem::Delete(cache_file);
             }
         }
 
-        vector<Vector3> positions;
-        uint32_t dense_width  = 0;
-        uint32_t dense_height = 0;
-        if (!loaded_from_cache)
+        if (loaded_from_cache)
+        {
+            const cache::Meta& meta = reader->GetMeta();
+            dense_width             = meta.dense_width;
+            dense_height            = meta.dense_height;
+            m_vertex_count          = meta.vertex_count;
+            m_index_count           = meta.index_count;
+            m_area_km2              = meta.area_km2;
+            m_height_field_spacing  = meta.spacing;
+            m_height_field_origin   = Vector3(meta.origin_x, 0.0f, meta.origin_z);
+
+            span<const float> heights = reader->GetSection<float>(cache::Section_Heights);
+            m_height_data.assign(heights.begin(), heights.end());
+            span<const TriangleData> triangles = reader->GetSection<TriangleData>(cache::Section_Triangles);
+            triangle_data.assign(triangles.begin(), triangles.end());
+            span<const Vector3> tile_offsets = reader->GetSection<Vector3>(cache::Section_TileOffsets);
+            m_tile_offsets.assign(tile_offsets.begin(), tile_offsets.end());
+
+            ProgressTracker::GetProgress(ProgressType::Terrain).SetText("loaded from cache, skipping to mesh creation...");
+            for (uint32_t i = 0; i < job_count - 1; i++)
+            {
+                ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
+            }
+        }
+        else
         {
             SP_LOG_INFO("Terrain not found, generating from scratch...");
+            vector<Vector3> positions;
     
             // 1. process height map
             {
                 ProgressTracker::GetProgress(ProgressType::Terrain).SetText("process height map...");
                 get_values_from_height_map(m_height_data, m_height_texture, m_min_y, m_max_y);
-                m_width  = m_height_texture->GetWidth();
-                m_height = m_height_texture->GetHeight();
     
                 // increase grid density
                 densify_height_map(m_height_data, m_width, m_height, parameters::density);
@@ -1146,7 +1481,7 @@ namespace spartan
             // 4. apply hydraulic and wind erosion
             {
                 ProgressTracker::GetProgress(ProgressType::Terrain).SetText("applying hydraulic and wind erosion...");
-                apply_erosion(positions, dense_width, dense_height);
+                apply_erosion(positions, dense_width, dense_height, parameters::erosion_seed);
                 ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
             }
     
@@ -1176,20 +1511,46 @@ namespace spartan
             // 8. split into tiles
             {
                 ProgressTracker::GetProgress(ProgressType::Terrain).SetText("splitting into tiles...");
-                uint32_t tile_count = 16;
-                spartan::geometry_processing::split_surface_into_tiles(m_vertices, m_indices, tile_count, m_tile_vertices, m_tile_indices, m_tile_offsets);
+                spartan::geometry_processing::split_surface_into_tiles(m_vertices, m_indices, parameters::tile_count, m_tile_vertices, m_tile_indices, m_tile_offsets);
                 ProgressTracker::GetProgress(ProgressType::Terrain).JobDone();
             }
 
-            SaveToFile(cache_file.c_str());
+            // keep the final heights, the vertices are still the dense grid at this point
+            m_height_data.resize(m_vertices.size());
+            for (size_t i = 0; i < m_vertices.size(); i++)
+            {
+                m_height_data[i] = m_vertices[i].pos[1];
+            }
+            m_height_field_spacing = m_vertices[1].pos[0] - m_vertices[0].pos[0];
+            m_height_field_origin  = Vector3(m_vertices[0].pos[0], 0.0f, m_vertices[0].pos[2]);
+
+            m_vertex_count = static_cast<uint32_t>(m_vertices.size());
+            m_index_count  = static_cast<uint32_t>(m_indices.size());
+            m_area_km2     = compute_surface_area_km2(m_vertices, m_indices);
+
+            // save to cache
+            {
+                cache::Meta meta;
+                meta.width        = m_width;
+                meta.height       = m_height;
+                meta.dense_width  = dense_width;
+                meta.dense_height = dense_height;
+                meta.vertex_count = m_vertex_count;
+                meta.index_count  = m_index_count;
+                meta.area_km2     = m_area_km2;
+                meta.spacing      = m_height_field_spacing;
+                meta.origin_x     = m_height_field_origin.x;
+                meta.origin_z     = m_height_field_origin.z;
+
+                cache::write(cache_file, cache_key, meta, m_height_data, triangle_data, m_tile_offsets, m_tile_vertices, m_tile_indices);
+            }
         }
-    
+
         // compute certain properties
-        m_height_samples = dense_width * dense_height;
-        m_vertex_count   = static_cast<uint32_t>(m_vertices.size());
-        m_index_count    = static_cast<uint32_t>(m_indices.size());
-        m_triangle_count = m_index_count / 3;
-        m_area_km2       = compute_surface_area_km2(m_vertices, m_indices);
+        m_height_field_width  = dense_width;
+        m_height_field_length = dense_height;
+        m_height_samples      = dense_width * dense_height;
+        m_triangle_count      = m_index_count / 3;
 
         // 9. create a mesh for each tile
         {
@@ -1200,7 +1561,7 @@ namespace spartan
             m_mesh->SetFlag(static_cast<uint32_t>(MeshFlags::PostProcessPreserveTerrainEdges), true); // so that nearby tiles with low lods don't have visible seams
             m_mesh->SetLodDropoff(MeshLodDropoff::Linear);
     
-            for (uint32_t tile_index = 0; tile_index < static_cast<uint32_t>(m_tile_vertices.size()); tile_index++)
+            for (uint32_t tile_index = 0; tile_index < static_cast<uint32_t>(m_tile_offsets.size()); tile_index++)
             {
                 uint32_t sub_mesh_index = 0;
                 m_mesh->AddGeometry(m_tile_vertices[tile_index], m_tile_indices[tile_index], true, &sub_mesh_index);
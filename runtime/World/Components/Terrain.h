@@ -25,16 +25,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Component.h"
 #include <atomic>
 #include "../../RHI/RHI_Definitions.h"
+#include "../../Math/Vector3.h"
 //====================================
 
 namespace spartan
 {
     class Mesh;
     class Material;
-    namespace math
-    {
-        class Vector3;
-    }
 
     enum class TerrainProp
     {
@@ -68,16 +65,20 @@ namespace spartan
 
         // generate
         void Generate();
+        // erodes a grid of positions the way generation does, parallel off runs everything on the calling thread and gives the same result
+        static void Erode(std::vector<math::Vector3>& positions, const uint32_t width, const uint32_t height, const uint32_t iterations, const uint32_t wind_interval, const bool parallel);
         void GenerateTransforms(std::vector<math::Matrix>* transforms, const uint32_t count, const TerrainProp terrain_prop, float offset_y = 0.0f);
 
-        // io
-        void SaveToFile(const char* file_path);
-        void LoadFromFile(const char* file_path);
-
         uint32_t GetVertexCount() const         { return m_vertex_count; }
         uint32_t GetIndexCount() const          { return m_index_count; }
         uint64_t GetHeightSampleCount() const   { return m_height_samples; }
         float* GetHeightData()                  { return !m_height_data.empty() ? &m_height_data[0] : nullptr; }
+
+        // the final surface (after noise and erosion) as a grid of height samples, row-major along z, physics builds height fields from it
+        uint32_t GetHeightFieldWidth() const               { return m_height_field_width; }  // samples along x
+        uint32_t GetHeightFieldLength() const              { return m_height_field_length; } // samples along z
+        float GetHeightFieldSpacing() const                { return m_height_field_spacing; }
+        const math::Vector3& GetHeightFieldOrigin() const  { return m_height_field_origin; } // local position of the first sample
         std::shared_ptr<Material> GetMaterial() { return m_material; }
  
     private:
@@ -96,6 +97,10 @@ namespace spartan
         uint32_t m_vertex_count           = 0;
         uint32_t m_index_count            = 0;
         uint32_t m_triangle_count         = 0;
+        uint32_t m_height_field_width     = 0;
+        uint32_t m_height_field_length    = 0;
+        float m_height_field_spacing      = 0.0f;
+        math::Vector3 m_height_field_origin;
         RHI_Texture* m_height_texture     = nullptr;
         std::vector<float> m_height_data;
         std::vector<std::vector<RHI_Vertex_PosTexNorTan>> m_tile_vertices;
@@ -41,6 +41,16 @@ namespace spartan
 {
     namespace
     {
+        atomic<bool> transforms_changed = false;
+
+        // jobs can resolve the same dirty entity at once (culling, ray casts), a small set of shared locks serializes them
+        array<mutex, 64> transform_mutexes;
+
+        mutex& get_transform_mutex(const Entity* entity)
+        {
+            return transform_mutexes[(reinterpret_cast<uintptr_t>(entity) / alignof(Entity)) % transform_mutexes.size()];
+        }
+
         // input is an entity, output is a clone of that entity (descendant entities are not cloned)
         shared_ptr<Entity> clone_entity(Entity* entity)
         {
@@ -100,7 +110,7 @@ namespace spartan
 
     void Entity::Initialize()
     {
-        UpdateTransform();
+        MarkTransformDirty();
     }
 
     shared_ptr<Entity> Entity::Clone()
@@ -224,6 +234,23 @@ namespace spartan
         }
     }
 
+    void Entity::SetActive(const bool active)
+    {
+        if (m_is_active == active)
+            return;
+
+        m_is_active = active;
+
+        // descendants inherit the state, so their presence in the spatial index changes too
+        vector<Entity*> descendants;
+        GetDescendants(&descendants);
+        MarkBoundsDirty();
+        for (Entity* descendant : descendants)
+        {
+            descendant->MarkBoundsDirty();
+        }
+    }
+
     bool Entity::GetActive() const
     {
         if (shared_ptr<Entity> parent = GetParent())
@@ -272,42 +299,62 @@ namespace spartan
         World::Resolve();
     }
 
-    void Entity::UpdateTransform()
+    void Entity::MarkTransformDirty()
     {
-        // compute local transform
-        m_matrix_local = Matrix(m_position_local, m_rotation_local, m_scale_local);
+        m_time_since_last_transform_sec = 0.0f;
+        MarkBoundsDirty();
 
-        // compute world transform
-        if (!m_parent.expired())
-        {
-            m_matrix = m_matrix_local * m_parent.lock()->GetMatrix();
-        }
-        else
-        {
-            m_matrix = m_matrix_local;
-        }
+        // descendants of a dirty entity are already dirty
+        if (m_transform_dirty)
+            return;
 
-        // mark update
-        m_time_since_last_transform_sec = 0.0f;
+        m_transform_dirty  = true;
+        transforms_changed = true;
 
-        // update children
         for (Entity* child : m_children)
         {
-            child->UpdateTransform();
+            child->MarkTransformDirty();
         }
+    }
+
+    void Entity::ComputeTransform() const
+    {
+        // getting the parent's matrix resolves it first if it's dirty too, this happens before locking
+        // since a parent and its child can share a lock
+        shared_ptr<Entity> parent  = m_parent.lock();
+        const Matrix matrix_parent = parent ? parent->GetMatrix() : Matrix::Identity;
+
+        lock_guard<mutex> lock(get_transform_mutex(this));
+        if (!m_transform_dirty)
+            return; // another thread resolved it while this one was waiting
+
+        // compute local transform
+        m_matrix_local = Matrix(m_position_local, m_rotation_local, m_scale_local);
+
+        // compute world transform
+        m_matrix = parent ? m_matrix_local * matrix_parent : m_matrix_local;
 
         // update directions
         {
+            const Quaternion rotation = m_matrix.GetRotation();
+
             // z
-            m_forward  = GetRotation() * Vector3::Forward;
+            m_forward  = rotation * Vector3::Forward;
             m_backward = -m_forward;
             // y
-            m_up       = GetRotation() * Vector3::Up;
+            m_up       = rotation * Vector3::Up;
             m_down     = -m_up;
             // x
-            m_right    = GetRotation() * Vector3::Right;
+            m_right    = rotation * Vector3::Right;
             m_left     = -m_right;
         }
+
+        m_transform_dirty = false;
+    }
+
+    bool Entity::ConsumeTransformChanges()
+    {
+        return transforms_changed.exchange(false);
     }
 
     void Entity::SetPosition(const Vector3& position)
@@ -324,7 +371,7 @@ namespace spartan
             return;
 
         m_position_local = position;
-        UpdateTransform();
+        MarkTransformDirty();
     }
 
     void Entity::SetRotation(const Quaternion& rotation)
@@ -341,7 +388,7 @@ namespace spartan
             return;
 
         m_rotation_local = rotation;
-        UpdateTransform();
+        MarkTransformDirty();
     }
 
     void Entity::SetScale(const Vector3& scale)
@@ -364,7 +411,7 @@ namespace spartan
         m_scale_local.y = (m_scale_local.y == 0.0f) ? numeric_limits<float>::min() : m_scale_local.y;
         m_scale_local.z = (m_scale_local.z == 0.0f) ? numeric_limits<float>::min() : m_scale_local.z;
 
-        UpdateTransform();
+        MarkTransformDirty();
     }
 
     void Entity::Translate(const Vector3& delta)
@@ -433,7 +480,7 @@ namespace spartan
                 for (Entity* child : m_children)
                 {
                     child->m_parent = m_parent; // directly setting parent
-                    child->UpdateTransform();   // update transform if needed
+                    child->MarkTransformDirty();   // update transform if needed
                 }
         
                 m_children.clear();
@@ -454,7 +501,10 @@ namespace spartan
         }
 
         m_parent = new_parent_in;
-        UpdateTransform();
+        MarkTransformDirty();
+
+        // the hierarchy changed, the world has to regroup entities by depth
+        World::Resolve();
     }
 
     void Entity::AddChild(Entity* child)
@@ -60,7 +60,14 @@ namespace spartan
 
         // active
         bool GetActive() const;
-        void SetActive(const bool active) { m_is_active = active; }
+        void SetActive(const bool active);
+
+        // set when anything the world's spatial index depends on changed (transform, bounds, activity), the world only refits those
+        void MarkBoundsDirty()    { m_bounds_dirty = true; m_bounds_revision++; }
+        bool ConsumeBoundsDirty() { return m_bounds_dirty.exchange(false); }
+
+        // increases with every such change, for components that keep their own copy of the bounds and can't consume the flag
+        uint32_t GetBoundsRevision() const { return m_bounds_revision; }
 
         // adds a component of type T
         template <class T>
@@ -112,21 +119,21 @@ namespace spartan
         const auto& GetAllComponents() const { return m_components; }
 
         //= POSITION ======================================================================
-        math::Vector3 GetPosition()             const { return m_matrix.GetTranslation(); }
+        math::Vector3 GetPosition()             const { return GetMatrix().GetTranslation(); }
         const math::Vector3& GetPositionLocal() const { return m_position_local; }
         void SetPosition(const math::Vector3& position);
         void SetPositionLocal(const math::Vector3& position);
         //=================================================================================
 
         //= ROTATION ======================================================================
-        math::Quaternion GetRotation()             const { return m_matrix.GetRotation(); }
+        math::Quaternion GetRotation()             const { return GetMatrix().GetRotation(); }
         const math::Quaternion& GetRotationLocal() const { return m_rotation_local; }
         void SetRotation(const math::Quaternion& rotation);
         void SetRotationLocal(const math::Quaternion& rotation);
         //=================================================================================
 
         //= SCALE ================================================================
-        math::Vector3 GetScale()             const { return m_matrix.GetScale(); }
+        math::Vector3 GetScale()             const { return GetMatrix().GetScale(); }
         const math::Vector3& GetScaleLocal() const { return m_scale_local; }
         void SetScale(const math::Vector3& scale);
         void SetScaleLocal(const math::Vector3& scale);
@@ -138,12 +145,12 @@ namespace spartan
         //=========================================
 
         //= DIRECTIONS ================================================
-        const math::Vector3& GetUp() const       { return m_up; }
-        const math::Vector3& GetDown() const     { return m_down; }
-        const math::Vector3& GetForward() const  { return m_forward; }
-        const math::Vector3& GetBackward() const { return m_backward; }
-        const math::Vector3& GetRight() const    { return m_right; }
-        const math::Vector3& GetLeft() const     { return m_left; }
+        const math::Vector3& GetUp() const       { ResolveTransform(); return m_up; }
+        const math::Vector3& GetDown() const     { ResolveTransform(); return m_down; }
+        const math::Vector3& GetForward() const  { ResolveTransform(); return m_forward; }
+        const math::Vector3& GetBackward() const { ResolveTransform(); return m_backward; }
+        const math::Vector3& GetRight() const    { ResolveTransform(); return m_right; }
+        const math::Vector3& GetLeft() const     { ResolveTransform(); return m_left; }
         //=============================================================
 
         //= HIERARCHY ===================================================================================
@@ -164,17 +171,28 @@ namespace spartan
         std::vector<Entity*>& GetChildren()       { return m_children; }
         //===============================================================================================
 
-        const math::Matrix& GetMatrix() const              { return m_matrix; }
-        const math::Matrix& GetLocalMatrix() const         { return m_matrix_local; }
+        //= TRANSFORM ===================================================================================
+        // setters only mark the entity and its descendants as dirty, world matrices are computed when
+        // read, or for all dirty entities at once, level by level, when the world flushes them every frame
+        const math::Matrix& GetMatrix() const              { ResolveTransform(); return m_matrix; }
+        const math::Matrix& GetLocalMatrix() const         { ResolveTransform(); return m_matrix_local; }
+        void ResolveTransform() const                      { if (m_transform_dirty) ComputeTransform(); }
+        bool IsTransformDirty() const                      { return m_transform_dirty; }
+        static bool ConsumeTransformChanges(); // returns true if any transform changed since the last call
+        //===============================================================================================
+
         const math::Matrix& GetMatrixPrevious() const      { return m_matrix_previous; }
         void SetMatrixPrevious(const math::Matrix& matrix) { m_matrix_previous = matrix; }
         float GetTimeSinceLastTransform() const            { return m_time_since_last_transform_sec; }
 
     private:
-        std::atomic<bool> m_is_active = true;
+        std::atomic<bool> m_is_active           = true;
+        std::atomic<bool> m_bounds_dirty        = true;
+        std::atomic<uint32_t> m_bounds_revision = 0;
         std::array<std::shared_ptr<Component>, 13> m_components;
 
-        void UpdateTransform();
+        void MarkTransformDirty();
+        void ComputeTransform() const;
         math::Matrix GetParentTransformMatrix() const;
 
         // local
@@ -182,17 +200,19 @@ namespace spartan
         math::Quaternion m_rotation_local = math::Quaternion::Identity;
         math::Vector3 m_scale_local       = math::Vector3::One;
 
-        math::Matrix m_matrix          = math::Matrix::Identity;
-        math::Matrix m_matrix_previous = math::Matrix::Identity;
-        math::Matrix m_matrix_local    = math::Matrix::Identity;
-
-        // computed during UpdateTransform() and cached for performance
-        math::Vector3 m_forward  = math::Vector3::Zero;
-        math::Vector3 m_backward = math::Vector3::Zero;
-        math::Vector3 m_up       = math::Vector3::Zero;
-        math::Vector3 m_down     = math::Vector3::Zero;
-        math::Vector3 m_right    = math::Vector3::Zero;
-        math::Vector3 m_left     = math::Vector3::Zero;
+        // world, computed during ComputeTransform()
+        mutable math::Matrix m_matrix               = math::Matrix::Identity;
+        mutable math::Matrix m_matrix_local         = math::Matrix::Identity;
+        mutable std::atomic<bool> m_transform_dirty = false; // when set, all descendants are dirty too, written last so readers never see a half computed matrix
+        math::Matrix m_matrix_previous              = math::Matrix::Identity;
+
+        // computed during ComputeTransform() and cached for performance
+        mutable math::Vector3 m_forward  = math::Vector3::Zero;
+        mutable math::Vector3 m_backward = math::Vector3::Zero;
+        mutable math::Vector3 m_up       = math::Vector3::Zero;
+        mutable math::Vector3 m_down     = math::Vector3::Zero;
+        mutable math::Vector3 m_right    = math::Vector3::Zero;
+        mutable math::Vector3 m_left     = math::Vector3::Zero;
 
         std::weak_ptr<Entity> m_parent;  // the parent of this entity
         std::vector<Entity*> m_children; // the children of this entity
@@ -0,0 +1,424 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =================
+#include "pch.h"
+#include "SpatialIndex.h"
+#include "../Math/Frustum.h"
+#include "../Math/Ray.h"
+//============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace spartan::math;
+//============================
+
+namespace spartan
+{
+    namespace
+    {
+        // how much leaf boxes are enlarged by, in world units
+        const float fat_margin = 0.2f;
+
+        BoundingBox merge(const BoundingBox& a, const BoundingBox& b)
+        {
+            BoundingBox merged = a;
+            merged.Merge(b);
+            return merged;
+        }
+
+        float surface_area(const BoundingBox& box)
+        {
+            const Vector3 size = box.GetSize();
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+    }
+
+    uint32_t SpatialIndex::Insert(Entity* entity, const BoundingBox& bounding_box)
+    {
+        const uint32_t leaf = AllocateNode();
+
+        Node& node        = m_nodes[leaf];
+        node.bounding_box = BoundingBox(bounding_box.GetMin() - Vector3(fat_margin), bounding_box.GetMax() + Vector3(fat_margin));
+        node.entity       = entity;
+        node.height       = 0;
+
+        InsertLeaf(leaf);
+        m_proxy_count++;
+
+        return leaf;
+    }
+
+    void SpatialIndex::Remove(const uint32_t proxy)
+    {
+        SP_ASSERT(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf() && m_nodes[proxy].height == 0);
+
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        m_proxy_count--;
+    }
+
+    bool SpatialIndex::Update(const uint32_t proxy, const BoundingBox& bounding_box)
+    {
+        SP_ASSERT(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf() && m_nodes[proxy].height == 0);
+
+        // still inside the enlarged box, nothing to do
+        if (m_nodes[proxy].bounding_box.Intersects(bounding_box) == Intersection::Inside)
+            return false;
+
+        RemoveLeaf(proxy);
+        m_nodes[proxy].bounding_box = BoundingBox(bounding_box.GetMin() - Vector3(fat_margin), bounding_box.GetMax() + Vector3(fat_margin));
+        InsertLeaf(proxy);
+
+        return true;
+    }
+
+    void SpatialIndex::Clear()
+    {
+        m_nodes.clear();
+        m_root        = proxy_null;
+        m_free_list   = proxy_null;
+        m_proxy_count = 0;
+    }
+
+    void SpatialIndex::QueryBox(const BoundingBox& bounding_box, vector<Entity*>& entities) const
+    {
+        Query([&bounding_box](const BoundingBox& node_box)
+        {
+            return node_box.Intersects(bounding_box) != Intersection::Outside;
+        }, entities);
+    }
+
+    void SpatialIndex::QuerySphere(const Vector3& center, const float radius, vector<Entity*>& entities) const
+    {
+        const float radius_squared = radius * radius;
+        Query([&center, radius_squared](const BoundingBox& node_box)
+        {
+            return Vector3::DistanceSquared(center, node_box.GetClosestPoint(center)) <= radius_squared;
+        }, entities);
+    }
+
+    void SpatialIndex::QueryFrustum(const Frustum& frustum, vector<Entity*>& entities) const
+    {
+        Query([&frustum](const BoundingBox& node_box)
+        {
+            return frustum.IsVisible(node_box.GetCenter(), node_box.GetExtents());
+        }, entities);
+    }
+
+    void SpatialIndex::QueryRay(const Ray& ray, vector<Entity*>& entities) const
+    {
+        Query([&ray](const BoundingBox& node_box)
+        {
+            return ray.HitDistance(node_box) != numeric_limits<float>::infinity();
+        }, entities);
+    }
+
+    uint32_t SpatialIndex::GetHeight() const
+    {
+        return m_root != proxy_null ? static_cast<uint32_t>(m_nodes[m_root].height) : 0;
+    }
+
+    template<typename Overlaps>
+    void SpatialIndex::Query(Overlaps&& overlaps, vector<Entity*>& entities) const
+    {
+        if (m_root == proxy_null)
+            return;
+
+        // leaves are tested against their enlarged boxes, callers that need exact bounds should refine the results
+        uint32_t stack[128];
+        uint32_t stack_size = 0;
+        stack[stack_size++] = m_root;
+        while (stack_size > 0)
+        {
+            const Node& node = m_nodes[stack[--stack_size]];
+            if (!overlaps(node.bounding_box))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                entities.push_back(node.entity);
+            }
+            else
+            {
+                // the tree is balanced, so its height stays far below the stack size
+                SP_ASSERT(stack_size + 2 <= 128);
+                stack[stack_size++] = node.child_left;
+                stack[stack_size++] = node.child_right;
+            }
+        }
+    }
+
+    uint32_t SpatialIndex::AllocateNode()
+    {
+        if (m_free_list == proxy_null)
+        {
+            m_nodes.emplace_back();
+            return static_cast<uint32_t>(m_nodes.size() - 1);
+        }
+
+        const uint32_t index = m_free_list;
+        m_free_list          = m_nodes[index].parent;
+        m_nodes[index]       = Node();
+
+        return index;
+    }
+
+    void SpatialIndex::FreeNode(const uint32_t index)
+    {
+        m_nodes[index]        = Node();
+        m_nodes[index].parent = m_free_list;
+        m_free_list           = index;
+    }
+
+    void SpatialIndex::InsertLeaf(const uint32_t leaf)
+    {
+        if (m_root == proxy_null)
+        {
+            m_root               = leaf;
+            m_nodes[leaf].parent = proxy_null;
+            return;
+        }
+
+        // descend towards the sibling that makes the tree's total surface area grow the least
+        const BoundingBox leaf_box = m_nodes[leaf].bounding_box;
+        uint32_t index             = m_root;
+        while (!m_nodes[index].IsLeaf())
+        {
+            const Node& node = m_nodes[index];
+
+            const float area          = surface_area(node.bounding_box);
+            const float area_combined = surface_area(merge(node.bounding_box, leaf_box));
+
+            // cost of making a new parent for this node and the leaf
+            const float cost = 2.0f * area_combined;
+
+            // minimum cost of pushing the leaf further down, every ancestor grows by this much
+            const float cost_inheritance = 2.0f * (area_combined - area);
+
+            auto cost_child = [&](const uint32_t child)
+            {
+                const Node& child_node = m_nodes[child];
+                const float area_new   = surface_area(merge(child_node.bounding_box, leaf_box));
+                return child_node.IsLeaf() ? area_new + cost_inheritance : (area_new - surface_area(child_node.bounding_box)) + cost_inheritance;
+            };
+            const float cost_left  = cost_child(node.child_left);
+            const float cost_right = cost_child(node.child_right);
+
+            if (cost < cost_left && cost < cost_right)
+                break;
+
+            index = cost_left < cost_right ? node.child_left : node.child_right;
+        }
+        const uint32_t sibling = index;
+
+        // create a new parent for the sibling and the leaf
+        const uint32_t parent_old = m_nodes[sibling].parent;
+        const uint32_t parent_new = AllocateNode();
+        m_nodes[parent_new].parent       = parent_old;
+        m_nodes[parent_new].bounding_box = merge(leaf_box, m_nodes[sibling].bounding_box);
+        m_nodes[parent_new].height       = m_nodes[sibling].height + 1;
+        m_nodes[parent_new].child_left   = sibling;
+        m_nodes[parent_new].child_right  = leaf;
+        m_nodes[sibling].parent          = parent_new;
+        m_nodes[leaf].parent             = parent_new;
+
+        if (parent_old != proxy_null)
+        {
+            if (m_nodes[parent_old].child_left == sibling)
+            {
+                m_nodes[parent_old].child_left = parent_new;
+            }
+            else
+            {
+                m_nodes[parent_old].child_right = parent_new;
+            }
+        }
+        else
+        {
+            m_root = parent_new;
+        }
+
+        Refit(m_nodes[leaf].parent);
+    }
+
+    void SpatialIndex::RemoveLeaf(const uint32_t leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = proxy_null;
+            return;
+        }
+
+        const uint32_t parent       = m_nodes[leaf].parent;
+        const uint32_t grand_parent = m_nodes[parent].parent;
+        const uint32_t sibling      = m_nodes[parent].child_left == leaf ? m_nodes[parent].child_right : m_nodes[parent].child_left;
+
+        // the sibling takes the parent's place
+        if (grand_parent != proxy_null)
+        {
+            if (m_nodes[grand_parent].child_left == parent)
+            {
+                m_nodes[grand_parent].child_left = sibling;
+            }
+            else
+            {
+                m_nodes[grand_parent].child_right = sibling;
+            }
+            m_nodes[sibling].parent = grand_parent;
+            FreeNode(parent);
+
+            Refit(grand_parent);
+        }
+        else
+        {
+            m_root                  = sibling;
+            m_nodes[sibling].parent = proxy_null;
+            FreeNode(parent);
+        }
+
+        m_nodes[leaf].parent = proxy_null;
+    }
+
+    void SpatialIndex::Refit(uint32_t index)
+    {
+        // walk up, rebalancing and recomputing bounds and heights
+        while (index != proxy_null)
+        {
+            index = Balance(index);
+
+            Node& node        = m_nodes[index];
+            const Node& left  = m_nodes[node.child_left];
+            const Node& right = m_nodes[node.child_right];
+            node.height       = 1 + max(left.height, right.height);
+            node.bounding_box = merge(left.bounding_box, right.bounding_box);
+
+            index = node.parent;
+        }
+    }
+
+    uint32_t SpatialIndex::Balance(const uint32_t index_a)
+    {
+        Node& a = m_nodes[index_a];
+        if (a.IsLeaf() || a.height < 2)
+            return index_a;
+
+        const uint32_t index_b = a.child_left;
+        const uint32_t index_c = a.child_right;
+        Node& b                = m_nodes[index_b];
+        Node& c                = m_nodes[index_c];
+        const int32_t balance  = c.height - b.height;
+
+        // makes the promoted node take a's place under a's parent
+        auto replace_in_parent = [this](const uint32_t parent, const uint32_t child_old, const uint32_t child_new)
+        {
+            if (parent == proxy_null)
+            {
+                m_root = child_new;
+            }
+            else if (m_nodes[parent].child_left == child_old)
+            {
+                m_nodes[parent].child_left = child_new;
+            }
+            else
+            {
+                m_nodes[parent].child_right = child_new;
+            }
+        };
+
+        // right side is too tall, promote c
+        if (balance > 1)
+        {
+            const uint32_t index_f = c.child_left;
+            const uint32_t index_g = c.child_right;
+            Node& f                = m_nodes[index_f];
+            Node& g                = m_nodes[index_g];
+
+            c.child_left = index_a;
+            c.parent     = a.parent;
+            a.parent     = index_c;
+            replace_in_parent(c.parent, index_a, index_c);
+
+            // the taller of c's children stays with c, the other one moves under a
+            if (f.height > g.height)
+            {
+                c.child_right  = index_f;
+                a.child_right  = index_g;
+                g.parent       = index_a;
+                a.bounding_box = merge(b.bounding_box, g.bounding_box);
+                c.bounding_box = merge(a.bounding_box, f.bounding_box);
+                a.height       = 1 + max(b.height, g.height);
+                c.height       = 1 + max(a.height, f.height);
+            }
+            else
+            {
+                c.child_right  = index_g;
+                a.child_right  = index_f;
+                f.parent       = index_a;
+                a.bounding_box = merge(b.bounding_box, f.bounding_box);
+                c.bounding_box = merge(a.bounding_box, g.bounding_box);
+                a.height       = 1 + max(b.height, f.height);
+                c.height       = 1 + max(a.height, g.height);
+            }
+
+            return index_c;
+        }
+
+        // left side is too tall, promote b
+        if (balance < -1)
+        {
+            const uint32_t index_d = b.child_left;
+            const uint32_t index_e = b.child_right;
+            Node& d                = m_nodes[index_d];
+            Node& e                = m_nodes[index_e];
+
+            b.child_left = index_a;
+            b.parent     = a.parent;
+            a.parent     = index_b;
+            replace_in_parent(b.parent, index_a, index_b);
+
+            if (d.height > e.height)
+            {
+                b.child_right  = index_d;
+                a.child_left   = index_e;
+                e.parent       = index_a;
+                a.bounding_box = merge(c.bounding_box, e.bounding_box);
+                b.bounding_box = merge(a.bounding_box, d.bounding_box);
+                a.height       = 1 + max(c.height, e.height);
+                b.height       = 1 + max(a.height, d.height);
+            }
+            else
+            {
+                b.child_right  = index_e;
+                a.child_left   = index_d;
+                d.parent       = index_a;
+                a.bounding_box = merge(c.bounding_box, d.bounding_box);
+                b.bounding_box = merge(a.bounding_box, e.bounding_box);
+                a.height       = 1 + max(c.height, d.height);
+                b.height       = 1 + max(a.height, e.height);
+            }
+
+            return index_b;
+        }
+
+        return index_a;
+    }
+}
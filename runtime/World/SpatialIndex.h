@@ -0,0 +1,89 @@
+/*
+Copyright(c) 2015-2025 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===================
+#include "../Math/BoundingBox.h"
+//==============================
+
+namespace spartan
+{
+    class Entity;
+
+    namespace math
+    {
+        class Frustum;
+        class Ray;
+    }
+
+    // dynamic bounding volume hierarchy over entity bounds
+    // leaves store a slightly enlarged box, so small movements don't touch the tree, larger ones re-insert the leaf
+    // the tree is kept balanced with rotations, and insertion picks the sibling that grows the surface area the least
+    class SpatialIndex
+    {
+    public:
+        static const uint32_t proxy_null = UINT32_MAX;
+
+        // proxies
+        uint32_t Insert(Entity* entity, const math::BoundingBox& bounding_box);
+        void Remove(const uint32_t proxy);
+        bool Update(const uint32_t proxy, const math::BoundingBox& bounding_box); // returns true if the leaf had to move
+        void Clear();
+
+        // queries, matching entities are appended
+        void QueryBox(const math::BoundingBox& bounding_box, std::vector<Entity*>& entities) const;
+        void QuerySphere(const math::Vector3& center, const float radius, std::vector<Entity*>& entities) const;
+        void QueryFrustum(const math::Frustum& frustum, std::vector<Entity*>& entities) const;
+        void QueryRay(const math::Ray& ray, std::vector<Entity*>& entities) const;
+
+        // misc
+        uint32_t GetProxyCount() const { return m_proxy_count; }
+        uint32_t GetHeight() const;
+
+    private:
+        struct Node
+        {
+            math::BoundingBox bounding_box;
+            Entity* entity       = nullptr;
+            uint32_t parent      = proxy_null; // also the next free node, when the node is free
+            uint32_t child_left  = proxy_null;
+            uint32_t child_right = proxy_null;
+            int32_t height       = -1;         // 0 for leaves, -1 for free nodes
+
+            bool IsLeaf() const { return child_left == proxy_null; }
+        };
+
+        uint32_t AllocateNode();
+        void FreeNode(const uint32_t index);
+        void InsertLeaf(const uint32_t leaf);
+        void RemoveLeaf(const uint32_t leaf);
+        void Refit(uint32_t index);
+        uint32_t Balance(const uint32_t index);
+        template<typename Overlaps>
+        void Query(Overlaps&& overlaps, std::vector<Entity*>& entities) const;
+
+        std::vector<Node> m_nodes;
+        uint32_t m_root        = proxy_null;
+        uint32_t m_free_list   = proxy_null;
+        uint32_t m_proxy_count = 0;
+    };
+}
@@ -23,10 +23,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "pch.h"
 #include "World.h"
 #include "Entity.h"
+#include "SpatialIndex.h"
 #include "../Resource/ResourceCache.h"
 #include "../Game/Game.h"
 #include "../Profiling/Profiler.h"
 #include "../Core/ProgressTracker.h"
+#include "../Core/ThreadPool.h"
 #include "Components/Renderable.h"
 #include "Components/Camera.h"
 #include "Components/Light.h"
@@ -56,6 +58,144 @@ namespace spartan
         shared_ptr<Entity> light    = nullptr;
         uint32_t audio_source_count = 0;
 
+        namespace transforms
+        {
+            // entities grouped by depth in the hierarchy, each level only depends on the levels above it
+            vector<vector<Entity*>> levels;
+            bool levels_dirty = true;
+
+            // below this, dispatching jobs costs more than resolving on the calling thread
+            const uint32_t parallel_threshold = 256;
+
+            void build_levels()
+            {
+                for (vector<Entity*>& level : levels)
+                {
+                    level.clear();
+                }
+
+                for (shared_ptr<Entity>& entity : entities)
+                {
+                    uint32_t depth = 0;
+                    for (shared_ptr<Entity> parent = entity->GetParent(); parent; parent = parent->GetParent())
+                    {
+                        depth++;
+                    }
+
+                    if (depth >= levels.size())
+                    {
+                        levels.resize(depth + 1);
+                    }
+                    levels[depth].push_back(entity.get());
+                }
+
+                levels_dirty = false;
+            }
+
+            // computes the world matrix of every dirty entity, parents are done before their children
+            void flush()
+            {
+                if (!Entity::ConsumeTransformChanges())
+                    return;
+
+                if (levels_dirty)
+                {
+                    build_levels();
+                }
+
+                for (vector<Entity*>& level : levels)
+                {
+                    auto resolve_range = [&level](uint32_t start, uint32_t end)
+                    {
+                        for (uint32_t i = start; i < end; i++)
+                        {
+                            level[i]->ResolveTransform();
+                        }
+                    };
+
+                    const uint32_t count = static_cast<uint32_t>(level.size());
+                    if (count < parallel_threshold)
+                    {
+                        resolve_range(0, count);
+                    }
+                    else
+                    {
+                        ThreadPool::ParallelLoop(resolve_range, count);
+                    }
+                }
+            }
+        }
+
+        namespace spatial
+        {
+            SpatialIndex index;
+            unordered_map<const Entity*, uint32_t> proxies;
+
+            // bounds of what an entity contributes to the scene, renderables and local lights
+            bool compute_bounds(Entity* entity, BoundingBox& bounds)
+            {
+                bool has_bounds = false;
+                bounds          = BoundingBox();
+
+                if (Renderable* renderable = entity->GetComponent<Renderable>())
+                {
+                    bounds.Merge(renderable->GetBoundingBox());
+                    has_bounds = true;
+                }
+
+                // directional lights affect everything, so they stay out of the index
+                if (Light* light = entity->GetComponent<Light>())
+                {
+                    if (light->GetLightType() != LightType::Directional)
+                    {
+                        const Vector3 position = entity->GetPosition();
+                        const Vector3 range    = Vector3(light->GetRange());
+                        bounds.Merge(BoundingBox(position - range, position + range));
+                        has_bounds = true;
+                    }
+                }
+
+                return has_bounds;
+            }
+
+            void remove(const Entity* entity)
+            {
+                auto it = proxies.find(entity);
+                if (it != proxies.end())
+                {
+                    index.Remove(it->second);
+                    proxies.erase(it);
+                }
+            }
+
+            // inserts, moves or removes the entity's leaf, cheap when nothing moved
+            void update(Entity* entity)
+            {
+                BoundingBox bounds;
+                if (!entity->GetActive() || !compute_bounds(entity, bounds))
+                {
+                    remove(entity);
+                    return;
+                }
+
+                auto it = proxies.find(entity);
+                if (it == proxies.end())
+                {
+                    proxies[entity] = index.Insert(entity, bounds);
+                }
+                else
+                {
+                    index.Update(it->second, bounds);
+                }
+            }
+
+            void clear()
+            {
+                index.Clear();
+                proxies.clear();
+            }
+        }
+
         void compute_bounding_box()
         {
             for (shared_ptr<Entity>& entity : entities)
@@ -133,14 +273,26 @@ namespace spartan
             }
         }
         
-        // tick
+        // resolve what moved since the last tick (input, physics, editor), so components read fresh transforms
+        transforms::flush();
+
+        // tick, then refit the entities whose bounds changed, a resolve (components added or removed) refits all of them
         for (shared_ptr<Entity>& entity : entities)
         {
             if (entity->GetActive())
             { 
                 entity->Tick();
             }
+
+            const bool is_bounds_dirty = entity->ConsumeBoundsDirty();
+            if (is_bounds_dirty || resolve)
+            {
+                spatial::update(entity.get());
+            }
         }
+
+        // resolve what the components moved, so the renderer reads fresh transforms
+        transforms::flush();
         
         if (resolve)
         {
@@ -196,6 +348,9 @@ namespace spartan
         // clear
         entities.clear();
         entities_lights.clear();
+        spatial::clear();
+        transforms::levels.clear();
+        transforms::levels_dirty = true;
         camera = nullptr;
         light  = nullptr;
         file_path.clear();
@@ -337,7 +492,8 @@ namespace spartan
 
     void World::Resolve()
     {
-        resolve = true;
+        resolve                  = true;
+        transforms::levels_dirty = true;
     }
 
     shared_ptr<Entity> World::CreateEntity()
@@ -347,6 +503,7 @@ namespace spartan
         shared_ptr<Entity> entity = make_shared<Entity>();
         entity->Initialize();
         entities.push_back(entity);
+        transforms::levels_dirty = true;
 
         return entity;
     }
@@ -375,7 +532,9 @@ namespace spartan
             for (Entity* entity : entities_to_remove)
             {
                 ids_to_remove.insert(entity->GetObjectId());
+                spatial::remove(entity);
             }
+            transforms::levels_dirty = true;
 
             // remove entities using a single loop
             for (auto it = entities.begin(); it != entities.end(); )
@@ -437,6 +596,69 @@ namespace spartan
         return entities;
     }
 
+    void World::QueryBox(const BoundingBox& bounding_box, vector<Entity*>& entities_out)
+    {
+        spatial::index.QueryBox(bounding_box, entities_out);
+    }
+
+    void World::QuerySphere(const Vector3& center, const float radius, vector<Entity*>& entities_out)
+    {
+        spatial::index.QuerySphere(center, radius, entities_out);
+    }
+
+    void World::QueryFrustum(const Frustum& frustum, vector<Entity*>& entities_out)
+    {
+        spatial::index.QueryFrustum(frustum, entities_out);
+    }
+
+    void World::QueryRay(const Ray& ray, vector<Entity*>& entities_out)
+    {
+        spatial::index.QueryRay(ray, entities_out);
+    }
+
+    bool World::RayCast(const Ray& ray, RayHit& hit, const float distance_max)
+    {
+        vector<Entity*> entities;
+        QueryRay(ray, entities);
+
+        // test the nearest bounding boxes first, once a triangle is hit everything beyond it can be skipped
+        vector<pair<float, Renderable*>> candidates;
+        candidates.reserve(entities.size());
+        for (Entity* entity : entities)
+        {
+            Renderable* renderable = entity->GetComponent<Renderable>();
+            if (!renderable || !renderable->HasMesh())
+                continue;
+
+            const float distance = ray.HitDistance(renderable->GetBoundingBox());
+            if (distance < distance_max)
+            {
+                candidates.emplace_back(distance, renderable);
+            }
+        }
+        sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        float distance_closest = distance_max;
+        for (const auto& [distance_box, renderable] : candidates)
+        {
+            if (distance_box >= distance_closest)
+                break;
+
+            uint32_t instance_index = 0;
+            Vector3 normal;
+            const float distance = renderable->RayCast(ray, distance_closest, &instance_index, &normal);
+            if (distance < distance_closest)
+            {
+                distance_closest     = distance;
+                hit                  = RayHit(renderable->GetEntity(), ray.GetStart() + ray.GetDirection() * distance, distance, false);
+                hit.m_normal         = normal;
+                hit.m_instance_index = instance_index;
+            }
+        }
+
+        return distance_closest < distance_max;
+    }
+
     const vector<shared_ptr<Entity>>& World::GetEntitiesLights()
     {
         return entities_lights;
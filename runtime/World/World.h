@@ -30,6 +30,13 @@ namespace spartan
     class Camera;
     class Light;
 
+    namespace math
+    {
+        class Frustum;
+        class Ray;
+        class RayHit;
+    }
+
     class World
     {
     public:
@@ -51,6 +58,16 @@ namespace spartan
         static const std::vector<std::shared_ptr<Entity>>& GetEntities();
         static const std::vector<std::shared_ptr<Entity>>& GetEntitiesLights();
 
+        // spatial queries over active renderables and local lights, matches are appended
+        // they test the slightly enlarged bounds the index keeps, so refine the results if exact bounds matter
+        static void QueryBox(const math::BoundingBox& bounding_box, std::vector<Entity*>& entities);
+        static void QuerySphere(const math::Vector3& center, const float radius, std::vector<Entity*>& entities);
+        static void QueryFrustum(const math::Frustum& frustum, std::vector<Entity*>& entities);
+        static void QueryRay(const math::Ray& ray, std::vector<Entity*>& entities);
+
+        // closest hit against the triangles of active renderables, false if nothing was hit within the distance
+        static bool RayCast(const math::Ray& ray, math::RayHit& hit, const float distance_max = std::numeric_limits<float>::max());
+
         // misc
         static void Clear();
         static void Resolve();